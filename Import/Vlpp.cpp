@@ -406,6 +406,10 @@ Console
 
 namespace vl
 {
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+	volatile vint stringCounterOperations = 0;
+#endif
+
 #if defined VCZH_GCC
 	void _itoa_s(vint32_t value, char* buffer, size_t size, vint radix)
 	{
@@ -932,6 +936,107 @@ namespace vl
 		}
 		return result;
 	}
+
+	template<typename T>
+	class InternedStringPool : public Object
+	{
+	protected:
+		SpinLock										lock;
+		collections::HashDictionary<ObjectString<T>, T*>	strings;		// interned string to the buffer it points to
+
+	public:
+		~InternedStringPool()
+		{
+			// interned strings do not own buffers, so they are safe to be destroyed after the pool
+			for (vint i = 0; i < strings.Count(); i++)
+			{
+				delete[] strings.Values()[i];
+			}
+		}
+
+		ObjectString<T> Intern(const ObjectString<T>& string)
+		{
+			// interned strings are zero-terminated literals, which cannot contain zero characters
+			if (string.Length() == 0 || string.IndexOf(0) != -1)
+			{
+				return string;
+			}
+
+			SPIN_LOCK(lock)
+			{
+				vint index = strings.Keys().IndexOf(string);
+				if (index != -1)
+				{
+					return strings.Keys()[index];
+				}
+
+				vint length = string.Length();
+				T* buffer = new T[length + 1];
+				for (vint i = 0; i < length; i++)
+				{
+					buffer[i] = string[i];
+				}
+				buffer[length] = 0;
+
+				ObjectString<T> interned(buffer, false);
+				strings.Add(interned, buffer);
+				return interned;
+			}
+			return string;
+		}
+	};
+
+	class InternedStringStorage : public GlobalStorage
+	{
+	public:
+		InternedStringPool<char>*						aPool = new InternedStringPool<char>;
+		InternedStringPool<wchar_t>*					wPool = new InternedStringPool<wchar_t>;
+		volatile bool									enabled = true;
+
+		InternedStringStorage()
+			:GlobalStorage(L"InternedStringStorage")
+		{
+		}
+
+		~InternedStringStorage()
+		{
+			// other static objects could still read interned strings when they are destroyed after this one
+			// so buffers are only released by FinalizeGlobalStorage, otherwise they are leaked deliberately
+		}
+
+		void ClearResource()override
+		{
+			delete aPool;
+			delete wPool;
+			aPool = nullptr;
+			wPool = nullptr;
+		}
+	};
+
+	InternedStringStorage& GetInternedStringStorage()
+	{
+		static InternedStringStorage storage;
+		return storage;
+	}
+
+	AString InternString(const AString& string)
+	{
+		auto& storage = GetInternedStringStorage();
+		auto pool = storage.aPool;
+		return pool && storage.enabled ? pool->Intern(string) : string;
+	}
+
+	WString InternString(const WString& string)
+	{
+		auto& storage = GetInternedStringStorage();
+		auto pool = storage.wPool;
+		return pool && storage.enabled ? pool->Intern(string) : string;
+	}
+
+	void SetInternStringEnabled(bool enabled)
+	{
+		GetInternedStringStorage().enabled = enabled;
+	}
 }
 
 
@@ -5408,6 +5513,17 @@ LzwDecoder
 			outputBufferUsedBytes = 0;
 		}
 
+		lzw::Code* LzwDecoder::CreateDecodedCode(lzw::Code* prefix, vuint8_t byte)
+		{
+			// decoding only follows parent links, so the code is not added to the children map of the prefix
+			Code* code = codeAllocator.Create();
+			code->byte = byte;
+			code->code = nextIndex++;
+			code->parent = prefix;
+			code->size = prefix->size + 1;
+			return code;
+		}
+
 		LzwDecoder::LzwDecoder()
 		{
 			for (vint i = 0; i < 256; i++)
@@ -5480,7 +5596,7 @@ LzwDecoder
 					{
 						if (lastCode)
 						{
-							dictionary.Add(CreateCode(lastCode, outputBuffer[0]));
+							dictionary.Add(CreateDecodedCode(lastCode, outputBuffer[0]));
 						}
 						UpdateIndexBits();
 					}
@@ -8402,6 +8518,145 @@ namespace vl
 			return ParsingTextPos::Compare(r1->GetCodeRange().start, r2->GetCodeRange().start);
 		}
 
+/***********************************************************************
+ParsingArena
+***********************************************************************/
+
+		ThreadVariable<ParsingArena*>		currentParsingArena;
+		volatile vint						activeParsingArenaScopes = 0;
+		volatile vint						liveParsingArenaBlocks = 0;
+		volatile bool						parsingArenaEnabled = false;
+
+		// every node is prefixed by the block that it belongs to, nullptr for nodes allocated from the heap
+		// nodes don't have members that need an alignment larger than 8 bytes
+		const vint							ParsingArenaNodeHeaderSize = sizeof(vint64_t);
+
+		void* ParsingArena::Allocate(size_t size)
+		{
+			const vint blockHeaderSize = (sizeof(Block) + 7) / 8 * 8;
+			vint nodeSize = ParsingArenaNodeHeaderSize + ((vint)size + 7) / 8 * 8;
+			if (nodeSize > blockSize / 4)
+			{
+				return nullptr;
+			}
+
+			if (!currentBlock || currentBlock->used + nodeSize > currentBlock->size)
+			{
+				if (currentBlock)
+				{
+					ReleaseBlock(currentBlock);
+				}
+				currentBlock = (Block*)::operator new(blockHeaderSize + blockSize);
+				currentBlock->counter = 1;
+				currentBlock->used = 0;
+				currentBlock->size = blockSize;
+				allocatedBlocks++;
+				INCRC(&liveParsingArenaBlocks);
+			}
+
+			char* memory = (char*)currentBlock + blockHeaderSize + currentBlock->used;
+			currentBlock->used += nodeSize;
+			INCRC(&currentBlock->counter);
+			*(Block**)memory = currentBlock;
+			return memory + ParsingArenaNodeHeaderSize;
+		}
+
+		void ParsingArena::ReleaseBlock(Block* block)
+		{
+			if (DECRC(&block->counter) == 0)
+			{
+				::operator delete(block);
+				DECRC(&liveParsingArenaBlocks);
+			}
+		}
+
+		ParsingArena::Scope::Scope(ParsingArena& arena)
+			:activated(parsingArenaEnabled)
+			,previous(nullptr)
+		{
+			if (activated)
+			{
+				previous = currentParsingArena.Get();
+				currentParsingArena.Set(&arena);
+				INCRC(&activeParsingArenaScopes);
+			}
+		}
+
+		ParsingArena::Scope::~Scope()
+		{
+			if (activated)
+			{
+				currentParsingArena.Set(previous);
+				DECRC(&activeParsingArenaScopes);
+			}
+		}
+
+		ParsingArena::ParsingArena(vint _blockSize)
+			:blockSize(_blockSize)
+		{
+		}
+
+		ParsingArena::~ParsingArena()
+		{
+			if (currentBlock)
+			{
+				ReleaseBlock(currentBlock);
+			}
+		}
+
+		vint ParsingArena::GetAllocatedBlockCount()
+		{
+			return allocatedBlocks;
+		}
+
+		void ParsingArena::SetEnabled(bool enabled)
+		{
+			parsingArenaEnabled = enabled;
+		}
+
+		bool ParsingArena::IsEnabled()
+		{
+			return parsingArenaEnabled;
+		}
+
+		vint ParsingArena::GetLiveBlockCount()
+		{
+			return liveParsingArenaBlocks;
+		}
+
+		void* ParsingArena::AllocateNode(size_t size)
+		{
+			// thread local storage is only touched when any arena is activated
+			if (activeParsingArenaScopes > 0)
+			{
+				if (auto arena = currentParsingArena.Get())
+				{
+					if (auto memory = arena->Allocate(size))
+					{
+						return memory;
+					}
+				}
+			}
+
+			char* memory = (char*)::operator new(ParsingArenaNodeHeaderSize + size);
+			*(Block**)memory = nullptr;
+			return memory + ParsingArenaNodeHeaderSize;
+		}
+
+		void ParsingArena::FreeNode(void* memory)
+		{
+			if (!memory) return;
+			char* header = (char*)memory - ParsingArenaNodeHeaderSize;
+			if (auto block = *(Block**)header)
+			{
+				ReleaseBlock(block);
+			}
+			else
+			{
+				::operator delete(header);
+			}
+		}
+
 /***********************************************************************
 ParsingTreeNode::TraversalVisitor
 ***********************************************************************/
@@ -10363,6 +10618,43 @@ TypeDescriptorImplBase
 				return typeName;
 			}
 
+/***********************************************************************
+LoadTypeDescriptor
+***********************************************************************/
+
+			// members of type descriptors are loaded on demand from any thread
+			// loading a type descriptor loads other type descriptors, so the lock is not entered again by the loading thread
+			CriticalSection			typeDescriptorLoadingLock;
+			volatile vint			typeDescriptorLoadingThread = -1;
+
+			template<typename TLoadInternal>
+			void LoadTypeDescriptor(volatile bool& loaded, bool& loading, const TLoadInternal& loadInternal)
+			{
+				if (loaded) return;
+				if (typeDescriptorLoadingThread == Thread::GetCurrentThreadId())
+				{
+					if (!loading)
+					{
+						loading = true;
+						loadInternal();
+						loaded = true;
+					}
+					return;
+				}
+
+				CS_LOCK(typeDescriptorLoadingLock)
+				{
+					typeDescriptorLoadingThread = Thread::GetCurrentThreadId();
+					if (!loaded && !loading)
+					{
+						loading = true;
+						loadInternal();
+						loaded = true;
+					}
+					typeDescriptorLoadingThread = -1;
+				}
+			}
+
 /***********************************************************************
 ValueTypeDescriptorBase
 ***********************************************************************/
@@ -10373,16 +10665,13 @@ ValueTypeDescriptorBase
 
 			void ValueTypeDescriptorBase::Load()
 			{
-				if (!loaded)
-				{
-					loaded = true;
-					LoadInternal();
-				}
+				LoadTypeDescriptor(loaded, loading, [this]() { LoadInternal(); });
 			}
 
 			ValueTypeDescriptorBase::ValueTypeDescriptorBase(TypeDescriptorFlags _typeDescriptorFlags, const TypeInfoContent* _typeInfoContent)
 				:TypeDescriptorImplBase(_typeDescriptorFlags, _typeInfoContent)
 				, loaded(false)
+				, loading(false)
 			{
 			}
 
@@ -10708,7 +10997,7 @@ ParameterInfoImpl
 
 			ParameterInfoImpl::ParameterInfoImpl(IMethodInfo* _ownerMethod, const WString& _name, Ptr<ITypeInfo> _type)
 				:ownerMethod(_ownerMethod)
-				,name(_name)
+				,name(InternString(_name))
 				,type(_type)
 			{
 			}
@@ -10832,6 +11121,12 @@ MethodInfoImpl
 				return InvokeInternal(thisObject, arguments);
 			}
 
+			Value MethodInfoImpl::InvokeWithCheckedThisObject(const Value& thisObject, collections::Array<Value>& arguments)
+			{
+				CheckArguments(arguments);
+				return InvokeInternal(thisObject, arguments);
+			}
+
 			Value MethodInfoImpl::CreateFunctionProxy(const Value& thisObject)
 			{
 				if(thisObject.IsNull())
@@ -10874,7 +11169,7 @@ MethodGroupInfoImpl
 
 			MethodGroupInfoImpl::MethodGroupInfoImpl(ITypeDescriptor* _ownerTypeDescriptor, const WString& _name)
 				:ownerTypeDescriptor(_ownerTypeDescriptor)
-				,name(_name)
+				,name(InternString(_name))
 			{
 			}
 
@@ -10921,7 +11216,7 @@ EventInfoImpl
 
 			EventInfoImpl::EventInfoImpl(ITypeDescriptor* _ownerTypeDescriptor, const WString& _name)
 				:ownerTypeDescriptor(_ownerTypeDescriptor)
-				,name(_name)
+				,name(InternString(_name))
 			{
 			}
 
@@ -11030,7 +11325,7 @@ PropertyInfoImpl
 
 			PropertyInfoImpl::PropertyInfoImpl(ITypeDescriptor* _ownerTypeDescriptor, const WString& _name, MethodInfoImpl* _getter, MethodInfoImpl* _setter, EventInfoImpl* _valueChangedEvent)
 				:ownerTypeDescriptor(_ownerTypeDescriptor)
-				,name(_name)
+				,name(InternString(_name))
 				,getter(_getter)
 				,setter(_setter)
 				,valueChangedEvent(_valueChangedEvent)
@@ -11149,7 +11444,7 @@ FieldInfoImpl
 
 			FieldInfoImpl::FieldInfoImpl(ITypeDescriptor* _ownerTypeDescriptor, const WString& _name, Ptr<ITypeInfo> _returnInfo)
 				:ownerTypeDescriptor(_ownerTypeDescriptor)
-				,name(_name)
+				,name(InternString(_name))
 				,returnInfo(_returnInfo)
 			{
 			}
@@ -11301,16 +11596,13 @@ TypeDescriptorImpl
 
 			void TypeDescriptorImpl::Load()
 			{
-				if(!loaded)
-				{
-					loaded=true;
-					LoadInternal();
-				}
+				LoadTypeDescriptor(loaded, loading, [this]() { LoadInternal(); });
 			}
 
 			TypeDescriptorImpl::TypeDescriptorImpl(TypeDescriptorFlags _typeDescriptorFlags, const TypeInfoContent* _typeInfoContent)
 				:TypeDescriptorImplBase(_typeDescriptorFlags, _typeInfoContent)
 				,loaded(false)
+				,loading(false)
 			{
 			}
 
@@ -11318,6 +11610,11 @@ TypeDescriptorImpl
 			{
 			}
 
+			bool TypeDescriptorImpl::IsLoaded()
+			{
+				return loaded;
+			}
+
 			bool TypeDescriptorImpl::IsAggregatable()
 			{
 				return false;
@@ -23665,100 +23962,774 @@ XmlElementWriter
 				element->subNodes.Add(node);
 				return *this;
 			}
-		}
-	}
-}
 
-
-/***********************************************************************
-.\PARSING\XML\PARSINGXML_AST.CPP
-***********************************************************************/
-/***********************************************************************
-Vczh Library++ 3.0
-Developer: Zihan Chen(vczh)
-Parser::ParsingXml.parser.txt
-
-This file is generated by: Vczh Parser Generator
-***********************************************************************/
-
-
-namespace vl
-{
-	namespace parsing
-	{
-		namespace xml
-		{
 /***********************************************************************
-Visitor Pattern Implementation
+XmlPullToken
 ***********************************************************************/
 
-			void XmlText::Accept(XmlNode::IVisitor* visitor)
+			WString XmlPullToken::ToString()const
 			{
-				visitor->Visit(this);
+				return length == 0 ? WString() : WString(reading, length);
 			}
 
-			void XmlCData::Accept(XmlNode::IVisitor* visitor)
+			void XmlPullToken::ToParsingToken(ParsingToken& token)const
 			{
-				visitor->Visit(this);
+				token.tokenIndex = tokenIndex;
+				token.value = ToString();
+				token.codeRange = codeRange;
 			}
 
-			void XmlAttribute::Accept(XmlNode::IVisitor* visitor)
+/***********************************************************************
+XmlPullParser
+***********************************************************************/
+
+			bool XmlPullIsSpace(wchar_t c)
 			{
-				visitor->Visit(this);
+				return c == L' ' || c == L'\r' || c == L'\n' || c == L'\t';
 			}
 
-			void XmlComment::Accept(XmlNode::IVisitor* visitor)
+			bool XmlPullIsName(wchar_t c)
 			{
-				visitor->Visit(this);
+				return (L'a' <= c && c <= L'z') || (L'A' <= c && c <= L'Z') || (L'0' <= c && c <= L'9') || c == L':' || c == L'.' || c == L'_' || c == L'-';
 			}
 
-			void XmlElement::Accept(XmlNode::IVisitor* visitor)
+			bool XmlPullIsText(wchar_t c)
 			{
-				visitor->Visit(this);
+				switch (c)
+				{
+				case 0:
+				case L'<':
+				case L'>':
+				case L'=':
+				case L'\"':
+				case L'\'':
+					return false;
+				default:
+					return !XmlPullIsSpace(c) && !XmlPullIsName(c);
+				}
 			}
 
-			void XmlInstruction::Accept(XmlNode::IVisitor* visitor)
+			vint XmlPullParser::MatchComment(const wchar_t* begin)
 			{
-				visitor->Visit(this);
+				// <!--([^->]|-[^->]|--[^>])*-->
+				const wchar_t* reading = begin + 4;
+				vint dashes = 0;
+				while (wchar_t c = *reading++)
+				{
+					if (dashes == 2)
+					{
+						if (c == L'>') return reading - begin;
+						dashes = 0;
+					}
+					else if (c == L'-')
+					{
+						dashes++;
+					}
+					else if (c == L'>')
+					{
+						return 0;
+					}
+					else
+					{
+						dashes = 0;
+					}
+				}
+				return 0;
 			}
 
-			void XmlDocument::Accept(XmlNode::IVisitor* visitor)
+			vint XmlPullParser::MatchCData(const wchar_t* begin)
 			{
-				visitor->Visit(this);
+				// <!\[CDATA\[([^\]]|\][^\]]|\]\][^>])*\]\]>
+				const wchar_t* reading = begin + 9;
+				vint brackets = 0;
+				while (wchar_t c = *reading++)
+				{
+					if (brackets == 2)
+					{
+						if (c == L'>') return reading - begin;
+						brackets = 0;
+					}
+					else if (c == L']')
+					{
+						brackets++;
+					}
+					else
+					{
+						brackets = 0;
+					}
+				}
+				return 0;
 			}
 
-		}
-	}
-}
-namespace vl
-{
-	namespace reflection
-	{
-		namespace description
-		{
-#ifndef VCZH_DEBUG_NO_REFLECTION
-			using namespace vl::parsing::xml;
-
-#define PARSING_TOKEN_FIELD(NAME)\
-			CLASS_MEMBER_EXTERNALMETHOD_TEMPLATE(get_##NAME, NO_PARAMETER, vl::WString(ClassType::*)(), [](ClassType* node) { return node->NAME.value; }, L"*", L"*")\
-			CLASS_MEMBER_EXTERNALMETHOD_TEMPLATE(set_##NAME, { L"value" }, void(ClassType::*)(const vl::WString&), [](ClassType* node, const vl::WString& value) { node->NAME.value = value; }, L"*", L"*")\
-			CLASS_MEMBER_PROPERTY_REFERENCETEMPLATE(NAME, get_##NAME, set_##NAME, L"$This->$Name.value")\
-
-			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlNode, system::XmlNode)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlText, system::XmlText)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlCData, system::XmlCData)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlAttribute, system::XmlAttribute)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlComment, system::XmlComment)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlElement, system::XmlElement)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlInstruction, system::XmlInstruction)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlDocument, system::XmlDocument)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlNode::IVisitor, system::XmlNode::IVisitor)
-
-			BEGIN_CLASS_MEMBER(XmlNode)
-				CLASS_MEMBER_METHOD_OVERLOAD(Accept, {L"visitor"}, void(XmlNode::*)(XmlNode::IVisitor* visitor))
-			END_CLASS_MEMBER(XmlNode)
+			void XmlPullParser::ReadRawToken(RawToken& rawToken)
+			{
+				const wchar_t* begin = reading;
+				const wchar_t* end = begin;
+				TokenType type = TokenType::Text;
 
-			BEGIN_CLASS_MEMBER(XmlText)
+				switch (*begin)
+				{
+				case 0:
+					rawToken.type = TokenType::EndOfInput;
+					rawToken.token = XmlPullToken();
+					return;
+				case L'=':
+					type = TokenType::Equal;
+					end = begin + 1;
+					break;
+				case L'>':
+					type = TokenType::ElementClose;
+					end = begin + 1;
+					break;
+				case L'<':
+					switch (begin[1])
+					{
+					case L'?':
+						type = TokenType::InstructionOpen;
+						end = begin + 2;
+						break;
+					case L'/':
+						type = TokenType::ComplexElementOpen;
+						end = begin + 2;
+						break;
+					default:
+						{
+							type = TokenType::ElementOpen;
+							end = begin + 1;
+							if (begin[1] == L'!')
+							{
+								if (begin[2] == L'-' && begin[3] == L'-')
+								{
+									if (vint length = MatchComment(begin))
+									{
+										type = TokenType::Comment;
+										end = begin + length;
+									}
+								}
+								else
+								{
+									const wchar_t* prefix = L"<![CDATA[";
+									vint index = 2;
+									while (prefix[index] && begin[index] == prefix[index]) index++;
+									if (!prefix[index])
+									{
+										if (vint length = MatchCData(begin))
+										{
+											type = TokenType::CData;
+											end = begin + length;
+										}
+									}
+								}
+							}
+						}
+					}
+					break;
+				case L'\"':
+				case L'\'':
+					{
+						end = begin + 1;
+						while (*end && *end != *begin && *end != L'<' && *end != L'>') end++;
+						if (*end == *begin)
+						{
+							type = TokenType::AttValue;
+							end++;
+						}
+						else
+						{
+							end = begin + 1;
+						}
+					}
+					break;
+				default:
+					if (XmlPullIsSpace(*begin))
+					{
+						type = TokenType::Space;
+						while (XmlPullIsSpace(*end)) end++;
+					}
+					else if (XmlPullIsName(*begin))
+					{
+						type = TokenType::Name;
+						while (XmlPullIsName(*end)) end++;
+					}
+					else if (begin[1] == L'>' && *begin == L'/')
+					{
+						type = TokenType::SingleElementClose;
+						end = begin + 2;
+					}
+					else if (begin[1] == L'>' && *begin == L'?')
+					{
+						type = TokenType::InstructionClose;
+						end = begin + 2;
+					}
+					else
+					{
+						while (XmlPullIsText(*end)) end++;
+					}
+				}
+
+				rawToken.type = type;
+				rawToken.token.reading = begin;
+				rawToken.token.length = end - begin;
+				rawToken.token.tokenIndex = tokenCount++;
+				rawToken.token.codeRange.codeIndex = codeIndex;
+				rawToken.token.codeRange.start = ParsingTextPos(begin - input.Buffer(), row, column);
+				rawToken.token.codeRange.end.index = end - input.Buffer() - 1;
+				for (; reading < end; reading++)
+				{
+					rawToken.token.codeRange.end.row = row;
+					rawToken.token.codeRange.end.column = column;
+					if (*reading == L'\n')
+					{
+						row++;
+						column = 0;
+					}
+					else
+					{
+						column++;
+					}
+				}
+			}
+
+			const XmlPullParser::RawToken& XmlPullParser::PeekToken()
+			{
+				if (!lookaheadAvailable)
+				{
+					previousSpace.type = TokenType::EndOfInput;
+					while (true)
+					{
+						ReadRawToken(lookahead);
+						if (lookahead.type != TokenType::Space) break;
+						previousSpace = lookahead;
+					}
+					lookaheadAvailable = true;
+				}
+				return lookahead;
+			}
+
+			XmlPullParser::RawToken XmlPullParser::ReadToken()
+			{
+				PeekToken();
+				lookaheadAvailable = false;
+				return lookahead;
+			}
+
+			bool XmlPullParser::ReadToken(TokenType type, XmlPullToken& token)
+			{
+				if (PeekToken().type != type) return false;
+				token = ReadToken().token;
+				return true;
+			}
+
+			bool XmlPullParser::Fail()
+			{
+				auto& token = PeekToken();
+				if (token.type == TokenType::EndOfInput)
+				{
+					eventError = new ParsingError(L"Error happened during parsing when reaching the end of the input.");
+				}
+				else
+				{
+					eventError = new ParsingError(L"Error happened during parsing.");
+					eventError->codeRange = token.token.codeRange;
+				}
+				eventType = EventType::Error;
+				eventRange = eventError->codeRange;
+				state = State::Finished;
+				return true;
+			}
+
+			bool XmlPullParser::ReadAttribute()
+			{
+				XmlPullToken equal;
+				if (!ReadToken(TokenType::Name, eventName)) return Fail();
+				if (!ReadToken(TokenType::Equal, equal)) return Fail();
+				if (!ReadToken(TokenType::AttValue, eventValue)) return Fail();
+				eventType = EventType::Attribute;
+				eventRange = ParsingTextRange(eventName.codeRange.start, eventValue.codeRange.end, codeIndex);
+				return true;
+			}
+
+			bool XmlPullParser::ReadBeginElement()
+			{
+				auto open = ReadToken();
+				if (!ReadToken(TokenType::Name, eventName)) return Fail();
+				eventType = EventType::BeginElement;
+				eventRange = ParsingTextRange(open.token.codeRange.start, eventName.codeRange.end, codeIndex);
+				depth++;
+				state = State::ElementAttributes;
+				return true;
+			}
+
+			bool XmlPullParser::ReadEndElement(const XmlPullToken& open, const XmlPullToken& close)
+			{
+				eventType = EventType::EndElement;
+				eventRange = ParsingTextRange(open.codeRange.start, close.codeRange.end, codeIndex);
+				depth--;
+				state = depth == 0 ? State::Epilog : State::Content;
+				return true;
+			}
+
+			bool XmlPullParser::ReadSingleToken(EventType type)
+			{
+				eventValue = ReadToken().token;
+				eventType = type;
+				eventRange = eventValue.codeRange;
+				return true;
+			}
+
+			bool XmlPullParser::ReadText()
+			{
+				// consecutive text tokens are reported as one fragment, including spaces next to them
+				XmlPullToken first = previousSpace.type == TokenType::Space ? previousSpace.token : lookahead.token;
+				XmlPullToken last;
+				while (true)
+				{
+					last = ReadToken().token;
+					switch (PeekToken().type)
+					{
+					case TokenType::Name:
+					case TokenType::Equal:
+					case TokenType::AttValue:
+					case TokenType::Text:
+						continue;
+					default:;
+					}
+					break;
+				}
+				if (previousSpace.type == TokenType::Space)
+				{
+					last = previousSpace.token;
+				}
+
+				eventType = EventType::Text;
+				eventRange = ParsingTextRange(first.codeRange.start, last.codeRange.end, codeIndex);
+				eventValue.reading = first.reading;
+				eventValue.length = last.reading + last.length - first.reading;
+				eventValue.codeRange = eventRange;
+				return true;
+			}
+
+			XmlPullParser::XmlPullParser(const WString& _input, vint _codeIndex)
+				:input(_input)
+				, codeIndex(_codeIndex)
+				, reading(input.Buffer())
+			{
+			}
+
+			XmlPullParser::XmlPullParser(stream::TextReader& reader, vint _codeIndex)
+				:input(reader.ReadToEnd())
+				, codeIndex(_codeIndex)
+				, reading(input.Buffer())
+			{
+			}
+
+			XmlPullParser::~XmlPullParser()
+			{
+			}
+
+			bool XmlPullParser::Next()
+			{
+				if (state == State::Finished) return false;
+				eventName = XmlPullToken();
+				eventValue = XmlPullToken();
+				eventError = nullptr;
+
+				while (true)
+				{
+					switch (state)
+					{
+					case State::Prolog:
+						switch (PeekToken().type)
+						{
+						case TokenType::InstructionOpen:
+							{
+								auto open = ReadToken();
+								if (!ReadToken(TokenType::Name, eventName)) return Fail();
+								eventType = EventType::BeginInstruction;
+								eventRange = ParsingTextRange(open.token.codeRange.start, eventName.codeRange.end, codeIndex);
+								state = State::InstructionAttributes;
+								return true;
+							}
+						case TokenType::Comment:
+							return ReadSingleToken(EventType::Comment);
+						case TokenType::ElementOpen:
+							return ReadBeginElement();
+						default:
+							return Fail();
+						}
+					case State::InstructionAttributes:
+						switch (PeekToken().type)
+						{
+						case TokenType::Name:
+							return ReadAttribute();
+						case TokenType::InstructionClose:
+							ReadSingleToken(EventType::EndInstruction);
+							eventValue = XmlPullToken();
+							state = State::Prolog;
+							return true;
+						default:
+							return Fail();
+						}
+					case State::ElementAttributes:
+						switch (PeekToken().type)
+						{
+						case TokenType::Name:
+							return ReadAttribute();
+						case TokenType::SingleElementClose:
+							{
+								auto close = ReadToken();
+								return ReadEndElement(close.token, close.token);
+							}
+						case TokenType::ElementClose:
+							ReadToken();
+							state = State::Content;
+							break;
+						default:
+							return Fail();
+						}
+						break;
+					case State::Content:
+						switch (PeekToken().type)
+						{
+						case TokenType::Name:
+						case TokenType::Equal:
+						case TokenType::AttValue:
+						case TokenType::Text:
+							return ReadText();
+						case TokenType::CData:
+							return ReadSingleToken(EventType::CData);
+						case TokenType::Comment:
+							return ReadSingleToken(EventType::Comment);
+						case TokenType::ElementOpen:
+							return ReadBeginElement();
+						case TokenType::ComplexElementOpen:
+							{
+								auto open = ReadToken();
+								XmlPullToken close;
+								if (!ReadToken(TokenType::Name, eventName)) return Fail();
+								if (!ReadToken(TokenType::ElementClose, close)) return Fail();
+								return ReadEndElement(open.token, close);
+							}
+						default:
+							return Fail();
+						}
+					case State::Epilog:
+						if (PeekToken().type != TokenType::EndOfInput) return Fail();
+						eventType = EventType::EndOfDocument;
+						eventRange = ParsingTextRange();
+						state = State::Finished;
+						return true;
+					default:
+						return false;
+					}
+				}
+			}
+
+			XmlPullParser::EventType XmlPullParser::GetEventType()
+			{
+				return eventType;
+			}
+
+			const XmlPullToken& XmlPullParser::GetName()
+			{
+				return eventName;
+			}
+
+			const XmlPullToken& XmlPullParser::GetValue()
+			{
+				return eventValue;
+			}
+
+			const ParsingTextRange& XmlPullParser::GetRange()
+			{
+				return eventRange;
+			}
+
+			Ptr<ParsingError> XmlPullParser::GetError()
+			{
+				return eventError;
+			}
+
+/***********************************************************************
+XmlBuildDocument
+***********************************************************************/
+
+			WString XmlUnescapeValue(const wchar_t* reading, vint length)
+			{
+				Array<wchar_t> buffer(length + 1);
+				vint written = 0;
+				const wchar_t* end = reading + length;
+				while (reading < end)
+				{
+					vint remains = end - reading;
+					if (*reading == L'&')
+					{
+						if (remains >= 4 && wcsncmp(reading, L"&lt;", 4) == 0)
+						{
+							buffer[written++] = L'<';
+							reading += 4;
+							continue;
+						}
+						else if (remains >= 4 && wcsncmp(reading, L"&gt;", 4) == 0)
+						{
+							buffer[written++] = L'>';
+							reading += 4;
+							continue;
+						}
+						else if (remains >= 5 && wcsncmp(reading, L"&amp;", 5) == 0)
+						{
+							buffer[written++] = L'&';
+							reading += 5;
+							continue;
+						}
+						else if (remains >= 6 && wcsncmp(reading, L"&apos;", 6) == 0)
+						{
+							buffer[written++] = L'\'';
+							reading += 6;
+							continue;
+						}
+						else if (remains >= 6 && wcsncmp(reading, L"&quot;", 6) == 0)
+						{
+							buffer[written++] = L'\"';
+							reading += 6;
+							continue;
+						}
+					}
+					buffer[written++] = *reading++;
+				}
+				return written == 0 ? WString() : WString(&buffer[0], written);
+			}
+
+			void XmlBuildToken(ParsingToken& token, const XmlPullToken& pullToken, vint skipBegin, vint skipEnd, bool unescape)
+			{
+				token.tokenIndex = pullToken.tokenIndex;
+				token.codeRange = pullToken.codeRange;
+				const wchar_t* reading = pullToken.reading + skipBegin;
+				vint length = pullToken.length - skipBegin - skipEnd;
+				if (unescape)
+				{
+					token.value = XmlUnescapeValue(reading, length);
+				}
+				else
+				{
+					token.value = length == 0 ? WString() : WString(reading, length);
+				}
+			}
+
+			Ptr<XmlDocument> XmlBuildDocument(XmlPullParser& parser, collections::List<Ptr<ParsingError>>& errors)
+			{
+				Ptr<XmlDocument> document = new XmlDocument;
+				Ptr<XmlInstruction> instruction;
+				List<Ptr<XmlElement>> elements;
+				ParsingTextPos documentStart;
+				bool first = true;
+
+				while (parser.Next())
+				{
+					const auto& range = parser.GetRange();
+					if (first)
+					{
+						documentStart = range.start;
+						first = false;
+					}
+
+					switch (parser.GetEventType())
+					{
+					case XmlPullParser::EventType::BeginInstruction:
+						instruction = new XmlInstruction;
+						instruction->codeRange = range;
+						instruction->creatorRules.Add(L"XInstruction");
+						parser.GetName().ToParsingToken(instruction->name);
+						document->prologs.Add(instruction);
+						break;
+					case XmlPullParser::EventType::EndInstruction:
+						instruction->codeRange.end = range.end;
+						instruction = nullptr;
+						break;
+					case XmlPullParser::EventType::BeginElement:
+						{
+							Ptr<XmlElement> element = new XmlElement;
+							element->codeRange = range;
+							element->creatorRules.Add(L"XElement");
+							parser.GetName().ToParsingToken(element->name);
+							if (elements.Count() == 0)
+							{
+								document->rootElement = element;
+							}
+							else
+							{
+								element->creatorRules.Add(L"XSubNode");
+								elements[elements.Count() - 1]->subNodes.Add(element);
+							}
+							elements.Add(element);
+						}
+						break;
+					case XmlPullParser::EventType::EndElement:
+						{
+							auto element = elements[elements.Count() - 1];
+							element->codeRange.end = range.end;
+							parser.GetName().ToParsingToken(element->closingName);
+							elements.RemoveAt(elements.Count() - 1);
+						}
+						break;
+					case XmlPullParser::EventType::Attribute:
+						{
+							Ptr<XmlAttribute> attribute = new XmlAttribute;
+							attribute->codeRange = range;
+							attribute->creatorRules.Add(L"XAttribute");
+							parser.GetName().ToParsingToken(attribute->name);
+							XmlBuildToken(attribute->value, parser.GetValue(), 1, 1, true);
+							if (instruction)
+							{
+								instruction->attributes.Add(attribute);
+							}
+							else
+							{
+								elements[elements.Count() - 1]->attributes.Add(attribute);
+							}
+						}
+						break;
+					case XmlPullParser::EventType::Text:
+						{
+							Ptr<XmlText> text = new XmlText;
+							text->codeRange = range;
+							XmlBuildToken(text->content, parser.GetValue(), 0, 0, true);
+							elements[elements.Count() - 1]->subNodes.Add(text);
+						}
+						break;
+					case XmlPullParser::EventType::CData:
+						{
+							Ptr<XmlCData> cdata = new XmlCData;
+							cdata->codeRange = range;
+							cdata->creatorRules.Add(L"XCData");
+							cdata->creatorRules.Add(L"XSubNode");
+							XmlBuildToken(cdata->content, parser.GetValue(), 9, 3, false);
+							elements[elements.Count() - 1]->subNodes.Add(cdata);
+						}
+						break;
+					case XmlPullParser::EventType::Comment:
+						{
+							Ptr<XmlComment> comment = new XmlComment;
+							comment->codeRange = range;
+							comment->creatorRules.Add(L"XComment");
+							XmlBuildToken(comment->content, parser.GetValue(), 4, 3, false);
+							if (elements.Count() == 0)
+							{
+								document->prologs.Add(comment);
+							}
+							else
+							{
+								comment->creatorRules.Add(L"XSubNode");
+								elements[elements.Count() - 1]->subNodes.Add(comment);
+							}
+						}
+						break;
+					case XmlPullParser::EventType::EndOfDocument:
+						document->creatorRules.Add(L"XDocument");
+						document->codeRange = ParsingTextRange(documentStart, document->rootElement->codeRange.end, document->rootElement->codeRange.codeIndex);
+						return document;
+					case XmlPullParser::EventType::Error:
+						errors.Add(parser.GetError());
+						return nullptr;
+					default:;
+					}
+				}
+				return nullptr;
+			}
+		}
+	}
+}
+
+
+/***********************************************************************
+.\PARSING\XML\PARSINGXML_AST.CPP
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Parser::ParsingXml.parser.txt
+
+This file is generated by: Vczh Parser Generator
+***********************************************************************/
+
+
+namespace vl
+{
+	namespace parsing
+	{
+		namespace xml
+		{
+/***********************************************************************
+Visitor Pattern Implementation
+***********************************************************************/
+
+			void XmlText::Accept(XmlNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void XmlCData::Accept(XmlNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void XmlAttribute::Accept(XmlNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void XmlComment::Accept(XmlNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void XmlElement::Accept(XmlNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void XmlInstruction::Accept(XmlNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void XmlDocument::Accept(XmlNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+		}
+	}
+}
+namespace vl
+{
+	namespace reflection
+	{
+		namespace description
+		{
+#ifndef VCZH_DEBUG_NO_REFLECTION
+			using namespace vl::parsing::xml;
+
+#define PARSING_TOKEN_FIELD(NAME)\
+			CLASS_MEMBER_EXTERNALMETHOD_TEMPLATE(get_##NAME, NO_PARAMETER, vl::WString(ClassType::*)(), [](ClassType* node) { return node->NAME.value; }, L"*", L"*")\
+			CLASS_MEMBER_EXTERNALMETHOD_TEMPLATE(set_##NAME, { L"value" }, void(ClassType::*)(const vl::WString&), [](ClassType* node, const vl::WString& value) { node->NAME.value = value; }, L"*", L"*")\
+			CLASS_MEMBER_PROPERTY_REFERENCETEMPLATE(NAME, get_##NAME, set_##NAME, L"$This->$Name.value")\
+
+			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlNode, system::XmlNode)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlText, system::XmlText)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlCData, system::XmlCData)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlAttribute, system::XmlAttribute)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlComment, system::XmlComment)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlElement, system::XmlElement)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlInstruction, system::XmlInstruction)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlDocument, system::XmlDocument)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::xml::XmlNode::IVisitor, system::XmlNode::IVisitor)
+
+			BEGIN_CLASS_MEMBER(XmlNode)
+				CLASS_MEMBER_METHOD_OVERLOAD(Accept, {L"visitor"}, void(XmlNode::*)(XmlNode::IVisitor* visitor))
+			END_CLASS_MEMBER(XmlNode)
+
+			BEGIN_CLASS_MEMBER(XmlText)
 				CLASS_MEMBER_BASE(XmlNode)
 
 				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<XmlText>(), NO_PARAMETER)
@@ -25257,6 +26228,134 @@ RegexLexerColorizer
 		}
 
 		void RegexLexerColorizer::Colorize(const wchar_t* input, vint length, TokenProc tokenProc, void* tokenProcArgument)
+		{
+			// the same algorithm as ColorizeByWalker, with RegexLexerWalker::Walk inlined
+			// characters are not walked twice when a token ends right before the current character
+			// and runs of characters that keep the DFA in the same state are skipped in a tight loop
+			PureInterpretor* pure=walker.pure;
+			const vint* charMap=pure->charMap;
+			vint** transition=pure->transition;
+			const bool* finalStates=pure->finalState;
+			const vint* stateTokens=&walker.stateTokens[0];
+			vint startState=pure->startState;
+
+			vint start=0;
+			vint stop=0;
+			vint state=-1;
+			vint token=-1;
+
+			vint index=0;
+			vint currentToken=-1;
+			bool finalState=false;
+			bool previousTokenStop=false;
+
+			while(index<length)
+			{
+				if(currentState!=-1)
+				{
+					vint runState=currentState;
+					const vint* runTransition=transition[runState];
+					vint runStart=index;
+					while(index<length && runTransition[charMap[input[index]]]==runState)
+					{
+						index++;
+					}
+					if(index>runStart)
+					{
+						finalState=finalStates[runState];
+						if(finalState)
+						{
+							stop=index;
+							state=runState;
+							token=stateTokens[runState];
+						}
+						continue;
+					}
+				}
+
+				vint previousState=currentState;
+				vint charIndex=charMap[input[index]];
+				currentToken=-1;
+				finalState=false;
+				previousTokenStop=false;
+				if(currentState==-1)
+				{
+					currentState=startState;
+					previousTokenStop=true;
+				}
+
+				currentState=transition[currentState][charIndex];
+				if(currentState==-1)
+				{
+					previousTokenStop=true;
+					if(previousState==-1)
+					{
+						finalState=true;
+					}
+					else if(finalStates[previousState])
+					{
+						currentState=transition[startState][charIndex];
+					}
+				}
+				if(currentState!=-1 && finalStates[currentState])
+				{
+					currentToken=stateTokens[currentState];
+					finalState=true;
+				}
+				else if(previousState!=-1 || currentState!=-1)
+				{
+					finalState=currentState==-1;
+				}
+
+				if(previousTokenStop)
+				{
+					vint tokenLength=stop-start;
+					if(tokenLength>0)
+					{
+						tokenProc(tokenProcArgument, start, tokenLength, token);
+						start=stop;
+						token=-1;
+						if(stop<index)
+						{
+							currentState=state;
+							index=stop;
+							state=-1;
+							continue;
+						}
+						state=-1;
+					}
+					else if(stop<index)
+					{
+						stop=index+1;
+						tokenProc(tokenProcArgument, start, stop-start, -1);
+						start=index+1;
+						state=-1;
+						token=-1;
+					}
+				}
+				if(finalState)
+				{
+					stop=index+1;
+					state=currentState;
+					token=currentToken;
+				}
+
+				index++;
+			}
+			if(start<length)
+			{
+				if(finalState)
+				{
+					tokenProc(tokenProcArgument, start, length-start, token);
+				}
+				else
+				{
+					tokenProc(tokenProcArgument, start, length-start, walker.GetRelatedToken(currentState));
+				}
+			}
+		}
+
+		void RegexLexerColorizer::ColorizeByWalker(const wchar_t* input, vint length, TokenProc tokenProc, void* tokenProcArgument)
 		{
 			vint start=0;
 			vint stop=0;
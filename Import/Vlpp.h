@@ -3099,6 +3099,787 @@ Random Access
 
 #endif
 
+/***********************************************************************
+.\COLLECTIONS\HASHDICTIONARY.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Data Structure::HashDictionary
+
+Classes:
+	HashKeyType<T>								: Hash function for hash containers
+	HashKeyList<T, K>							: Readonly list with hash-indexed lookup
+	HashDictionary<KT, VT, KK, VK>				: One to one mapping using hashing
+	HashGroup<KT, VT, KK, VK>					: One to many mapping using hashing
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_HASHDICTIONARY
+#define VCZH_COLLECTIONS_HASHDICTIONARY
+
+
+namespace vl
+{
+	template<typename T>
+	class ObjectString;
+
+	namespace collections
+	{
+/***********************************************************************
+HashKeyType
+***********************************************************************/
+
+		/// <summary>Get the hash code of a value for hash containers. Integer, enum and pointer types are supported by default, specialize this type for other key types.</summary>
+		/// <typeparam name="T">Type of the value.</typeparam>
+		template<typename T>
+		struct HashKeyType
+		{
+			/// <summary>Mix bits of an integer to a hash code.</summary>
+			/// <returns>The hash code.</returns>
+			/// <param name="value">The integer.</param>
+			static vuint64_t Mix(vuint64_t value)
+			{
+				value ^= value >> 33;
+				value *= 0xFF51AFD7ED558CCDULL;
+				value ^= value >> 33;
+				value *= 0xC4CEB9FE1A85EC53ULL;
+				value ^= value >> 33;
+				return value;
+			}
+
+			/// <summary>Get the hash code of a value.</summary>
+			/// <returns>The hash code.</returns>
+			/// <param name="value">The value.</param>
+			static vuint64_t GetHashCode(const T& value)
+			{
+				return Mix((vuint64_t)value);
+			}
+		};
+
+		template<typename T>
+		struct HashKeyType<T*>
+		{
+			static vuint64_t GetHashCode(T* value)
+			{
+				return HashKeyType<vuint64_t>::Mix((vuint64_t)(size_t)value);
+			}
+		};
+
+		template<typename T>
+		struct HashKeyType<ObjectString<T>>
+		{
+			static vuint64_t GetHashCode(const ObjectString<T>& value)
+			{
+				// FNV-1a
+				vuint64_t hash = 0xCBF29CE484222325ULL;
+				const T* buffer = value.Buffer();
+				vint length = value.Length();
+				for (vint i = 0; i < length; i++)
+				{
+					hash ^= (vuint64_t)buffer[i];
+					hash *= 0x100000001B3ULL;
+				}
+				return hash;
+			}
+		};
+
+/***********************************************************************
+HashKeyList
+***********************************************************************/
+
+		template<typename KT, typename VT, typename KK, typename VK>
+		class HashDictionary;
+
+		template<typename KT, typename VT, typename KK, typename VK>
+		class HashGroup;
+
+		/// <summary>Readonly list that finds items using a hash table. It is the key container of <see cref="HashDictionary`4"/> and <see cref="HashGroup`4"/>.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="K">Type of the key type of elements.</typeparam>
+		template<typename T, typename K = typename KeyType<T>::Type>
+		class HashKeyList : public Object, public virtual IEnumerable<T>
+		{
+			template<typename KT, typename VT, typename KK, typename VK>
+			friend class HashDictionary;
+			template<typename KT, typename VT, typename KK, typename VK>
+			friend class HashGroup;
+		protected:
+			List<T, K>						items;
+			List<vuint64_t>					hashes;
+			Array<vint>						slots;			// open addressing with linear probing, -1 means an empty slot
+
+			static vuint64_t GetItemHash(const T& item)
+			{
+				return HashKeyType<K>::GetHashCode(KeyType<T>::GetKeyValue(item));
+			}
+
+			vint FindSlotOfIndex(vint index)const
+			{
+				vint mask = slots.Count() - 1;
+				vint slot = (vint)(hashes[index] & (vuint64_t)mask);
+				while (slots[slot] != index)
+				{
+					slot = (slot + 1) & mask;
+				}
+				return slot;
+			}
+
+			void Rehash(vint slotCount)
+			{
+				slots.Resize(slotCount);
+				for (vint i = 0; i < slotCount; i++)
+				{
+					slots[i] = -1;
+				}
+
+				vint mask = slotCount - 1;
+				for (vint i = 0; i < items.Count(); i++)
+				{
+					vint slot = (vint)(hashes[i] & (vuint64_t)mask);
+					while (slots[slot] != -1)
+					{
+						slot = (slot + 1) & mask;
+					}
+					slots[slot] = i;
+				}
+			}
+
+			vint Add(const T& item)
+			{
+				if ((items.Count() + 1) * 4 > slots.Count() * 3)
+				{
+					Rehash(slots.Count() == 0 ? 16 : slots.Count() * 2);
+				}
+
+				vint index = items.Add(item);
+				vuint64_t hash = GetItemHash(item);
+				hashes.Add(hash);
+
+				vint mask = slots.Count() - 1;
+				vint slot = (vint)(hash & (vuint64_t)mask);
+				while (slots[slot] != -1)
+				{
+					slot = (slot + 1) & mask;
+				}
+				slots[slot] = index;
+				return index;
+			}
+
+			void RemoveAt(vint index)
+			{
+				// remove the slot by shifting following slots backward, so that no tombstone is needed
+				vint mask = slots.Count() - 1;
+				vint hole = FindSlotOfIndex(index);
+				vint slot = hole;
+				while (true)
+				{
+					slot = (slot + 1) & mask;
+					vint current = slots[slot];
+					if (current == -1) break;
+
+					vint home = (vint)(hashes[current] & (vuint64_t)mask);
+					if (hole <= slot ? (home <= hole || home > slot) : (home <= hole && home > slot))
+					{
+						slots[hole] = current;
+						hole = slot;
+					}
+				}
+				slots[hole] = -1;
+
+				// move the last item to the removed position
+				vint last = items.Count() - 1;
+				if (index != last)
+				{
+					slots[FindSlotOfIndex(last)] = index;
+					items[index] = items[last];
+					hashes[index] = hashes[last];
+				}
+				items.RemoveAt(last);
+				hashes.RemoveAt(last);
+			}
+
+			void Clear()
+			{
+				items.Clear();
+				hashes.Clear();
+				slots.Resize(0);
+			}
+		public:
+			/// <summary>Create a list.</summary>
+			HashKeyList()
+			{
+			}
+
+			IEnumerator<T>* CreateEnumerator()const
+			{
+				return items.CreateEnumerator();
+			}
+
+			/// <summary>Test does the list contain an item or not.</summary>
+			/// <returns>Returns true if the list contains the specified item.</returns>
+			/// <param name="item">The item to test.</param>
+			bool Contains(const K& item)const
+			{
+				return IndexOf(item) != -1;
+			}
+
+			/// <summary>Get the position of an item in this list.</summary>
+			/// <returns>Returns the position. Returns -1 if not exists</returns>
+			/// <param name="item">The item to find.</param>
+			vint IndexOf(const K& item)const
+			{
+				if (items.Count() == 0) return -1;
+				vuint64_t hash = HashKeyType<K>::GetHashCode(item);
+				vint mask = slots.Count() - 1;
+				vint slot = (vint)(hash & (vuint64_t)mask);
+				while (true)
+				{
+					vint index = slots[slot];
+					if (index == -1) return -1;
+					if (hashes[index] == hash && items[index] == item) return index;
+					slot = (slot + 1) & mask;
+				}
+			}
+
+			/// <summary>Get the number of elements.</summary>
+			/// <returns>The number of elements.</returns>
+			vint Count()const
+			{
+				return items.Count();
+			}
+
+			/// <summary>Get the reference to the specified element.</summary>
+			/// <returns>The reference to the specified element.</returns>
+			/// <param name="index">The index of the element.</param>
+			const T& Get(vint index)const
+			{
+				return items.Get(index);
+			}
+
+			/// <summary>Get the reference to the specified element.</summary>
+			/// <returns>The reference to the specified element.</returns>
+			/// <param name="index">The index of the element.</param>
+			const T& operator[](vint index)const
+			{
+				return items.Get(index);
+			}
+		};
+
+/***********************************************************************
+HashDictionary
+***********************************************************************/
+
+		/// <summary>Dictionary using hashing. It has the same interface as <see cref="Dictionary`4"/>, but adding, finding and removing a key takes constant time on average. Keys are not sorted, and removing a key moves the last key to the position of the removed one.</summary>
+		/// <typeparam name="KT">Type of keys.</typeparam>
+		/// <typeparam name="VT">Type of values.</typeparam>
+		/// <typeparam name="KK">Type of the key type of keys.</typeparam>
+		/// <typeparam name="VK">Type of the key type of values.</typeparam>
+		template<
+			typename KT,
+			typename VT,
+			typename KK=typename KeyType<KT>::Type,
+			typename VK=typename KeyType<VT>::Type
+		>
+		class HashDictionary : public Object, public virtual IEnumerable<Pair<KT, VT>>
+		{
+		public:
+			typedef HashKeyList<KT, KK>			KeyContainer;
+			typedef List<VT, VK>				ValueContainer;
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<Pair<KT, VT>>
+			{
+			private:
+				const HashDictionary<KT, VT, KK, VK>*	container;
+				vint									index;
+				Pair<KT, VT>							current;
+
+				void UpdateCurrent()
+				{
+					if(index<container->Count())
+					{
+						current.key=container->Keys().Get(index);
+						current.value=container->Values().Get(index);
+					}
+				}
+			public:
+				Enumerator(const HashDictionary<KT, VT, KK, VK>* _container, vint _index=-1)
+				{
+					container=_container;
+					index=_index;
+				}
+
+				IEnumerator<Pair<KT, VT>>* Clone()const
+				{
+					return new Enumerator(container, index);
+				}
+
+				const Pair<KT, VT>& Current()const
+				{
+					return current;
+				}
+
+				vint Index()const
+				{
+					return index;
+				}
+
+				bool Next()
+				{
+					index++;
+					UpdateCurrent();
+					return index>=0 && index<container->Count();
+				}
+
+				void Reset()
+				{
+					index=-1;
+					UpdateCurrent();
+				}
+			};
+
+			KeyContainer						keys;
+			ValueContainer						values;
+		public:
+			/// <summary>Create a dictionary.</summary>
+			HashDictionary()
+			{
+			}
+
+			IEnumerator<Pair<KT, VT>>* CreateEnumerator()const
+			{
+				return new Enumerator(this);
+			}
+
+			/// <summary>Get all keys.</summary>
+			/// <returns>All keys.</returns>
+			const KeyContainer& Keys()const
+			{
+				return keys;
+			}
+
+			/// <summary>Get all values.</summary>
+			/// <returns>All values.</returns>
+			const ValueContainer& Values()const
+			{
+				return values;
+			}
+
+			/// <summary>Get the number of keys.</summary>
+			/// <returns>The number of keys.</returns>
+			vint Count()const
+			{
+				return keys.Count();
+			}
+
+			/// <summary>Get the reference to the value associated with a key.</summary>
+			/// <returns>The reference to the value.</returns>
+			/// <param name="key">The key to find.</param>
+			const VT& Get(const KK& key)const
+			{
+				return values.Get(keys.IndexOf(key));
+			}
+
+			/// <summary>Get the reference to the value associated with a key.</summary>
+			/// <returns>The reference to the value.</returns>
+			/// <param name="key">The key to find.</param>
+			const VT& operator[](const KK& key)const
+			{
+				return values.Get(keys.IndexOf(key));
+			}
+
+			/// <summary>Replace the value associated with a key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find.</param>
+			/// <param name="value">The key to replace.</param>
+			bool Set(const KT& key, const VT& value)
+			{
+				vint index=keys.IndexOf(KeyType<KT>::GetKeyValue(key));
+				if(index==-1)
+				{
+					keys.Add(key);
+					values.Add(value);
+				}
+				else
+				{
+					values[index]=value;
+				}
+				return true;
+			}
+
+			/// <summary>Add a key with an associated value. Exception will raise if the key already exists.</summary>
+			/// <returns>Returns true if the pair is added.</returns>
+			/// <param name="value">The pair of key and value.</param>
+			bool Add(const Pair<KT, VT>& value)
+			{
+				return Add(value.key, value.value);
+			}
+
+			/// <summary>Add a key with an associated value. Exception will raise if the key already exists.</summary>
+			/// <returns>Returns true if the pair is added.</returns>
+			/// <param name="key">The key.</param>
+			/// <param name="value">The value.</param>
+			bool Add(const KT& key, const VT& value)
+			{
+				CHECK_ERROR(!keys.Contains(KeyType<KT>::GetKeyValue(key)), L"HashDictionary<KT, KK, ValueContainer, VT, VK>::Add(const KT&, const VT&)#Key already exists.");
+				keys.Add(key);
+				values.Add(value);
+				return true;
+			}
+
+			/// <summary>Remove a key with the associated value.</summary>
+			/// <returns>Returns true if the key and the value is removed.</returns>
+			/// <param name="key">The key.</param>
+			bool Remove(const KK& key)
+			{
+				vint index=keys.IndexOf(key);
+				if(index!=-1)
+				{
+					vint last=values.Count()-1;
+					keys.RemoveAt(index);
+					if(index!=last)
+					{
+						values[index]=values[last];
+					}
+					values.RemoveAt(last);
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			/// <summary>Remove everything.</summary>
+			/// <returns>Returns true if all keys and values are removed.</returns>
+			bool Clear()
+			{
+				keys.Clear();
+				values.Clear();
+				return true;
+			}
+		};
+
+/***********************************************************************
+HashGroup
+***********************************************************************/
+
+		/// <summary>Group using hashing. It has the same interface as <see cref="Group`4"/>, but adding, finding and removing a key takes constant time on average. Keys are not sorted, and removing a key moves the last key to the position of the removed one.</summary>
+		/// <typeparam name="KT">Type of keys.</typeparam>
+		/// <typeparam name="VT">Type of values.</typeparam>
+		/// <typeparam name="KK">Type of the key type of keys.</typeparam>
+		/// <typeparam name="VK">Type of the key type of values.</typeparam>
+		template<
+			typename KT,
+			typename VT,
+			typename KK=typename KeyType<KT>::Type,
+			typename VK=typename KeyType<VT>::Type
+		>
+		class HashGroup : public Object, public virtual IEnumerable<Pair<KT, VT>>
+		{
+		public:
+			typedef HashKeyList<KT, KK>		KeyContainer;
+			typedef List<VT, VK>			ValueContainer;
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<Pair<KT, VT>>
+			{
+			private:
+				const HashGroup<KT, VT, KK, VK>*	container;
+				vint								keyIndex;
+				vint								valueIndex;
+				Pair<KT, VT>						current;
+
+				void UpdateCurrent()
+				{
+					if(keyIndex<container->Count())
+					{
+						const ValueContainer& values=container->GetByIndex(keyIndex);
+						if(valueIndex<values.Count())
+						{
+							current.key=container->Keys().Get(keyIndex);
+							current.value=values.Get(valueIndex);
+						}
+					}
+				}
+			public:
+				Enumerator(const HashGroup<KT, VT, KK, VK>* _container, vint _keyIndex=-1, vint _valueIndex=-1)
+				{
+					container=_container;
+					keyIndex=_keyIndex;
+					valueIndex=_valueIndex;
+				}
+
+				IEnumerator<Pair<KT, VT>>* Clone()const
+				{
+					return new Enumerator(container, keyIndex, valueIndex);
+				}
+
+				const Pair<KT, VT>& Current()const
+				{
+					return current;
+				}
+
+				vint Index()const
+				{
+					if(0<=keyIndex && keyIndex<container->Count())
+					{
+						vint index=0;
+						for(vint i=0;i<keyIndex;i++)
+						{
+							index+=container->GetByIndex(i).Count();
+						}
+						return index+valueIndex;
+					}
+					else
+					{
+						return -1;
+					}
+				}
+
+				bool Next()
+				{
+					if(keyIndex==-1)
+					{
+						keyIndex=0;
+					}
+					while(keyIndex<container->Count())
+					{
+						valueIndex++;
+						const ValueContainer& values=container->GetByIndex(keyIndex);
+						if(valueIndex<values.Count())
+						{
+							UpdateCurrent();
+							return true;
+						}
+						else
+						{
+							keyIndex++;
+							valueIndex=-1;
+						}
+					}
+					return false;
+				}
+
+				void Reset()
+				{
+					keyIndex=-1;
+					valueIndex=-1;
+					UpdateCurrent();
+				}
+			};
+
+			KeyContainer					keys;
+			List<ValueContainer*>			values;
+
+			void RemoveByIndex(vint index)
+			{
+				ValueContainer* target=values[index];
+				vint last=values.Count()-1;
+				keys.RemoveAt(index);
+				if(index!=last)
+				{
+					values[index]=values[last];
+				}
+				values.RemoveAt(last);
+				delete target;
+			}
+		public:
+			HashGroup()
+			{
+			}
+
+			~HashGroup()
+			{
+				Clear();
+			}
+
+			IEnumerator<Pair<KT, VT>>* CreateEnumerator()const
+			{
+				return new Enumerator(this);
+			}
+
+			/// <summary>Get all keys.</summary>
+			/// <returns>All keys.</returns>
+			const KeyContainer& Keys()const
+			{
+				return keys;
+			}
+
+			/// <summary>Get the number of keys.</summary>
+			/// <returns>The number of keys.</returns>
+			vint Count()const
+			{
+				return keys.Count();
+			}
+
+			/// <summary>Get all values associated with a key.</summary>
+			/// <returns>All values.</returns>
+			/// <param name="key">The key to find.</param>
+			const ValueContainer& Get(const KK& key)const
+			{
+				return *values.Get(keys.IndexOf(key));
+			}
+
+			/// <summary>Get all values associated with a key.</summary>
+			/// <returns>All values.</returns>
+			/// <param name="index">The position of a the key.</param>
+			const ValueContainer& GetByIndex(vint index)const
+			{
+				return *values.Get(index);
+			}
+
+			/// <summary>Get all values associated with a key.</summary>
+			/// <returns>All values.</returns>
+			/// <param name="key">The key to find.</param>
+			const ValueContainer& operator[](const KK& key)const
+			{
+				return *values.Get(keys.IndexOf(key));
+			}
+
+			/// <summary>Test if a key exists in the group or not.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Contains(const KK& key)const
+			{
+				return keys.Contains(key);
+			}
+
+			/// <summary>Test if a key exists with an associated value in the group or not.</summary>
+			/// <returns>Returns true if the key exists with an associated value.</returns>
+			/// <param name="key">The key to find.</param>
+			/// <param name="value">The value to find.</param>
+			bool Contains(const KK& key, const VK& value)const
+			{
+				vint index=keys.IndexOf(key);
+				if(index!=-1)
+				{
+					return values.Get(index)->Contains(value);
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			/// <summary>Add a key with an associated value. If the key already exists, the value will be associated with the key with other values.</summary>
+			/// <returns>Returns true if the pair is added.</returns>
+			/// <param name="value">The pair of key and value.</param>
+			bool Add(const Pair<KT, VT>& value)
+			{
+				return Add(value.key, value.value);
+			}
+
+			/// <summary>Add a key with an associated value. If the key already exists, the value will be associated with the key with other values.</summary>
+			/// <returns>Returns true if the pair is added.</returns>
+			/// <param name="key">The key.</param>
+			/// <param name="value">The value.</param>
+			bool Add(const KT& key, const VT& value)
+			{
+				ValueContainer* target=0;
+				vint index=keys.IndexOf(KeyType<KT>::GetKeyValue(key));
+				if(index==-1)
+				{
+					target=new ValueContainer;
+					keys.Add(key);
+					values.Add(target);
+				}
+				else
+				{
+					target=values[index];
+				}
+				target->Add(value);
+				return true;
+			}
+
+			/// <summary>Remove a key with all associated values.</summary>
+			/// <returns>Returns true if the key and all associated values are removed.</returns>
+			/// <param name="key">The key.</param>
+			bool Remove(const KK& key)
+			{
+				vint index=keys.IndexOf(key);
+				if(index!=-1)
+				{
+					RemoveByIndex(index);
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			/// <summary>Remove a key with the associated values.</summary>
+			/// <returns>Returns true if the key and the associated values are removed. If there are multiple values associated with the key, only the value will be removed.</returns>
+			/// <param name="key">The key.</param>
+			/// <param name="value">The value.</param>
+			bool Remove(const KK& key, const VK& value)
+			{
+				vint index=keys.IndexOf(key);
+				if(index!=-1)
+				{
+					ValueContainer* target=values[index];
+					target->Remove(value);
+					if(target->Count()==0)
+					{
+						RemoveByIndex(index);
+					}
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			/// <summary>Remove everything.</summary>
+			/// <returns>Returns true if all keys and values are removed.</returns>
+			bool Clear()
+			{
+				for(vint i=0;i<values.Count();i++)
+				{
+					delete values[i];
+				}
+				keys.Clear();
+				values.Clear();
+				return true;
+			}
+		};
+
+/***********************************************************************
+Random Access
+***********************************************************************/
+		namespace randomaccess_internal
+		{
+			template<typename KT, typename VT, typename KK, typename VK>
+			struct RandomAccessable<HashDictionary<KT, VT, KK, VK>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+
+			template<typename KT, typename VT, typename KK, typename VK>
+			struct RandomAccess<HashDictionary<KT, VT, KK, VK>>
+			{
+				static vint GetCount(const HashDictionary<KT, VT, KK, VK>& t)
+				{
+					return t.Count();
+				}
+
+				static Pair<KT, VT> GetValue(const HashDictionary<KT, VT, KK, VK>& t, vint index)
+				{
+					return Pair<KT, VT>(t.Keys().Get(index), t.Values().Get(index));
+				}
+
+				static void AppendValue(HashDictionary<KT, VT, KK, VK>& t, const Pair<KT, VT>& value)
+				{
+					t.Set(value.key, value.value);
+				}
+			};
+		}
+	}
+}
+
+#endif
+
 /***********************************************************************
 .\COLLECTIONS\OPERATIONCOPYFROM.H
 ***********************************************************************/
@@ -5184,6 +5965,11 @@ Classes:
 
 namespace vl
 {
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+	/// <summary>Count of changes to reference counters of all strings, available only when VCZH_CHECK_MEMORY_LEAKS is defined.</summary>
+	extern volatile vint			stringCounterOperations;
+#endif
+
 	/// <summary>A type representing a string.</summary>
 	/// <typeparam name="T">Type of a character.</typeparam>
 	template<typename T>
@@ -5205,6 +5991,15 @@ namespace vl
 			return result;
 		}
 
+		static T* Allocate(vint _length, volatile vint*& _counter)
+		{
+			// the reference counter is followed by characters in the same allocation
+			char* memory=new char[sizeof(vint)+sizeof(T)*(_length+1)];
+			_counter=(volatile vint*)memory;
+			*_counter=1;
+			return (T*)(memory+sizeof(vint));
+		}
+
 		static vint Compare(const T* bufA, const ObjectString<T>& strB)
 		{
 			const T* bufB=strB.buffer+strB.start;
@@ -5245,6 +6040,9 @@ namespace vl
 		{
 			if(counter)
 			{
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+				INCRC(&stringCounterOperations);
+#endif
 				INCRC(counter);
 			}
 		}
@@ -5253,10 +6051,12 @@ namespace vl
 		{
 			if(counter)
 			{
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+				INCRC(&stringCounterOperations);
+#endif
 				if(DECRC(counter)==0)
 				{
-					delete[] buffer;
-					delete counter;
+					delete[] (char*)counter;
 				}
 			}
 		}
@@ -5294,11 +6094,10 @@ namespace vl
 			}
 			else
 			{
-				counter=new vint(1);
 				start=0;
 				length=dest.length-count+source.length;
 				realLength=length;
-				buffer=new T[length+1];
+				buffer=Allocate(length, counter);
 				memcpy(buffer, dest.buffer+dest.start, sizeof(T)*index);
 				memcpy(buffer+index, source.buffer+source.start, sizeof(T)*source.length);
 				memcpy(buffer+index+source.length, (dest.buffer+dest.start+index+count), sizeof(T)*(dest.length-index-count));
@@ -5322,10 +6121,9 @@ namespace vl
 		/// <param name="_char">The character.</param>
 		ObjectString(const T& _char)
 		{
-			counter=new vint(1);
 			start=0;
 			length=1;
-			buffer=new T[2];
+			buffer=Allocate(1, counter);
 			buffer[0]=_char;
 			buffer[1]=0;
 			realLength=length;
@@ -5346,10 +6144,9 @@ namespace vl
 			}
 			else
 			{
-				buffer=new T[_length+1];
+				buffer=Allocate(_length, counter);
 				memcpy(buffer, _buffer, _length*sizeof(T));
 				buffer[_length]=0;
-				counter=new vint(1);
 				start=0;
 				length=_length;
 				realLength=_length;
@@ -5364,10 +6161,9 @@ namespace vl
 			CHECK_ERROR(_buffer!=0, L"ObjectString<T>::ObjectString(const T*, bool)#Cannot construct a string from nullptr.");
 			if(copy)
 			{
-				counter=new vint(1);
 				start=0;
 				length=CalculateLength(_buffer);
-				buffer=new T[length+1];
+				buffer=Allocate(length, counter);
 				memcpy(buffer, _buffer, sizeof(T)*(length+1));
 				realLength=length;
 			}
@@ -5421,12 +6217,13 @@ namespace vl
 		{
 			if(start+length!=realLength)
 			{
-				T* newBuffer=new T[length+1];
+				volatile vint* newCounter=0;
+				T* newBuffer=Allocate(length, newCounter);
 				memcpy(newBuffer, buffer+start, sizeof(T)*length);
 				newBuffer[length]=0;
 				Dec();
 				buffer=newBuffer;
-				counter=new vint(1);
+				counter=newCounter;
 				start=0;
 				realLength=length;
 			}
@@ -5661,6 +6458,18 @@ namespace vl
 	/// <summary>Unicode string.</summary>
 	typedef ObjectString<wchar_t>	WString;
 
+	/// <summary>Get a string with the same content, which shares the buffer with all interned strings of the same content. Copying an interned string does not touch any reference counter. Interned strings are released by [M:vl.FinalizeGlobalStorage] and should not be used after that, they are never released if [M:vl.FinalizeGlobalStorage] is not called. After [M:vl.FinalizeGlobalStorage], this function returns the argument without interning it. This function is designed for identifiers that are frequently copied, it should not be used with arbitrary text.</summary>
+	/// <returns>The interned string.</returns>
+	/// <param name="string">The string to intern.</param>
+	extern AString				InternString(const AString& string);
+	/// <summary>Get a string with the same content, which shares the buffer with all interned strings of the same content. Copying an interned string does not touch any reference counter. Interned strings are released by [M:vl.FinalizeGlobalStorage] and should not be used after that, they are never released if [M:vl.FinalizeGlobalStorage] is not called. After [M:vl.FinalizeGlobalStorage], this function returns the argument without interning it. This function is designed for identifiers that are frequently copied, it should not be used with arbitrary text.</summary>
+	/// <returns>The interned string.</returns>
+	/// <param name="string">The string to intern.</param>
+	extern WString				InternString(const WString& string);
+	/// <summary>Enable or disable [M:vl.InternString], it is enabled by default. When it is disabled, [M:vl.InternString] returns the argument without interning it, and strings that are already interned are still valid.</summary>
+	/// <param name="enabled">Set to true to enable interning.</param>
+	extern void					SetInternStringEnabled(bool enabled);
+
 	/// <summary>Convert a string to an signed integer.</summary>
 	/// <returns>The converted number. If the convert failed, the result is undefined.</returns>
 	/// <param name="string">The string to convert.</param>
@@ -7248,6 +8057,7 @@ Tokenizer
 		class RegexLexerWalker : public Object
 		{
 			friend class RegexLexer;
+			friend class RegexLexerColorizer;
 		protected:
 			regex_internal::PureInterpretor*			pure;
 			const collections::Array<vint>&				stateTokens;
@@ -7321,6 +8131,12 @@ Tokenizer
 			/// <param name="tokenProc">Colorizer callback. This callback will be called if any token is found..</param>
 			/// <param name="tokenProcArgument">The argument to call the callback.</param>
 			void										Colorize(const wchar_t* input, vint length, TokenProc tokenProc, void* tokenProcArgument);
+			/// <summary>Colorize a text by stepping the <see cref="RegexLexerWalker"/> for each character. This is the reference implementation of <see cref="Colorize"/>, which reads the DFA tables directly.</summary>
+			/// <param name="input">The text to colorize.</param>
+			/// <param name="length">Size of the text in characters.</param>
+			/// <param name="tokenProc">Colorizer callback. This callback will be called if any token is found..</param>
+			/// <param name="tokenProcArgument">The argument to call the callback.</param>
+			void										ColorizeByWalker(const wchar_t* input, vint length, TokenProc tokenProc, void* tokenProcArgument);
 		};
 
 		/// <summary>Lexical analyzer.</summary>
@@ -7928,6 +8744,7 @@ namespace vl
 
 		class PureInterpretor : public Object
 		{
+			friend class regex::RegexLexerColorizer;
 		protected:
 #if defined VCZH_MSVC
 			static const vint	SupportedCharCount = 0x10000;		// UTF-16
@@ -9828,6 +10645,7 @@ Compression
 			bool									ReadNumber(vint& number, vint bitSize);
 			void									PrepareOutputBuffer(vint size);
 			void									ExpandCodeToOutputBuffer(lzw::Code* code);
+			lzw::Code*								CreateDecodedCode(lzw::Code* prefix, vuint8_t byte);
 		public:
 			/// <summary>Create an decoder.</summary>
 			LzwDecoder();
@@ -11116,6 +11934,71 @@ General Syntax Tree
 		class ParsingTreeObject;
 		class ParsingTreeArray;
 
+		/// <summary>
+		/// A region allocator for syntax tree nodes.
+		/// When arenas are enabled by [M:vl.parsing.ParsingArena.SetEnabled] and a <see cref="ParsingArena::Scope"/> is alive in the current thread, all <see cref="ParsingTreeNode"/> and <see cref="ParsingTreeCustomBase"/> objects created in this thread are bump-allocated from blocks owned by the arena.
+		/// Each block counts nodes that are still alive, so nodes are allowed to outlive the arena and to be deleted in any thread, the block is released when the last node in it is deleted.
+		/// A node that is kept after the compilation keeps the whole block, so arenas are disabled by default, and should only be enabled when syntax trees are released together with the compiler.
+		/// An arena can only be activated in one thread at the same time.
+		/// </summary>
+		class ParsingArena : public Object, private NotCopyable
+		{
+		protected:
+			struct Block
+			{
+				volatile vint					counter;
+				vint							used;
+				vint							size;
+			};
+
+			vint								blockSize;
+			Block*								currentBlock = nullptr;
+			vint								allocatedBlocks = 0;
+
+			void*								Allocate(size_t size);
+			static void							ReleaseBlock(Block* block);
+		public:
+			/// <summary>Activate an arena in the current thread until this object is destroyed. It does nothing if arenas are disabled when it is created.</summary>
+			class Scope : public Object, private NotCopyable
+			{
+			protected:
+				bool							activated;
+				ParsingArena*					previous;
+			public:
+				/// <summary>Create a scope.</summary>
+				/// <param name="arena">The arena to activate.</param>
+				Scope(ParsingArena& arena);
+				~Scope();
+			};
+
+			/// <summary>Create an arena.</summary>
+			/// <param name="_blockSize">Size of each block in bytes. Nodes larger than a quarter of a block are allocated from the heap.</param>
+			ParsingArena(vint _blockSize = 65536);
+			~ParsingArena();
+
+			/// <summary>Get the number of blocks that are allocated by this arena.</summary>
+			/// <returns>The number of blocks.</returns>
+			vint								GetAllocatedBlockCount();
+
+			/// <summary>Enable or disable arenas, they are disabled by default. Nodes that are already allocated from arenas are not affected.</summary>
+			/// <param name="enabled">Set to true to enable arenas.</param>
+			static void							SetEnabled(bool enabled);
+			/// <summary>Test if arenas are enabled.</summary>
+			/// <returns>Returns true if arenas are enabled.</returns>
+			static bool							IsEnabled();
+			/// <summary>Get the number of blocks of all arenas that are not released yet.</summary>
+			/// <returns>The number of blocks.</returns>
+			static vint							GetLiveBlockCount();
+
+			/// <summary>Allocate memory for a node from the arena activated in the current thread, or from the heap if there is no such arena.</summary>
+			/// <returns>The allocated memory.</returns>
+			/// <param name="size">Size of the memory.</param>
+			static void*						AllocateNode(size_t size);
+			/// <summary>Free memory allocated by <see cref="AllocateNode"/>.</summary>
+			/// <param name="memory">The memory to free.</param>
+			static void							FreeNode(void* memory);
+		};
+
 		/// <summary>Abstract syntax tree.</summary>
 		class ParsingTreeNode : public Object, public reflection::Description<ParsingTreeNode>
 		{
@@ -11168,6 +12051,11 @@ General Syntax Tree
 			ParsingTreeNode(const ParsingTextRange& _codeRange);
 			~ParsingTreeNode();
 
+			static void*						operator new(size_t size){ return ParsingArena::AllocateNode(size); }
+			static void*						operator new(size_t size, void* memory){ return memory; }
+			static void							operator delete(void* memory){ ParsingArena::FreeNode(memory); }
+			static void							operator delete(void* memory, void* placement){}
+
 			virtual void						Accept(IVisitor* visitor)=0;
 			virtual Ptr<ParsingTreeNode>		Clone()=0;
 			ParsingTextRange					GetCodeRange();
@@ -11314,6 +12202,11 @@ AST Building Block
 			ParsingTextRange					codeRange;
 			/// <summary>Names of all rules that return this object.</summary>
 			collections::List<WString>			creatorRules;
+
+			static void*						operator new(size_t size){ return ParsingArena::AllocateNode(size); }
+			static void*						operator new(size_t size, void* memory){ return memory; }
+			static void							operator delete(void* memory){ ParsingArena::FreeNode(memory); }
+			static void							operator delete(void* memory, void* placement){}
 		};
 
 		/// <summary>Strong typed token syntax node, for all class fields of type "token" in the grammar file. See [T:vl.parsing.tabling.ParsingTable] for details.</summary>
@@ -14389,7 +15282,8 @@ SerializableTypeDescriptor
 			class ValueTypeDescriptorBase : public TypeDescriptorImplBase
 			{
 			protected:
-				bool										loaded;
+				volatile bool								loaded;
+				bool										loading;
 				Ptr<IValueType>								valueType;
 				Ptr<IEnumType>								enumType;
 				Ptr<ISerializableType>						serializableType;
@@ -14569,6 +15463,11 @@ MethodInfoImpl
 				bool									IsStatic()override;
 				void									CheckArguments(collections::Array<Value>& arguments)override;
 				Value									Invoke(const Value& thisObject, collections::Array<Value>& arguments)override;
+				/// <summary>Invoke the method without checking the this object, arguments are still checked. The caller should make sure that the this object is null for a static method, or is convertible to the owner type.</summary>
+				/// <returns>The return value.</returns>
+				/// <param name="thisObject">The this object.</param>
+				/// <param name="arguments">The arguments.</param>
+				Value									InvokeWithCheckedThisObject(const Value& thisObject, collections::Array<Value>& arguments);
 				Value									CreateFunctionProxy(const Value& thisObject)override;
 				bool									AddParameter(Ptr<IParameterInfo> parameter);
 				bool									SetOwnerMethodgroup(IMethodGroupInfo* _ownerMethodGroup);
@@ -14709,7 +15608,8 @@ TypeDescriptorImpl
 			class TypeDescriptorImpl : public TypeDescriptorImplBase
 			{
 			private:
-				bool														loaded;
+				volatile bool												loaded;
+				bool														loading;
 				collections::List<ITypeDescriptor*>							baseTypeDescriptors;
 				collections::Dictionary<WString, Ptr<IPropertyInfo>>		properties;
 				collections::Dictionary<WString, Ptr<IEventInfo>>			events;
@@ -14731,6 +15631,10 @@ TypeDescriptorImpl
 				TypeDescriptorImpl(TypeDescriptorFlags _typeDescriptorFlags, const TypeInfoContent* _typeInfoContent);
 				~TypeDescriptorImpl();
 
+				/// <summary>Test if members of this type have been loaded.</summary>
+				/// <returns>Returns true if members of this type have been loaded.</returns>
+				bool						IsLoaded();
+
 				bool						IsAggregatable()override;
 				IValueType*					GetValueType()override;
 				IEnumType*					GetEnumType()override;
@@ -19070,6 +19974,166 @@ namespace vl
 				const XmlElementWriter&			CData(const WString& value)const;
 				const XmlElementWriter&			Comment(const WString& value)const;
 			};
+
+/***********************************************************************
+XmlPullParser
+***********************************************************************/
+
+			/// <summary>A token read by <see cref="XmlPullParser"/>. The text is not copied, it points to the input of the parser.</summary>
+			struct XmlPullToken
+			{
+				/// <summary>The first character of the token in the input.</summary>
+				const wchar_t*					reading = nullptr;
+				/// <summary>The number of characters in the token.</summary>
+				vint							length = 0;
+				/// <summary>The index of the token in the token stream, including discarded tokens. It is -1 for an empty token.</summary>
+				vint							tokenIndex = -1;
+				/// <summary>The range of the token.</summary>
+				ParsingTextRange				codeRange;
+
+				/// <summary>Copy the text of the token.</summary>
+				/// <returns>The text of the token.</returns>
+				WString							ToString()const;
+				/// <summary>Copy the token to a <see cref="ParsingToken"/>.</summary>
+				/// <param name="token">The parsing token to fill.</param>
+				void							ToParsingToken(ParsingToken& token)const;
+			};
+
+			/// <summary>
+			/// A streaming XML parser that accepts the same syntax as <see cref="XmlParseDocument"/>, but reads the input directly without a parsing table.
+			/// Each call to [M:vl.parsing.xml.XmlPullParser.Next] reports one construct, names and values point to the input without copying.
+			/// </summary>
+			class XmlPullParser : public Object, private NotCopyable
+			{
+			public:
+				/// <summary>Constructs reported by the parser.</summary>
+				enum class EventType
+				{
+					/// <summary>Nothing has been read.</summary>
+					None,
+					/// <summary>"&lt;?name", the name is available.</summary>
+					BeginInstruction,
+					/// <summary>"?&gt;".</summary>
+					EndInstruction,
+					/// <summary>"&lt;name", the name is available.</summary>
+					BeginElement,
+					/// <summary>"/&gt;" or "&lt;/name&gt;", the name is empty for "/&gt;".</summary>
+					EndElement,
+					/// <summary>name="value" in an instruction or an element, both name and value are available. The value is still quoted and escaped.</summary>
+					Attribute,
+					/// <summary>A text fragment between other constructs, the value is available. It is still escaped and it includes spaces around the text.</summary>
+					Text,
+					/// <summary>A CDATA section, the value is available. It still contains the boundaries.</summary>
+					CData,
+					/// <summary>A comment, the value is available. It still contains the boundaries.</summary>
+					Comment,
+					/// <summary>The document is completed.</summary>
+					EndOfDocument,
+					/// <summary>A syntax error is found, the error is available.</summary>
+					Error,
+				};
+
+			protected:
+				enum class TokenType
+				{
+					InstructionOpen,
+					InstructionClose,
+					ComplexElementOpen,
+					SingleElementClose,
+					ElementOpen,
+					ElementClose,
+					Equal,
+					Name,
+					AttValue,
+					Comment,
+					CData,
+					Text,
+					Space,
+					EndOfInput,
+				};
+
+				enum class State
+				{
+					Prolog,
+					InstructionAttributes,
+					ElementAttributes,
+					Content,
+					Epilog,
+					Finished,
+				};
+
+				struct RawToken
+				{
+					TokenType					type = TokenType::EndOfInput;
+					XmlPullToken				token;
+				};
+
+				WString							input;
+				vint							codeIndex;
+				const wchar_t*					reading;
+				vint							row = 0;
+				vint							column = 0;
+				vint							tokenCount = 0;
+				RawToken						lookahead;
+				bool							lookaheadAvailable = false;
+				RawToken						previousSpace;
+				State							state = State::Prolog;
+				vint							depth = 0;
+
+				EventType						eventType = EventType::None;
+				XmlPullToken					eventName;
+				XmlPullToken					eventValue;
+				ParsingTextRange				eventRange;
+				Ptr<ParsingError>				eventError;
+
+				vint							MatchComment(const wchar_t* begin);
+				vint							MatchCData(const wchar_t* begin);
+				void							ReadRawToken(RawToken& rawToken);
+				const RawToken&					PeekToken();
+				RawToken						ReadToken();
+				bool							ReadToken(TokenType type, XmlPullToken& token);
+				bool							Fail();
+				bool							ReadAttribute();
+				bool							ReadBeginElement();
+				bool							ReadEndElement(const XmlPullToken& open, const XmlPullToken& close);
+				bool							ReadSingleToken(EventType type);
+				bool							ReadText();
+			public:
+				/// <summary>Create a parser on a string.</summary>
+				/// <param name="_input">The XML document.</param>
+				/// <param name="_codeIndex">The code index to put in all ranges, refer to [F:vl.regex.RegexToken.codeIndex].</param>
+				XmlPullParser(const WString& _input, vint _codeIndex = -1);
+				/// <summary>Create a parser on everything remaining in a reader. The text is read before parsing because names and values point to it.</summary>
+				/// <param name="reader">The reader to read the XML document from.</param>
+				/// <param name="_codeIndex">The code index to put in all ranges, refer to [F:vl.regex.RegexToken.codeIndex].</param>
+				XmlPullParser(stream::TextReader& reader, vint _codeIndex = -1);
+				~XmlPullParser();
+
+				/// <summary>Read the next construct.</summary>
+				/// <returns>Returns false if [F:vl.parsing.xml.XmlPullParser.EventType.EndOfDocument] or [F:vl.parsing.xml.XmlPullParser.EventType.Error] has already been reported.</returns>
+				bool							Next();
+				/// <summary>Get the type of the last construct.</summary>
+				/// <returns>The type of the last construct.</returns>
+				EventType						GetEventType();
+				/// <summary>Get the name of the last construct.</summary>
+				/// <returns>The name of the last construct.</returns>
+				const XmlPullToken&				GetName();
+				/// <summary>Get the value of the last construct.</summary>
+				/// <returns>The value of the last construct.</returns>
+				const XmlPullToken&				GetValue();
+				/// <summary>Get the range of all tokens in the last construct.</summary>
+				/// <returns>The range of all tokens in the last construct.</returns>
+				const ParsingTextRange&			GetRange();
+				/// <summary>Get the error if the last construct is [F:vl.parsing.xml.XmlPullParser.EventType.Error].</summary>
+				/// <returns>The error.</returns>
+				Ptr<ParsingError>				GetError();
+			};
+
+			/// <summary>Build an XML document from a pull parser. The document is the same as the one from <see cref="XmlParseDocument"/> on the same input.</summary>
+			/// <returns>The XML document. Returns null if there is any syntax error.</returns>
+			/// <param name="parser">The parser to read constructs from. It should not have read anything.</param>
+			/// <param name="errors">Syntax errors.</param>
+			extern Ptr<XmlDocument>								XmlBuildDocument(XmlPullParser& parser, collections::List<Ptr<ParsingError>>& errors);
 		}
 	}
 }
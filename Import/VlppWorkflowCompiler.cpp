@@ -13019,9 +13019,9 @@ WfLexicalScopeName
 				if (index == -1)
 				{
 					Ptr<WfLexicalScopeName> newName = new WfLexicalScopeName(imported);
-					newName->name = name;
+					newName->name = InternString(name);
 					newName->parent = this;
-					children.Add(name, newName);
+					children.Add(newName->name, newName);
 					return newName;
 				}
 				else
@@ -13272,6 +13272,7 @@ WfLexicalScopeManager
 
 			vint WfLexicalScopeManager::AddModule(const WString& moduleCode)
 			{
+				parsing::ParsingArena::Scope arenaScope(arena);
 				if (auto module = WfParseModule(moduleCode, parsingTable, errors, usedCodeIndex))
 				{
 					modules.Add(module);
@@ -13346,6 +13347,7 @@ WfLexicalScopeManager
 
 			void WfLexicalScopeManager::Rebuild(bool keepTypeDescriptorNames, IWfCompilerCallback* callback)
 			{
+				parsing::ParsingArena::Scope arenaScope(arena);
 				CALLBACK(OnLoadEnvironment());
 				Clear(keepTypeDescriptorNames, false);
 				if (!globalName)
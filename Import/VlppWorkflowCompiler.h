@@ -3905,8 +3905,8 @@ Scope Manager
 				typedef collections::List<Ptr<parsing::ParsingError>>										ParsingErrorList;
 				typedef collections::Dictionary<Ptr<WfNamespaceDeclaration>, Ptr<WfLexicalScopeName>>		NamespaceNameMap;
 				typedef collections::Dictionary<ITypeDescriptor*, Ptr<WfLexicalScopeName>>					TypeNameMap;
-				typedef collections::Dictionary<parsing::ParsingTreeCustomBase*, Ptr<WfLexicalScope>>		NodeScopeMap;
-				typedef collections::Dictionary<Ptr<WfExpression>, ResolveExpressionResult>					ExpressionResolvingMap;
+				typedef collections::HashDictionary<parsing::ParsingTreeCustomBase*, Ptr<WfLexicalScope>>	NodeScopeMap;
+				typedef collections::HashDictionary<Ptr<WfExpression>, ResolveExpressionResult>				ExpressionResolvingMap;
 				typedef collections::Dictionary<Ptr<WfStatement>, ResolveExpressionResult>					CoOperatorResolvingMap;
 				typedef collections::Dictionary<parsing::ParsingTreeCustomBase*, Ptr<WfLexicalCapture>>		LambdaCaptureMap;
 				typedef collections::Dictionary<WfFunctionDeclaration*, IMethodInfo*>						InterfaceMethodImplementationMap;
@@ -3927,6 +3927,7 @@ Scope Manager
 				ModuleList									modules;
 				ModuleCodeList								moduleCodes;
 				vint										usedCodeIndex = 0;
+				parsing::ParsingArena						arena;							// allocates syntax trees that are parsed or generated by this compiler, when arenas are enabled
 
 			public:
 				Ptr<parsing::tabling::ParsingTable>			parsingTable;
@@ -24,6 +24,59 @@ namespace vl
 WfRuntimeGlobalContext
 ***********************************************************************/
 
+			void WfRuntimeGlobalContext::ResolveInstructionCaches(vint firstInstruction, vint lastInstruction)
+			{
+				for (vint i = firstInstruction; i <= lastInstruction; i++)
+				{
+					auto& ins = assembly->instructions[i];
+					auto& cache = instructionCaches[i];
+
+					IMethodInfo* method = nullptr;
+					switch (ins.code)
+					{
+					case WfInsCode::InvokeMethod:
+						method = ins.methodParameter;
+						break;
+					case WfInsCode::GetProperty:
+						method = ins.propertyParameter->GetGetter();
+						break;
+					case WfInsCode::SetProperty:
+					case WfInsCode::UpdateProperty:
+						method = ins.propertyParameter->GetSetter();
+						break;
+					default:;
+					}
+					if (!method) continue;
+
+					if (auto staticMethod = dynamic_cast<typeimpl::WfStaticMethod*>(method))
+					{
+						if (staticMethod->GetGlobalContext() == this)
+						{
+							cache.kind = WfInstructionCacheKind::ScriptFunction;
+							cache.functionIndex = staticMethod->functionIndex;
+							continue;
+						}
+					}
+
+					if (auto classMethod = dynamic_cast<typeimpl::WfClassMethod*>(method))
+					{
+						// a script setter returns a value to the stack, so only getters and methods enter the script function directly
+						if (classMethod->GetGlobalContext() == this && ins.code != WfInsCode::SetProperty && ins.code != WfInsCode::UpdateProperty)
+						{
+							cache.kind = WfInstructionCacheKind::ScriptMethod;
+							cache.functionIndex = classMethod->functionIndex;
+							continue;
+						}
+					}
+
+					if (auto nativeMethod = dynamic_cast<MethodInfoImpl*>(method))
+					{
+						cache.kind = WfInstructionCacheKind::NativeMethod;
+						cache.nativeMethod = nativeMethod;
+					}
+				}
+			}
+
 			WfRuntimeGlobalContext::WfRuntimeGlobalContext(Ptr<WfAssembly> _assembly)
 				:assembly(_assembly)
 			{
@@ -33,6 +86,12 @@ WfRuntimeGlobalContext
 				{
 					assembly->typeImpl->SetGlobalContext(this);
 				}
+				instructionCaches.Resize(assembly->instructions.Count());
+				preparedFunctions.Resize(assembly->functions.Count());
+				for (vint i = 0; i < preparedFunctions.Count(); i++)
+				{
+					preparedFunctions[i] = 0;
+				}
 			}
 
 			WfRuntimeGlobalContext::~WfRuntimeGlobalContext()
@@ -43,6 +102,26 @@ WfRuntimeGlobalContext
 				}
 			}
 
+			void WfRuntimeGlobalContext::PrepareFunction(vint functionIndex)
+			{
+				// functions could be called in multiple threads
+				// the flag is published by INCRC after the function is prepared, so that no thread executes a function that is being prepared
+				auto& prepared = preparedFunctions[functionIndex];
+				if (*(volatile vint*)&prepared == 0)
+				{
+					CS_LOCK(prepareLock)
+					{
+						if (prepared == 0)
+						{
+							assembly->LoadFunctionInstructions(functionIndex);
+							auto meta = assembly->functions[functionIndex];
+							ResolveInstructionCaches(meta->firstInstruction, meta->lastInstruction);
+							INCRC(&prepared);
+						}
+					}
+				}
+			}
+
 /***********************************************************************
 WfRuntimeCallStackInfo
 ***********************************************************************/
@@ -99,7 +178,7 @@ WfRuntimeCallStackInfo
 					arguments->variables.Resize(function->argumentNames.Count());
 					for (vint i = 0; i < arguments->variables.Count(); i++)
 					{
-						arguments->variables[i] = context->stack[stackFrame.stackBase + i];
+						arguments->variables[i] = context->stack[stackFrame.stackBase + i].GetValue();
 					}
 				}
 
@@ -109,7 +188,7 @@ WfRuntimeCallStackInfo
 					localVariables->variables.Resize(function->localVariableNames.Count());
 					for (vint i = 0; i < localVariables->variables.Count(); i++)
 					{
-						localVariables->variables[i] = context->stack[stackFrame.stackBase + function->argumentNames.Count() + i];
+						localVariables->variables[i] = context->stack[stackFrame.stackBase + function->argumentNames.Count() + i].GetValue();
 					}
 				}
 			}
@@ -153,12 +232,12 @@ WfRuntimeCallStackInfo
 				{
 					return L"";
 				}
-				const auto& range = assembly->insBeforeCodegen->instructionCodeMapping[instruction];
+				const auto& range = assembly->GetInsBeforeCodegen()->instructionCodeMapping[instruction];
 				if (range.codeIndex == -1)
 				{
 					return L"";
 				}
-				return assembly->insBeforeCodegen->moduleCodes[range.codeIndex];
+				return assembly->GetInsBeforeCodegen()->moduleCodes[range.codeIndex];
 			}
 
 			WString WfRuntimeCallStackInfo::GetSourceCodeAfterCodegen()
@@ -167,12 +246,12 @@ WfRuntimeCallStackInfo
 				{
 					return L"";
 				}
-				const auto& range = assembly->insAfterCodegen->instructionCodeMapping[instruction];
+				const auto& range = assembly->GetInsAfterCodegen()->instructionCodeMapping[instruction];
 				if (range.codeIndex == -1)
 				{
 					return L"";
 				}
-				return assembly->insAfterCodegen->moduleCodes[range.codeIndex];
+				return assembly->GetInsAfterCodegen()->moduleCodes[range.codeIndex];
 			}
 
 			vint WfRuntimeCallStackInfo::GetRowBeforeCodegen()
@@ -181,7 +260,7 @@ WfRuntimeCallStackInfo
 				{
 					return -1;
 				}
-				const auto& range = assembly->insBeforeCodegen->instructionCodeMapping[instruction];
+				const auto& range = assembly->GetInsBeforeCodegen()->instructionCodeMapping[instruction];
 				return range.start.row;
 			}
 
@@ -191,7 +270,7 @@ WfRuntimeCallStackInfo
 				{
 					return -1;
 				}
-				const auto& range = assembly->insAfterCodegen->instructionCodeMapping[instruction];
+				const auto& range = assembly->GetInsAfterCodegen()->instructionCodeMapping[instruction];
 				return range.start.row;
 			}
 
@@ -240,6 +319,45 @@ WfRuntimeExceptionInfo
 				return cachedCallStack;
 			}
 
+/***********************************************************************
+WfRuntimeStackValue
+***********************************************************************/
+
+			WfRuntimeStackValue::WfRuntimeStackValue()
+				:intValue(0)
+			{
+			}
+
+			WfRuntimeStackValue::WfRuntimeStackValue(const reflection::description::Value& value)
+				:intValue(0)
+				, boxedValue(value)
+			{
+			}
+
+			bool WfRuntimeStackValue::IsNull()const
+			{
+				return type == WfInsType::Unknown && boxedValue.IsNull();
+			}
+
+			reflection::description::Value WfRuntimeStackValue::GetValue()const
+			{
+				switch (type)
+				{
+				case WfInsType::Bool:	return BoxValue<bool>(boolValue);
+				case WfInsType::I1:		return BoxValue<vint8_t>((vint8_t)intValue);
+				case WfInsType::I2:		return BoxValue<vint16_t>((vint16_t)intValue);
+				case WfInsType::I4:		return BoxValue<vint32_t>((vint32_t)intValue);
+				case WfInsType::I8:		return BoxValue<vint64_t>((vint64_t)intValue);
+				case WfInsType::U1:		return BoxValue<vuint8_t>((vuint8_t)uintValue);
+				case WfInsType::U2:		return BoxValue<vuint16_t>((vuint16_t)uintValue);
+				case WfInsType::U4:		return BoxValue<vuint32_t>((vuint32_t)uintValue);
+				case WfInsType::U8:		return BoxValue<vuint64_t>((vuint64_t)uintValue);
+				case WfInsType::F4:		return BoxValue<float>((float)floatValue);
+				case WfInsType::F8:		return BoxValue<double>(floatValue);
+				default:				return boxedValue;
+				}
+			}
+
 /***********************************************************************
 WfRuntimeThreadContext
 ***********************************************************************/
@@ -285,6 +403,7 @@ WfRuntimeThreadContext
 					return WfRuntimeThreadContextError::WrongFunctionIndex;
 				}
 				auto meta = globalContext->assembly->functions[functionIndex];
+				globalContext->PrepareFunction(functionIndex);
 				if (meta->argumentNames.Count() != argumentCount)
 				{
 					return WfRuntimeThreadContextError::WrongArgumentCount;
@@ -316,7 +435,7 @@ WfRuntimeThreadContext
 
 				for (vint i = 0; i < meta->localVariableNames.Count(); i++)
 				{
-					stack.Add(Value());
+					stack.Add(WfRuntimeStackValue());
 				}
 				if (status == WfRuntimeExecutionStatus::Finished || status == WfRuntimeExecutionStatus::FatalError)
 				{
@@ -383,11 +502,44 @@ WfRuntimeThreadContext
 
 			WfRuntimeThreadContextError WfRuntimeThreadContext::PushValue(const reflection::description::Value& value)
 			{
-				stack.Add(value);
+				// copy the value directly into the new slot, a temporary WfRuntimeStackValue costs another copy of the value
+				stack.Add(WfRuntimeStackValue());
+				stack[stack.Count() - 1].boxedValue = value;
 				return WfRuntimeThreadContextError::Success;
 			}
 
 			WfRuntimeThreadContextError WfRuntimeThreadContext::PopValue(reflection::description::Value& value)
+			{
+				if (stackFrames.Count() == 0)
+				{
+					if (stack.Count() == 0) return WfRuntimeThreadContextError::EmptyStack;
+				}
+				else
+				{
+					WfRuntimeStackFrame& frame = GetCurrentStackFrame();
+					if (stack.Count() <= frame.freeStackBase) return WfRuntimeThreadContextError::StackCorrupted;
+				}
+
+				const auto& stackValue = stack[stack.Count() - 1];
+				if (stackValue.type == WfInsType::Unknown)
+				{
+					value = stackValue.boxedValue;
+				}
+				else
+				{
+					value = stackValue.GetValue();
+				}
+				stack.RemoveAt(stack.Count() - 1);
+				return WfRuntimeThreadContextError::Success;
+			}
+
+			WfRuntimeThreadContextError WfRuntimeThreadContext::PushStackValue(const WfRuntimeStackValue& value)
+			{
+				stack.Add(value);
+				return WfRuntimeThreadContextError::Success;
+			}
+
+			WfRuntimeThreadContextError WfRuntimeThreadContext::PopStackValue(WfRuntimeStackValue& value)
 			{
 				if (stackFrames.Count() == 0)
 				{
@@ -463,7 +615,7 @@ WfRuntimeThreadContext
 					return WfRuntimeThreadContextError::WrongVariableIndex;
 				}
 
-				value = stack[stackItemIndex];
+				value = stack[stackItemIndex].GetValue();
 				return WfRuntimeThreadContextError::Success;
 			}
 
@@ -524,7 +676,7 @@ WfRuntimeThreadContext
 					return WfRuntimeThreadContextError::WrongVariableIndex;
 				}
 
-				value = stack[frame.stackBase + variableIndex];
+				value = stack[frame.stackBase + variableIndex].GetValue();
 				return WfRuntimeThreadContextError::Success;
 			}
 
@@ -537,6 +689,34 @@ WfRuntimeThreadContext
 					return WfRuntimeThreadContextError::WrongVariableIndex;
 				}
 
+				auto& stackValue = stack[frame.stackBase + variableIndex];
+				stackValue.type = WfInsType::Unknown;
+				stackValue.boxedValue = value;
+				return WfRuntimeThreadContextError::Success;
+			}
+
+			WfRuntimeThreadContextError WfRuntimeThreadContext::LoadLocalStackValue(vint variableIndex, WfRuntimeStackValue& value)
+			{
+				if (stackFrames.Count() == 0) return WfRuntimeThreadContextError::EmptyStackFrame;
+				auto& frame = GetCurrentStackFrame();
+				if (variableIndex < 0 || variableIndex >= frame.fixedVariableCount)
+				{
+					return WfRuntimeThreadContextError::WrongVariableIndex;
+				}
+
+				value = stack[frame.stackBase + variableIndex];
+				return WfRuntimeThreadContextError::Success;
+			}
+
+			WfRuntimeThreadContextError WfRuntimeThreadContext::StoreLocalStackValue(vint variableIndex, const WfRuntimeStackValue& value)
+			{
+				if (stackFrames.Count() == 0) return WfRuntimeThreadContextError::EmptyStackFrame;
+				auto& frame = GetCurrentStackFrame();
+				if (variableIndex < 0 || variableIndex >= frame.fixedVariableCount)
+				{
+					return WfRuntimeThreadContextError::WrongVariableIndex;
+				}
+
 				stack[frame.stackBase + variableIndex] = value;
 				return WfRuntimeThreadContextError::Success;
 			}
@@ -569,6 +749,66 @@ namespace vl
 	using namespace workflow::typeimpl;
 	using namespace collections;
 
+	namespace stream
+	{
+		namespace internal
+		{
+			struct WfReaderContext;
+		}
+	}
+
+	namespace workflow
+	{
+		namespace runtime
+		{
+
+/***********************************************************************
+WfAssemblyLoader
+***********************************************************************/
+
+			// a serialized assembly begins with this tag, followed by WfAssemblyFormatVersion
+			// an assembly in the previous format begins with a bool, which is 0 or -1
+			static const vint8_t								WfAssemblyFormatTag = 1;
+			static const vint									WfAssemblyFormatVersion = 1;
+
+			struct WfAssemblyRange
+			{
+				vint											offset = 0;
+				vint											length = 0;
+			};
+
+			struct WfAssemblyChunk
+			{
+				vint											firstInstruction = -1;
+				vint											lastInstruction = -1;
+				WfAssemblyRange									range;
+				vint											loaded = 0;				// published by INCRC after instructions are loaded
+			};
+
+			class WfAssemblyLoader : public Object
+			{
+			public:
+				Ptr<stream::internal::WfReaderContext>			context;
+				Ptr<WfTypeImpl>									typeImpl;
+				Array<vuint8_t>									data;					// binary of everything that are loaded on demand
+				Array<WfAssemblyRange>							methodRanges;
+				Array<WfAssemblyRange>							propertyRanges;
+				Array<WfAssemblyRange>							eventRanges;
+				Array<WfAssemblyChunk>							chunks;					// instructions of functions
+				Array<vint>										functionChunks;			// function index -> chunk index
+				WfAssemblyRange									insBeforeCodegen;
+				WfAssemblyRange									insAfterCodegen;
+				vint											insBeforeCodegenLoaded = 0;
+				vint											insAfterCodegenLoaded = 0;
+				bool											typesRegistered = false;
+
+				// everything that are loaded on demand is loaded with this lock
+				// metadata is only loaded when reading instructions or debug informations, so it is also protected by this lock
+				CriticalSection									lock;
+			};
+		}
+	}
+
 	namespace stream
 	{
 		namespace internal
@@ -576,9 +816,14 @@ namespace vl
 			struct WfReaderContext
 			{
 				Dictionary<vint, ITypeDescriptor*>				tdIndex;
-				Dictionary<vint, IMethodInfo*>					miIndex;
-				Dictionary<vint, IPropertyInfo*>				piIndex;
-				Dictionary<vint, IEventInfo*>					eiIndex;
+				Array<IMethodInfo*>								miIndex;
+				Array<IPropertyInfo*>							piIndex;
+				Array<IEventInfo*>								eiIndex;
+				WfAssemblyLoader*								loader = nullptr;		// resolve metadata on demand if it is not null
+
+				IMethodInfo*									GetMethod(vint index);
+				IPropertyInfo*									GetProperty(vint index);
+				IEventInfo*										GetEvent(vint index);
 			};
 
 			struct WfWriterContextPrepare
@@ -620,6 +865,39 @@ namespace vl
 			using WfReader = Reader<Ptr<WfReaderContext>>;
 			using WfWriter = Writer<Ptr<WfWriterContext>>;
 
+			// the caller must own loader->lock, except in the constructor of WfAssembly
+			template<typename F>
+			void ReadDeferred(WfAssemblyLoader* loader, const WfAssemblyRange& range, const F& callback)
+			{
+				MemoryWrapperStream stream(&loader->data[range.offset], range.length);
+				WfReader reader(stream);
+				reader.context = loader->context;
+
+				// custom types are registered only when they are not registered by the assembly or a global context
+				bool registerTypes = loader->typeImpl && !loader->typeImpl->GetGlobalContext() && !loader->typesRegistered;
+				if (registerTypes)
+				{
+					loader->typesRegistered = true;
+					GetGlobalTypeManager()->AddTypeLoader(loader->typeImpl);
+				}
+				callback(reader);
+				if (registerTypes)
+				{
+					GetGlobalTypeManager()->RemoveTypeLoader(loader->typeImpl);
+					loader->typesRegistered = false;
+				}
+			}
+
+			template<typename F>
+			WfAssemblyRange WriteDeferred(WfWriter& writer, MemoryStream& stream, const F& callback)
+			{
+				WfAssemblyRange range;
+				range.offset = (vint)stream.Position();
+				callback(writer);
+				range.length = (vint)stream.Position() - range.offset;
+				return range;
+			}
+
 /***********************************************************************
 Serialization (CollectMetadata)
 ***********************************************************************/
@@ -849,6 +1127,11 @@ Serizliation (Data Structures)
 				SERIALIZE(instructionCodeMapping)
 			END_SERIALIZATION
 
+			BEGIN_SERIALIZATION(WfAssemblyRange)
+				SERIALIZE(offset)
+				SERIALIZE(length)
+			END_SERIALIZATION
+
 			BEGIN_SERIALIZATION(WfAssemblyFunction)
 				SERIALIZE(name)
 				SERIALIZE(argumentNames)
@@ -1200,6 +1483,39 @@ Serizliation (Metadata)
 				}
 			};
 
+			// GetMethod, GetProperty and GetEvent are only called when reading instructions or custom types
+			// the caller is either the constructor of WfAssembly, or a ReadDeferred call that owns loader->lock
+
+			IMethodInfo* WfReaderContext::GetMethod(vint index)
+			{
+				auto& value = miIndex[index];
+				if (!value && loader)
+				{
+					ReadDeferred(loader, loader->methodRanges[index], [&](WfReader& reader) { reader << value; });
+				}
+				return value;
+			}
+
+			IPropertyInfo* WfReaderContext::GetProperty(vint index)
+			{
+				auto& value = piIndex[index];
+				if (!value && loader)
+				{
+					ReadDeferred(loader, loader->propertyRanges[index], [&](WfReader& reader) { reader << value; });
+				}
+				return value;
+			}
+
+			IEventInfo* WfReaderContext::GetEvent(vint index)
+			{
+				auto& value = eiIndex[index];
+				if (!value && loader)
+				{
+					ReadDeferred(loader, loader->eventRanges[index], [&](WfReader& reader) { reader << value; });
+				}
+				return value;
+			}
+
 			template<>
 			struct Serialization<Value>
 			{
@@ -1253,7 +1569,7 @@ Serizliation (Metadata)
 									vint propName = 0;
 									Value propValue;
 									reader << propName << propValue;
-									reader.context->piIndex[propName]->SetValue(value, propValue);
+									reader.context->GetProperty(propName)->SetValue(value, propValue);
 								}
 							}
 							break;
@@ -1843,9 +2159,9 @@ Serialization (Instruction)
 					reader << value.code;
 #define IO(X)								do{ reader << (X); }while(0)
 #define TD(X)								do{ vint index = -1; reader << index; X = reader.context->tdIndex[index]; }while(0)
-#define MI(X)								do{ vint index = -1; reader << index; X = reader.context->miIndex[index]; }while(0)
-#define PI(X)								do{ vint index = -1; reader << index; X = reader.context->piIndex[index]; }while(0)
-#define EI(X)								do{ vint index = -1; reader << index; X = reader.context->eiIndex[index]; }while(0)
+#define MI(X)								do{ vint index = -1; reader << index; X = reader.context->GetMethod(index); }while(0)
+#define PI(X)								do{ vint index = -1; reader << index; X = reader.context->GetProperty(index); }while(0)
+#define EI(X)								do{ vint index = -1; reader << index; X = reader.context->GetEvent(index); }while(0)
 #define STREAMIO(NAME)						case WfInsCode::NAME: break;
 #define STREAMIO_VALUE(NAME)				case WfInsCode::NAME: IO(value.valueParameter); break;
 #define STREAMIO_FUNCTION(NAME)				case WfInsCode::NAME: IO(value.indexParameter); break;
@@ -2045,11 +2361,8 @@ Serialization (Assembly)
 
 				//----------------------------------------------------
 
-				static void IOPrepare(WfReader& reader, WfAssembly& value)
+				static void IOTypes(WfReader& reader, WfAssembly& value, bool hasTypeImpl, vint& miCount, vint& piCount, vint& eiCount)
 				{
-					reader.context = new WfReaderContext;
-					bool hasTypeImpl = false;
-					reader << hasTypeImpl;
 					if (hasTypeImpl)
 					{
 						value.typeImpl = new WfTypeImpl;
@@ -2060,9 +2373,6 @@ Serialization (Assembly)
 					}
 
 					vint tdCount = -1;
-					vint miCount = -1;
-					vint piCount = -1;
-					vint eiCount = -1;
 					reader << tdCount << miCount << piCount << eiCount;
 					for (vint i = 0; i < tdCount; i++)
 					{
@@ -2077,29 +2387,222 @@ Serialization (Assembly)
 						GetGlobalTypeManager()->AddTypeLoader(value.typeImpl);
 					}
 
+					reader.context->miIndex.Resize(miCount);
+					reader.context->piIndex.Resize(piCount);
+					reader.context->eiIndex.Resize(eiCount);
 					for (vint i = 0; i < miCount; i++)
 					{
-						IMethodInfo* mi = nullptr;
-						reader << mi;
-						reader.context->miIndex.Add(i, mi);
+						reader.context->miIndex[i] = nullptr;
 					}
 					for (vint i = 0; i < piCount; i++)
 					{
-						IPropertyInfo* pi = nullptr;
-						reader << pi;
-						reader.context->piIndex.Add(i, pi);
+						reader.context->piIndex[i] = nullptr;
 					}
 					for (vint i = 0; i < eiCount; i++)
 					{
-						IEventInfo* ei = nullptr;
-						reader << ei;
-						reader.context->eiIndex.Add(i, ei);
+						reader.context->eiIndex[i] = nullptr;
 					}
 				}
 
-				static void IOPrepare(WfWriter& writer, WfAssembly& value)
+				static void IOLegacy(WfReader& reader, WfAssembly& value, bool hasTypeImpl)
+				{
+					vint miCount = -1;
+					vint piCount = -1;
+					vint eiCount = -1;
+					IOTypes(reader, value, hasTypeImpl, miCount, piCount, eiCount);
+
+					for (vint i = 0; i < miCount; i++)
+					{
+						reader << reader.context->miIndex[i];
+					}
+					for (vint i = 0; i < piCount; i++)
+					{
+						reader << reader.context->piIndex[i];
+					}
+					for (vint i = 0; i < eiCount; i++)
+					{
+						reader << reader.context->eiIndex[i];
+					}
+
+					reader
+						<< value.insBeforeCodegen
+						<< value.insAfterCodegen
+						<< value.variableNames
+						<< value.functionByName
+						<< value.functions
+						<< value.instructions
+						;
+				}
+
+				static void IODeferred(WfReader& reader, WfAssembly& value, bool hasTypeImpl, Ptr<WfAssemblyLoader>& loader)
+				{
+					loader = new WfAssemblyLoader;
+					loader->context = reader.context;
+					reader.context->loader = loader.Obj();
+
+					vint miCount = -1;
+					vint piCount = -1;
+					vint eiCount = -1;
+					IOTypes(reader, value, hasTypeImpl, miCount, piCount, eiCount);
+					loader->typeImpl = value.typeImpl;
+					loader->typesRegistered = hasTypeImpl;
+
+					loader->methodRanges.Resize(miCount);
+					loader->propertyRanges.Resize(piCount);
+					loader->eventRanges.Resize(eiCount);
+					for (vint i = 0; i < miCount; i++)
+					{
+						reader << loader->methodRanges[i];
+					}
+					for (vint i = 0; i < piCount; i++)
+					{
+						reader << loader->propertyRanges[i];
+					}
+					for (vint i = 0; i < eiCount; i++)
+					{
+						reader << loader->eventRanges[i];
+					}
+
+					reader
+						<< value.variableNames
+						<< value.functionByName
+						<< value.functions
+						;
+
+					vint instructionCount = 0;
+					reader << instructionCount;
+					for (vint i = 0; i < instructionCount; i++)
+					{
+						value.instructions.Add(WfInstruction());
+					}
+
+					vint chunkCount = 0;
+					reader << chunkCount;
+					loader->chunks.Resize(chunkCount);
+					for (vint i = 0; i < chunkCount; i++)
+					{
+						auto& chunk = loader->chunks[i];
+						reader << chunk.firstInstruction << chunk.lastInstruction << chunk.range;
+					}
+					reader
+						<< loader->functionChunks
+						<< loader->insBeforeCodegen
+						<< loader->insAfterCodegen
+						;
+
+					vint32_t dataCount = 0;
+					if (reader.input.Read(&dataCount, sizeof(dataCount)) != sizeof(dataCount))
+					{
+						CHECK_FAIL(L"Deserialization failed.");
+					}
+					loader->data.Resize(dataCount);
+					if (dataCount > 0 && reader.input.Read(&loader->data[0], dataCount) != dataCount)
+					{
+						CHECK_FAIL(L"Deserialization failed.");
+					}
+
+					// instructions that do not belong to any function are loaded immediately
+					vint looseCount = 0;
+					reader << looseCount;
+					for (vint i = 0; i < looseCount; i++)
+					{
+						vint index = -1;
+						reader << index;
+						reader << value.instructions[index];
+					}
+				}
+
+				static void IO(WfReader& reader, WfAssembly& value, Ptr<WfAssemblyLoader>& loader)
+				{
+					reader.context = new WfReaderContext;
+
+					vint8_t formatTag = 0;
+					if (reader.input.Read(&formatTag, sizeof(formatTag)) != sizeof(formatTag))
+					{
+						CHECK_FAIL(L"Deserialization failed.");
+					}
+
+					if (formatTag == WfAssemblyFormatTag)
+					{
+						vint version = -1;
+						bool hasTypeImpl = false;
+						reader << version << hasTypeImpl;
+						CHECK_ERROR(version == WfAssemblyFormatVersion, L"Unsupported assembly format version.");
+						IODeferred(reader, value, hasTypeImpl, loader);
+					}
+					else
+					{
+						IOLegacy(reader, value, formatTag == -1);
+					}
+
+					if (value.typeImpl)
+					{
+						GetGlobalTypeManager()->RemoveTypeLoader(value.typeImpl);
+					}
+					if (loader)
+					{
+						loader->typesRegistered = false;
+					}
+				}
+
+				//----------------------------------------------------
+
+				static void IOChunks(WfAssembly& value, List<WfAssemblyChunk>& chunks, Array<vint>& functionChunks, List<vint>& looseInstructions)
+				{
+					// functions may overlap, overlapped functions share the same chunk
+					vint instructionCount = value.instructions.Count();
+					Array<vint> lastInstructions(instructionCount);
+					for (vint i = 0; i < instructionCount; i++)
+					{
+						lastInstructions[i] = -1;
+					}
+					FOREACH(Ptr<WfAssemblyFunction>, function, value.functions)
+					{
+						if (0 <= function->firstInstruction && function->firstInstruction <= function->lastInstruction && function->lastInstruction < instructionCount)
+						{
+							auto& last = lastInstructions[function->firstInstruction];
+							if (last < function->lastInstruction)
+							{
+								last = function->lastInstruction;
+							}
+						}
+					}
+
+					Array<vint> instructionChunks(instructionCount);
+					for (vint i = 0; i < instructionCount; i++)
+					{
+						if (lastInstructions[i] == -1)
+						{
+							instructionChunks[i] = -1;
+							looseInstructions.Add(i);
+							continue;
+						}
+
+						WfAssemblyChunk chunk;
+						chunk.firstInstruction = i;
+						chunk.lastInstruction = lastInstructions[i];
+						for (vint j = i; j <= chunk.lastInstruction; j++)
+						{
+							if (chunk.lastInstruction < lastInstructions[j])
+							{
+								chunk.lastInstruction = lastInstructions[j];
+							}
+							instructionChunks[j] = chunks.Count();
+						}
+						chunks.Add(chunk);
+						i = chunk.lastInstruction;
+					}
+
+					functionChunks.Resize(value.functions.Count());
+					for (vint i = 0; i < value.functions.Count(); i++)
+					{
+						vint first = value.functions[i]->firstInstruction;
+						functionChunks[i] = 0 <= first && first < instructionCount ? instructionChunks[first] : -1;
+					}
+				}
+
+				static void IOPrepare(WfWriter& writer, WfAssembly& value, WfWriterContextPrepare& prepare)
 				{
-					writer.context = new WfWriterContext;
 					bool hasTypeImpl = value.typeImpl != nullptr;
 					writer << hasTypeImpl;
 					if (hasTypeImpl)
@@ -2110,7 +2613,6 @@ Serialization (Assembly)
 						IOCustomTypeList(writer, value.typeImpl->enums);
 					}
 
-					WfWriterContextPrepare prepare;
 					if (hasTypeImpl)
 					{
 						CollectMetadata(value.typeImpl.Obj(), prepare);
@@ -2140,7 +2642,14 @@ Serialization (Assembly)
 						Serialization<WfTypeImpl>::IO(writer, *value.typeImpl.Obj());
 						GetGlobalTypeManager()->AddTypeLoader(value.typeImpl);
 					}
+				}
+
+				static void IOLegacy(WfWriter& writer, WfAssembly& value)
+				{
+					writer.context = new WfWriterContext;
 
+					WfWriterContextPrepare prepare;
+					IOPrepare(writer, value, prepare);
 					FOREACH(IMethodInfo*, mi, prepare.mis)
 					{
 						writer << mi;
@@ -2153,26 +2662,107 @@ Serialization (Assembly)
 					{
 						writer << ei;
 					}
-				}
-
-				//----------------------------------------------------
 
-				template<typename TIO>
-				static void IO(TIO& io, WfAssembly& value)
-				{
-					IOPrepare(io, value);
-					io	<< value.insBeforeCodegen
+					writer
+						<< value.insBeforeCodegen
 						<< value.insAfterCodegen
 						<< value.variableNames
 						<< value.functionByName
 						<< value.functions
 						<< value.instructions
 						;
+
 					if (value.typeImpl)
 					{
 						GetGlobalTypeManager()->RemoveTypeLoader(value.typeImpl);
 					}
 				}
+
+				static void IO(WfWriter& writer, WfAssembly& value)
+				{
+					writer.context = new WfWriterContext;
+
+					vint8_t formatTag = WfAssemblyFormatTag;
+					if (writer.output.Write(&formatTag, sizeof(formatTag)) != sizeof(formatTag))
+					{
+						CHECK_FAIL(L"Serialization failed.");
+					}
+					vint version = WfAssemblyFormatVersion;
+					writer << version;
+
+					MemoryStream deferredStream;
+					WfWriter deferredWriter(deferredStream);
+					deferredWriter.context = writer.context;
+
+					bool hasTypeImpl = value.typeImpl != nullptr;
+					WfWriterContextPrepare prepare;
+					IOPrepare(writer, value, prepare);
+
+					// metadata, instructions and debug informations are written to deferredStream, they are loaded on demand
+					FOREACH(IMethodInfo*, mi, prepare.mis)
+					{
+						auto range = WriteDeferred(deferredWriter, deferredStream, [&](WfWriter& deferred) { deferred << mi; });
+						writer << range;
+					}
+					FOREACH(IPropertyInfo*, pi, prepare.pis)
+					{
+						auto range = WriteDeferred(deferredWriter, deferredStream, [&](WfWriter& deferred) { deferred << pi; });
+						writer << range;
+					}
+					FOREACH(IEventInfo*, ei, prepare.eis)
+					{
+						auto range = WriteDeferred(deferredWriter, deferredStream, [&](WfWriter& deferred) { deferred << ei; });
+						writer << range;
+					}
+
+					writer
+						<< value.variableNames
+						<< value.functionByName
+						<< value.functions
+						;
+
+					List<WfAssemblyChunk> chunks;
+					Array<vint> functionChunks;
+					List<vint> looseInstructions;
+					IOChunks(value, chunks, functionChunks, looseInstructions);
+
+					vint instructionCount = value.instructions.Count();
+					vint chunkCount = chunks.Count();
+					writer << instructionCount << chunkCount;
+					for (vint i = 0; i < chunkCount; i++)
+					{
+						auto& chunk = chunks[i];
+						chunk.range = WriteDeferred(deferredWriter, deferredStream, [&](WfWriter& deferred)
+						{
+							for (vint j = chunk.firstInstruction; j <= chunk.lastInstruction; j++)
+							{
+								deferred << value.instructions[j];
+							}
+						});
+						writer << chunk.firstInstruction << chunk.lastInstruction << chunk.range;
+					}
+
+					auto insBeforeCodegen = WriteDeferred(deferredWriter, deferredStream, [&](WfWriter& deferred) { deferred << value.insBeforeCodegen; });
+					auto insAfterCodegen = WriteDeferred(deferredWriter, deferredStream, [&](WfWriter& deferred) { deferred << value.insAfterCodegen; });
+					writer
+						<< functionChunks
+						<< insBeforeCodegen
+						<< insAfterCodegen
+						<< (IStream&)deferredStream
+						;
+
+					vint looseCount = looseInstructions.Count();
+					writer << looseCount;
+					FOREACH(vint, index, looseInstructions)
+					{
+						writer << index << value.instructions[index];
+					}
+
+					if (hasTypeImpl)
+					{
+						GetGlobalTypeManager()->RemoveTypeLoader(value.typeImpl);
+					}
+				}
 			};
 		}
 	}
@@ -2209,20 +2799,103 @@ WfAssembly
 			WfAssembly::WfAssembly(stream::IStream& input)
 			{
 				stream::internal::WfReader reader(input);
-				stream::internal::Serialization<WfAssembly>::IO(reader, *this);
+				stream::internal::Serialization<WfAssembly>::IO(reader, *this, loader);
 				Initialize();
 			}
 
 			void WfAssembly::Initialize()
 			{
-				insBeforeCodegen->Initialize();
-				insAfterCodegen->Initialize();
+				if (insBeforeCodegen) insBeforeCodegen->Initialize();
+				if (insAfterCodegen) insAfterCodegen->Initialize();
+			}
+
+			void WfAssembly::LoadFunctionInstructions(vint functionIndex)
+			{
+				if (!loader) return;
+				vint chunkIndex = loader->functionChunks[functionIndex];
+				if (chunkIndex == -1) return;
+
+				auto& chunk = loader->chunks[chunkIndex];
+				if (*(volatile vint*)&chunk.loaded == 0)
+				{
+					CS_LOCK(loader->lock)
+					{
+						if (chunk.loaded == 0)
+						{
+							stream::internal::ReadDeferred(loader.Obj(), chunk.range, [&](stream::internal::WfReader& reader)
+							{
+								for (vint i = chunk.firstInstruction; i <= chunk.lastInstruction; i++)
+								{
+									reader << instructions[i];
+								}
+							});
+							INCRC(&chunk.loaded);
+						}
+					}
+				}
+			}
+
+			Ptr<WfInstructionDebugInfo> WfAssembly::GetInsBeforeCodegen()
+			{
+				if (loader && *(volatile vint*)&loader->insBeforeCodegenLoaded == 0)
+				{
+					CS_LOCK(loader->lock)
+					{
+						if (loader->insBeforeCodegenLoaded == 0)
+						{
+							Ptr<WfInstructionDebugInfo> debugInfo;
+							stream::internal::ReadDeferred(loader.Obj(), loader->insBeforeCodegen, [&](stream::internal::WfReader& reader) { reader << debugInfo; });
+							debugInfo->Initialize();
+							insBeforeCodegen = debugInfo;
+							INCRC(&loader->insBeforeCodegenLoaded);
+						}
+					}
+				}
+				return insBeforeCodegen;
+			}
+
+			Ptr<WfInstructionDebugInfo> WfAssembly::GetInsAfterCodegen()
+			{
+				if (loader && *(volatile vint*)&loader->insAfterCodegenLoaded == 0)
+				{
+					CS_LOCK(loader->lock)
+					{
+						if (loader->insAfterCodegenLoaded == 0)
+						{
+							Ptr<WfInstructionDebugInfo> debugInfo;
+							stream::internal::ReadDeferred(loader.Obj(), loader->insAfterCodegen, [&](stream::internal::WfReader& reader) { reader << debugInfo; });
+							debugInfo->Initialize();
+							insAfterCodegen = debugInfo;
+							INCRC(&loader->insAfterCodegenLoaded);
+						}
+					}
+				}
+				return insAfterCodegen;
 			}
 
-			void WfAssembly::Serialize(stream::IStream& output)
+			void WfAssembly::LoadAll()
 			{
+				if (!loader) return;
+				for (vint i = 0; i < functions.Count(); i++)
+				{
+					LoadFunctionInstructions(i);
+				}
+				GetInsBeforeCodegen();
+				GetInsAfterCodegen();
+			}
+
+			void WfAssembly::Serialize(stream::IStream& output, bool loadOnDemand)
+			{
+				LoadAll();
 				stream::internal::WfWriter writer(output);
-				stream::internal::Serialization<WfAssembly>::IO(writer, *this);
+				if (loadOnDemand)
+				{
+					stream::internal::Serialization<WfAssembly>::IO(writer, *this);
+				}
+				else
+				{
+					stream::internal::Serialization<WfAssembly>::IOLegacy(writer, *this);
+				}
 			}
 		}
 	}
@@ -2431,7 +3104,7 @@ InstructionLocation
 				if (assembly != il.assembly) return true;
 				if (stackFrameIndex != il.stackFrameIndex) return stackFrameIndex > il.stackFrameIndex;
 
-				auto debugInfo = (beforeCodegen ? assembly->insBeforeCodegen : assembly->insAfterCodegen);
+				auto debugInfo = (beforeCodegen ? assembly->GetInsBeforeCodegen() : assembly->GetInsAfterCodegen());
 				auto& range1 = debugInfo->instructionCodeMapping[instruction];
 				auto& range2 = debugInfo->instructionCodeMapping[il.instruction];
 
@@ -2447,7 +3120,7 @@ InstructionLocation
 				if (assembly != il.assembly) return true;
 				if (stackFrameIndex != il.stackFrameIndex) return true;
 
-				auto debugInfo = (beforeCodegen ? assembly->insBeforeCodegen : assembly->insAfterCodegen);
+				auto debugInfo = (beforeCodegen ? assembly->GetInsBeforeCodegen() : assembly->GetInsAfterCodegen());
 				auto& range1 = debugInfo->instructionCodeMapping[instruction];
 				auto& range2 = debugInfo->instructionCodeMapping[il.instruction];
 
@@ -2829,7 +3502,7 @@ WfDebugger
 
 			vint WfDebugger::AddCodeLineBreakPoint(WfAssembly* assembly, vint codeIndex, vint row, bool beforeCodegen)
 			{
-				auto& codeInsMap = (beforeCodegen ? assembly->insBeforeCodegen : assembly->insAfterCodegen)->codeInstructionMapping;
+				auto& codeInsMap = (beforeCodegen ? assembly->GetInsBeforeCodegen() : assembly->GetInsAfterCodegen())->codeInstructionMapping;
 				Tuple<vint, vint> key(codeIndex, row);
 				vint index = codeInsMap.Keys().IndexOf(key);
 				if (index == -1)
@@ -2999,7 +3672,7 @@ WfDebugger
 
 				auto& stackFrame = context->stackFrames[callStackIndex];
 				auto ins = stackFrame.nextInstructionIndex;
-				auto debugInfo = (beforeCodegen ? context->globalContext->assembly->insBeforeCodegen : context->globalContext->assembly->insAfterCodegen);
+				auto debugInfo = (beforeCodegen ? context->globalContext->assembly->GetInsBeforeCodegen() : context->globalContext->assembly->GetInsAfterCodegen());
 				return debugInfo->instructionCodeMapping[ins];
 			}
 
@@ -3020,13 +3693,13 @@ WfDebugger
 				vint index = function->argumentNames.IndexOf(name);
 				if (index != -1)
 				{
-					return context->stack[stackFrame.stackBase + index];
+					return context->stack[stackFrame.stackBase + index].GetValue();
 				}
 
 				index = function->localVariableNames.IndexOf(name);
 				if (index != -1)
 				{
-					return context->stack[stackFrame.stackBase + function->argumentNames.Count() + index];
+					return context->stack[stackFrame.stackBase + function->argumentNames.Count() + index].GetValue();
 				}
 
 				index = function->capturedVariableNames.IndexOf(name);
@@ -3108,14 +3781,75 @@ WfRuntimeThreadContext (Operators)
 
 			//-------------------------------------------------------------------------------
 
+			template<typename T>
+			T UnboxStackValue(const WfRuntimeStackValue& value)
+			{
+				if (value.type == WfInsType::Unknown)
+				{
+					return UnboxValue<T>(value.boxedValue);
+				}
+				else
+				{
+					return UnboxValue<T>(value.GetValue());
+				}
+			}
+
+			template<typename T>
+			struct WfStackValueAccessor
+			{
+				static T Get(const WfRuntimeStackValue& value)
+				{
+					return UnboxStackValue<T>(value);
+				}
+
+				static WfRuntimeStackValue Create(const T& value)
+				{
+					return WfRuntimeStackValue(BoxValue(value));
+				}
+			};
+
+#define STACK_VALUE_ACCESSOR(TYPE, INSTYPE, FIELD)\
+			template<>\
+			struct WfStackValueAccessor<TYPE>\
+			{\
+				static TYPE Get(const WfRuntimeStackValue& value)\
+				{\
+					if (value.type == WfInsType::INSTYPE) return (TYPE)value.FIELD;\
+					return UnboxStackValue<TYPE>(value);\
+				}\
+				static WfRuntimeStackValue Create(TYPE value)\
+				{\
+					WfRuntimeStackValue result;\
+					result.type = WfInsType::INSTYPE;\
+					result.FIELD = value;\
+					return result;\
+				}\
+			};\
+
+			STACK_VALUE_ACCESSOR(bool,		Bool,	boolValue)
+			STACK_VALUE_ACCESSOR(vint8_t,	I1,		intValue)
+			STACK_VALUE_ACCESSOR(vint16_t,	I2,		intValue)
+			STACK_VALUE_ACCESSOR(vint32_t,	I4,		intValue)
+			STACK_VALUE_ACCESSOR(vint64_t,	I8,		intValue)
+			STACK_VALUE_ACCESSOR(vuint8_t,	U1,		uintValue)
+			STACK_VALUE_ACCESSOR(vuint16_t,	U2,		uintValue)
+			STACK_VALUE_ACCESSOR(vuint32_t,	U4,		uintValue)
+			STACK_VALUE_ACCESSOR(vuint64_t,	U8,		uintValue)
+			STACK_VALUE_ACCESSOR(float,		F4,		floatValue)
+			STACK_VALUE_ACCESSOR(double,	F8,		floatValue)
+
+#undef STACK_VALUE_ACCESSOR
+
+			//-------------------------------------------------------------------------------
+
 #define UNARY_OPERATOR(NAME, OPERATOR)\
 			template<typename T>\
 			WfRuntimeExecutionAction OPERATOR_##NAME(WfRuntimeThreadContext& context)\
 			{\
-				Value operand;\
-				CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");\
-				T value = OPERATOR UnboxValue<T>(operand);\
-				CONTEXT_ACTION(PushValue(BoxValue(value)), L"failed to push a value to the stack.");\
+				WfRuntimeStackValue operand;\
+				CONTEXT_ACTION(PopStackValue(operand), L"failed to pop a value from the stack.");\
+				T value = OPERATOR WfStackValueAccessor<T>::Get(operand);\
+				CONTEXT_ACTION(PushStackValue(WfStackValueAccessor<T>::Create(value)), L"failed to push a value to the stack.");\
 				return WfRuntimeExecutionAction::ExecuteInstruction;\
 			}\
 
@@ -3123,11 +3857,11 @@ WfRuntimeThreadContext (Operators)
 			template<typename T>\
 			WfRuntimeExecutionAction OPERATOR_##NAME(WfRuntimeThreadContext& context)\
 			{\
-				Value first, second;\
-				CONTEXT_ACTION(PopValue(second), L"failed to pop a value from the stack.");\
-				CONTEXT_ACTION(PopValue(first), L"failed to pop a value from the stack.");\
-				T value = UnboxValue<T>(first) OPERATOR UnboxValue<T>(second);\
-				CONTEXT_ACTION(PushValue(BoxValue(value)), L"failed to push a value to the stack.");\
+				WfRuntimeStackValue first, second;\
+				CONTEXT_ACTION(PopStackValue(second), L"failed to pop a value from the stack.");\
+				CONTEXT_ACTION(PopStackValue(first), L"failed to pop a value from the stack.");\
+				T value = WfStackValueAccessor<T>::Get(first) OPERATOR WfStackValueAccessor<T>::Get(second);\
+				CONTEXT_ACTION(PushStackValue(WfStackValueAccessor<T>::Create(value)), L"failed to push a value to the stack.");\
 				return WfRuntimeExecutionAction::ExecuteInstruction;\
 			}\
 
@@ -3154,60 +3888,48 @@ WfRuntimeThreadContext (Operators)
 			template<typename T>
 			WfRuntimeExecutionAction OPERATOR_OpExp(WfRuntimeThreadContext& context)
 			{
-				Value first, second;
-				CONTEXT_ACTION(PopValue(second), L"failed to pop a value from the stack.");
-				CONTEXT_ACTION(PopValue(first), L"failed to pop a value from the stack.");
-				T firstValue = UnboxValue<T>(first);
-				T secondValue = UnboxValue<T>(second);
+				WfRuntimeStackValue first, second;
+				CONTEXT_ACTION(PopStackValue(second), L"failed to pop a value from the stack.");
+				CONTEXT_ACTION(PopStackValue(first), L"failed to pop a value from the stack.");
+				T firstValue = WfStackValueAccessor<T>::Get(first);
+				T secondValue = WfStackValueAccessor<T>::Get(second);
 				T value = (T)exp(secondValue * log(firstValue));
-				CONTEXT_ACTION(PushValue(BoxValue(value)), L"failed to push a value to the stack.");
+				CONTEXT_ACTION(PushStackValue(WfStackValueAccessor<T>::Create(value)), L"failed to push a value to the stack.");
 				return WfRuntimeExecutionAction::ExecuteInstruction;
 			}
 			
 			template<typename T>
 			WfRuntimeExecutionAction OPERATOR_OpCompare(WfRuntimeThreadContext& context)
 			{
-				Value first, second;
-				CONTEXT_ACTION(PopValue(second), L"failed to pop a value from the stack.");
-				CONTEXT_ACTION(PopValue(first), L"failed to pop a value from the stack.");
+				WfRuntimeStackValue first, second;
+				CONTEXT_ACTION(PopStackValue(second), L"failed to pop a value from the stack.");
+				CONTEXT_ACTION(PopStackValue(first), L"failed to pop a value from the stack.");
 
-				bool firstNull = first.GetValueType() == Value::Null;
-				bool secondNull = second.GetValueType() == Value::Null;
+				vint result = 0;
+				bool firstNull = first.IsNull();
+				bool secondNull = second.IsNull();
 				if (firstNull)
 				{
-					if (secondNull)
-					{
-						CONTEXT_ACTION(PushValue(BoxValue((vint)0)), L"failed to push a value to the stack.");
-					}
-					else
-					{
-						CONTEXT_ACTION(PushValue(BoxValue((vint)-1)), L"failed to push a value to the stack.");
-					}
+					result = secondNull ? 0 : -1;
+				}
+				else if (secondNull)
+				{
+					result = 1;
 				}
 				else
 				{
-					if (secondNull)
+					T firstValue = WfStackValueAccessor<T>::Get(first);
+					T secondValue = WfStackValueAccessor<T>::Get(second);
+					if (firstValue < secondValue)
 					{
-						CONTEXT_ACTION(PushValue(BoxValue((vint)1)), L"failed to push a value to the stack.");
+						result = -1;
 					}
-					else
+					else if (firstValue > secondValue)
 					{
-						T firstValue = UnboxValue<T>(first);
-						T secondValue = UnboxValue<T>(second);
-						if (firstValue < secondValue)
-						{
-							CONTEXT_ACTION(PushValue(BoxValue((vint)-1)), L"failed to push a value to the stack.");
-						}
-						else if (firstValue > secondValue)
-						{
-							CONTEXT_ACTION(PushValue(BoxValue((vint)1)), L"failed to push a value to the stack.");
-						}
-						else
-						{
-							CONTEXT_ACTION(PushValue(BoxValue((vint)0)), L"failed to push a value to the stack.");
-						}
+						result = 1;
 					}
 				}
+				CONTEXT_ACTION(PushStackValue(WfStackValueAccessor<vint>::Create(result)), L"failed to push a value to the stack.");
 				return WfRuntimeExecutionAction::ExecuteInstruction;
 			}
 			
@@ -3326,11 +4048,11 @@ WfRuntimeThreadContext (Range)
 			template<typename T>
 			WfRuntimeExecutionAction OPERATOR_OpCreateRange(WfRuntimeThreadContext& context)
 			{
-				Value first, second;
-				CONTEXT_ACTION(PopValue(second), L"failed to pop a value from the stack.");
-				CONTEXT_ACTION(PopValue(first), L"failed to pop a value from the stack.");
-				T firstValue = UnboxValue<T>(first);
-				T secondValue = UnboxValue<T>(second);
+				WfRuntimeStackValue first, second;
+				CONTEXT_ACTION(PopStackValue(second), L"failed to pop a value from the stack.");
+				CONTEXT_ACTION(PopStackValue(first), L"failed to pop a value from the stack.");
+				T firstValue = WfStackValueAccessor<T>::Get(first);
+				T secondValue = WfStackValueAccessor<T>::Get(second);
 				auto enumerable = MakePtr<WfRuntimeRange<T>>(firstValue, secondValue);
 				CONTEXT_ACTION(PushValue(Value::From(enumerable)), L"failed to push a value to the stack.");
 				return WfRuntimeExecutionAction::ExecuteInstruction;
@@ -3402,7 +4124,50 @@ WfRuntimeThreadContext
 #define BEGIN_TYPE								switch(ins.typeParameter) {
 #define END_TYPE								default: INTERNAL_ERROR(L"unexpected type argument."); }
 
-			WfRuntimeExecutionAction WfRuntimeThreadContext::ExecuteInternal(WfInstruction& ins, WfRuntimeStackFrame& stackFrame, IWfDebuggerCallback* callback)
+			Value WfRuntimeThreadContext::InvokeNativeMethod(WfInstructionCache& cache, IMethodInfo* method, const Value& thisValue, collections::Array<Value>& arguments)
+			{
+				if (cache.kind == WfInstructionCacheKind::NativeMethod)
+				{
+					switch (thisValue.GetValueType())
+					{
+					case Value::Null:
+						if (cache.nativeMethod->IsStatic())
+						{
+							return cache.nativeMethod->InvokeWithCheckedThisObject(thisValue, arguments);
+						}
+						break;
+					case Value::RawPtr:
+					case Value::SharedPtr:
+						{
+							// instructions could be executed in multiple threads, the receiver type is written only once by a compare-and-swap
+							// a thread reads either null or the published type, other receiver types are always checked
+							auto receiverType = thisValue.GetTypeDescriptor();
+							auto cachedReceiverType = *(ITypeDescriptor* volatile*)&cache.receiverType;
+							if (receiverType && receiverType == cachedReceiverType)
+							{
+								return cache.nativeMethod->InvokeWithCheckedThisObject(thisValue, arguments);
+							}
+							else if (receiverType && receiverType->CanConvertTo(cache.nativeMethod->GetOwnerTypeDescriptor()))
+							{
+								if (!cachedReceiverType)
+								{
+#if defined VCZH_MSVC
+									_InterlockedCompareExchangePointer((void* volatile*)&cache.receiverType, receiverType, nullptr);
+#elif defined VCZH_GCC
+									__sync_bool_compare_and_swap(&cache.receiverType, (ITypeDescriptor*)nullptr, receiverType);
+#endif
+								}
+								return cache.nativeMethod->InvokeWithCheckedThisObject(thisValue, arguments);
+							}
+						}
+						break;
+					default:;
+					}
+				}
+				return method->Invoke(thisValue, arguments);
+			}
+
+			WfRuntimeExecutionAction WfRuntimeThreadContext::ExecuteInternal(WfInstruction& ins, WfInstructionCache& cache, WfRuntimeStackFrame& stackFrame, IWfDebuggerCallback* callback)
 			{
 				switch (ins.code)
 				{
@@ -3421,9 +4186,9 @@ WfRuntimeThreadContext
 					}
 				case WfInsCode::LoadLocalVar:
 					{
-						Value operand;
-						CONTEXT_ACTION(LoadLocalVariable(ins.indexParameter, operand), L"illegal local variable index.");
-						CONTEXT_ACTION(PushValue(operand), L"failed to push a value to the stack.");
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(LoadLocalStackValue(ins.indexParameter, operand), L"illegal local variable index.");
+						CONTEXT_ACTION(PushStackValue(operand), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 				case WfInsCode::LoadCapturedVar:
@@ -3462,9 +4227,9 @@ WfRuntimeThreadContext
 					}
 				case WfInsCode::StoreLocalVar:
 					{
-						Value operand;
-						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
-						CONTEXT_ACTION(StoreLocalVariable(ins.indexParameter, operand), L"illegal local variable index.");
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(PopStackValue(operand), L"failed to pop a value from the stack.");
+						CONTEXT_ACTION(StoreLocalStackValue(ins.indexParameter, operand), L"illegal local variable index.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 				case WfInsCode::StoreCapturedVar:
@@ -3492,16 +4257,16 @@ WfRuntimeThreadContext
 					}
 				case WfInsCode::Pop:
 					{
-						Value operand;
-						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(PopStackValue(operand), L"failed to pop a value from the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 				case WfInsCode::Return:
 					{
-						Value operand;
-						CONTEXT_ACTION(PopValue(operand), L"failed to pop the function result.");
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(PopStackValue(operand), L"failed to pop the function result.");
 						CONTEXT_ACTION(PopStackFrame(), L"failed to pop the stack frame.");
-						CONTEXT_ACTION(PushValue(operand), L"failed to push a value to the stack.");
+						CONTEXT_ACTION(PushStackValue(operand), L"failed to push a value to the stack.");
 						if (stackFrames.Count() == 0)
 						{
 							status = WfRuntimeExecutionStatus::Finished;
@@ -3704,9 +4469,9 @@ WfRuntimeThreadContext
 					}
 				case WfInsCode::JumpIf:
 					{
-						Value operand;
-						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
-						if (UnboxValue<bool>(operand))
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(PopStackValue(operand), L"failed to pop a value from the stack.");
+						if (WfStackValueAccessor<bool>::Get(operand))
 						{
 							stackFrame.nextInstructionIndex = ins.indexParameter;
 						}
@@ -3727,6 +4492,28 @@ WfRuntimeThreadContext
 						Value operand;
 						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
 						CALL_DEBUGGER(callback->BreakGet(operand.GetRawPtr(), ins.propertyParameter));
+						switch (cache.kind)
+						{
+						case WfInstructionCacheKind::ScriptMethod:
+							if (!operand.IsNull())
+							{
+								auto capturedVariable = MakePtr<WfRuntimeVariableContext>();
+								capturedVariable->variables.Resize(1);
+								capturedVariable->variables[0] = Value::From(operand.GetRawPtr());
+
+								CONTEXT_ACTION(PushStackFrame(cache.functionIndex, 0, capturedVariable), L"failed to invoke a function.");
+								return WfRuntimeExecutionAction::EnterStackFrame;
+							}
+							break;
+						case WfInstructionCacheKind::NativeMethod:
+							{
+								Array<Value> arguments;
+								Value result = InvokeNativeMethod(cache, ins.propertyParameter->GetGetter(), operand, arguments);
+								CONTEXT_ACTION(PushValue(result), L"failed to push a value to the stack.");
+								return WfRuntimeExecutionAction::ExecuteInstruction;
+							}
+						default:;
+						}
 						Value result = ins.propertyParameter->GetValue(operand);
 						CONTEXT_ACTION(PushValue(result), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
@@ -3737,7 +4524,16 @@ WfRuntimeThreadContext
 						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
 						CONTEXT_ACTION(PopValue(value), L"failed to pop a value from the stack.");
 						CALL_DEBUGGER(callback->BreakSet(operand.GetRawPtr(), ins.propertyParameter));
-						ins.propertyParameter->SetValue(operand, value);
+						if (cache.kind == WfInstructionCacheKind::NativeMethod)
+						{
+							Array<Value> arguments(1);
+							arguments[0] = value;
+							InvokeNativeMethod(cache, ins.propertyParameter->GetSetter(), operand, arguments);
+						}
+						else
+						{
+							ins.propertyParameter->SetValue(operand, value);
+						}
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 				case WfInsCode::UpdateProperty:
@@ -3746,7 +4542,16 @@ WfRuntimeThreadContext
 						CONTEXT_ACTION(PopValue(value), L"failed to pop a value from the stack.");
 						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
 						CALL_DEBUGGER(callback->BreakSet(operand.GetRawPtr(), ins.propertyParameter));
-						ins.propertyParameter->SetValue(operand, value);
+						if (cache.kind == WfInstructionCacheKind::NativeMethod)
+						{
+							Array<Value> arguments(1);
+							arguments[0] = value;
+							InvokeNativeMethod(cache, ins.propertyParameter->GetSetter(), operand, arguments);
+						}
+						else
+						{
+							ins.propertyParameter->SetValue(operand, value);
+						}
 						CONTEXT_ACTION(PushValue(operand), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
@@ -3789,26 +4594,23 @@ WfRuntimeThreadContext
 						CONTEXT_ACTION(PopValue(thisValue), L"failed to pop a value from the stack.");
 						CALL_DEBUGGER(callback->BreakInvoke(thisValue.GetRawPtr(), ins.methodParameter));
 
-						if (auto staticMethod = dynamic_cast<WfStaticMethod*>(ins.methodParameter))
+						switch (cache.kind)
 						{
-							if (staticMethod->GetGlobalContext() == globalContext.Obj())
+						case WfInstructionCacheKind::ScriptFunction:
 							{
-								CONTEXT_ACTION(PushStackFrame(staticMethod->functionIndex, ins.countParameter, nullptr), L"failed to invoke a function.");
+								CONTEXT_ACTION(PushStackFrame(cache.functionIndex, ins.countParameter, nullptr), L"failed to invoke a function.");
 								return WfRuntimeExecutionAction::EnterStackFrame;
 							}
-						}
-
-						if (auto classMethod = dynamic_cast<WfClassMethod*>(ins.methodParameter))
-						{
-							if (classMethod->GetGlobalContext() == globalContext.Obj())
+						case WfInstructionCacheKind::ScriptMethod:
 							{
 								auto capturedVariable = MakePtr<WfRuntimeVariableContext>();
 								capturedVariable->variables.Resize(1);
 								capturedVariable->variables[0] = Value::From(thisValue.GetRawPtr());
 
-								CONTEXT_ACTION(PushStackFrame(classMethod->functionIndex, ins.countParameter, capturedVariable), L"failed to invoke a function.");
+								CONTEXT_ACTION(PushStackFrame(cache.functionIndex, ins.countParameter, capturedVariable), L"failed to invoke a function.");
 								return WfRuntimeExecutionAction::EnterStackFrame;
 							}
+						default:;
 						}
 
 						Array<Value> arguments(ins.countParameter);
@@ -3819,7 +4621,7 @@ WfRuntimeThreadContext
 							arguments[ins.countParameter - i - 1] = argument;
 						}
 
-						Value result = ins.methodParameter->Invoke(thisValue, arguments);
+						Value result = InvokeNativeMethod(cache, ins.methodParameter, thisValue, arguments);
 						CONTEXT_ACTION(PushValue(result), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
@@ -4172,55 +4974,55 @@ WfRuntimeThreadContext
 					END_TYPE
 				case WfInsCode::OpLT:
 					{
-						Value operand;
-						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
-						vint value = UnboxValue<vint>(operand);
-						CONTEXT_ACTION(PushValue(BoxValue(value < 0)), L"failed to push a value to the stack.");
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(PopStackValue(operand), L"failed to pop a value from the stack.");
+						vint value = WfStackValueAccessor<vint>::Get(operand);
+						CONTEXT_ACTION(PushStackValue(WfStackValueAccessor<bool>::Create(value < 0)), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 					break;
 				case WfInsCode::OpGT:
 					{
-						Value operand;
-						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
-						vint value = UnboxValue<vint>(operand);
-						CONTEXT_ACTION(PushValue(BoxValue(value > 0)), L"failed to push a value to the stack.");
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(PopStackValue(operand), L"failed to pop a value from the stack.");
+						vint value = WfStackValueAccessor<vint>::Get(operand);
+						CONTEXT_ACTION(PushStackValue(WfStackValueAccessor<bool>::Create(value > 0)), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 					break;
 				case WfInsCode::OpLE:
 					{
-						Value operand;
-						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
-						vint value = UnboxValue<vint>(operand);
-						CONTEXT_ACTION(PushValue(BoxValue(value <= 0)), L"failed to push a value to the stack.");
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(PopStackValue(operand), L"failed to pop a value from the stack.");
+						vint value = WfStackValueAccessor<vint>::Get(operand);
+						CONTEXT_ACTION(PushStackValue(WfStackValueAccessor<bool>::Create(value <= 0)), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 					break;
 				case WfInsCode::OpGE:
 					{
-						Value operand;
-						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
-						vint value = UnboxValue<vint>(operand);
-						CONTEXT_ACTION(PushValue(BoxValue(value >= 0)), L"failed to push a value to the stack.");
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(PopStackValue(operand), L"failed to pop a value from the stack.");
+						vint value = WfStackValueAccessor<vint>::Get(operand);
+						CONTEXT_ACTION(PushStackValue(WfStackValueAccessor<bool>::Create(value >= 0)), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 					break;
 				case WfInsCode::OpEQ:
 					{
-						Value operand;
-						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
-						vint value = UnboxValue<vint>(operand);
-						CONTEXT_ACTION(PushValue(BoxValue(value == 0)), L"failed to push a value to the stack.");
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(PopStackValue(operand), L"failed to pop a value from the stack.");
+						vint value = WfStackValueAccessor<vint>::Get(operand);
+						CONTEXT_ACTION(PushStackValue(WfStackValueAccessor<bool>::Create(value == 0)), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 					break;
 				case WfInsCode::OpNE:
 					{
-						Value operand;
-						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
-						vint value = UnboxValue<vint>(operand);
-						CONTEXT_ACTION(PushValue(BoxValue(value != 0)), L"failed to push a value to the stack.");
+						WfRuntimeStackValue operand;
+						CONTEXT_ACTION(PopStackValue(operand), L"failed to pop a value from the stack.");
+						vint value = WfStackValueAccessor<vint>::Get(operand);
+						CONTEXT_ACTION(PushStackValue(WfStackValueAccessor<bool>::Create(value != 0)), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 					break;
@@ -4253,7 +5055,7 @@ WfRuntimeThreadContext
 
 							stackFrame.nextInstructionIndex++;
 							auto& ins = globalContext->assembly->instructions[insIndex];
-							return ExecuteInternal(ins, stackFrame, callback);
+							return ExecuteInternal(ins, globalContext->instructionCaches[insIndex], stackFrame, callback);
 						}
 						break;
 					case WfRuntimeExecutionStatus::RaisedException:
@@ -828,6 +828,8 @@ namespace vl
 Assembly
 ***********************************************************************/
 
+			class WfAssemblyLoader;
+
 			/// <summary>Representing a compiled function.</summary>
 			class WfAssemblyFunction : public Object
 			{
@@ -864,10 +866,13 @@ Assembly
 			/// <summary>Representing a Workflow assembly.</summary>
 			class WfAssembly : public Object, public reflection::Description<WfAssembly>
 			{
+			protected:
+				Ptr<WfAssemblyLoader>								loader;
+
 			public:
-				/// <summary>Debug informations using the module code.</summary>
+				/// <summary>Debug informations using the module code. For a deserialized assembly, it is loaded by <see cref="GetInsBeforeCodegen"/>.</summary>
 				Ptr<WfInstructionDebugInfo>							insBeforeCodegen;
-				/// <summary>Debug informations using the module code from generated syntax trees from the final compiling pass.</summary>
+				/// <summary>Debug informations using the module code from generated syntax trees from the final compiling pass. For a deserialized assembly, it is loaded by <see cref="GetInsAfterCodegen"/>.</summary>
 				Ptr<WfInstructionDebugInfo>							insAfterCodegen;
 				/// <summary>Global variable names. This index is for accessing [F:vl.workflow.runtime.WfRuntimeVariableContext.variables] in [F:vl.workflow.runtime.WfRuntimeCallStackInfo.global] when debugging.</summary>
 				collections::List<WString>							variableNames;
@@ -875,21 +880,33 @@ Assembly
 				collections::Group<WString, vint>					functionByName;
 				/// <summary>Functions.</summary>
 				collections::List<Ptr<WfAssemblyFunction>>			functions;
-				/// <summary>Instructions.</summary>
+				/// <summary>Instructions. For a deserialized assembly, instructions of a function are loaded by <see cref="LoadFunctionInstructions"/>.</summary>
 				collections::List<WfInstruction>					instructions;
 				/// <summary>Custom types.</summary>
 				Ptr<typeimpl::WfTypeImpl>							typeImpl;
 
 				/// <summary>Create an empty assembly.</summary>
 				WfAssembly();
-				/// <summary>Deserialize an assembly.</summary>
+				/// <summary>Deserialize an assembly. Instructions of functions, debug informations and metadata used by instructions are kept in the binary form, until they are used.</summary>
 				/// <param name="input">Serialized binary data.</param>
 				WfAssembly(stream::IStream& input);
 				
 				void												Initialize();
+				/// <summary>Load instructions of a function if they are not loaded yet.</summary>
+				/// <param name="functionIndex">The function index.</param>
+				void												LoadFunctionInstructions(vint functionIndex);
+				/// <summary>Get debug informations using the module code, load it if it is not loaded yet.</summary>
+				/// <returns>The debug informations.</returns>
+				Ptr<WfInstructionDebugInfo>							GetInsBeforeCodegen();
+				/// <summary>Get debug informations using the module code from generated syntax trees from the final compiling pass, load it if it is not loaded yet.</summary>
+				/// <returns>The debug informations.</returns>
+				Ptr<WfInstructionDebugInfo>							GetInsAfterCodegen();
+				/// <summary>Load everything that are not loaded yet.</summary>
+				void												LoadAll();
 				/// <summary>Serialize an assembly.</summary>
 				/// <param name="output">Serialized binary data.</param>
-				void												Serialize(stream::IStream& output);
+				/// <param name="loadOnDemand">Set to false to use the previous format, in which everything is loaded when deserializing.</param>
+				void												Serialize(stream::IStream& output, bool loadOnDemand = true);
 			};
 		}
 	}
@@ -1412,17 +1429,71 @@ RuntimeEnvironment
 				VariableArray					variables;
 			};
 
+			enum class WfInstructionCacheKind
+			{
+				Reflection,			// call through the reflection interface
+				ScriptFunction,		// enter the script function without this object
+				ScriptMethod,		// enter the script function with this object captured
+				NativeMethod,		// call the native method, skip the this object checking if the receiver type is remembered
+			};
+
+			/// <summary>Inline cache for an instruction, resolved when the global context is created.</summary>
+			struct WfInstructionCache
+			{
+				WfInstructionCacheKind							kind = WfInstructionCacheKind::Reflection;
+				vint											functionIndex = -1;
+				reflection::description::MethodInfoImpl*		nativeMethod = nullptr;
+				reflection::description::ITypeDescriptor*		receiverType = nullptr;	// the first type of the this object that passes the checking, written only once
+			};
+
 			/// <summary>Global context for executing a Workflow program. After the context is prepared, use [M:vl.workflow.runtime.LoadFunction] to call any functions inside the assembly. Function "&lt;initialize&gt;" should be the first to execute.</summary>
 			class WfRuntimeGlobalContext : public Object, public reflection::Description<WfRuntimeGlobalContext>
 			{
+			protected:
+				collections::Array<vint>		preparedFunctions;
+				CriticalSection					prepareLock;
+
+				void							ResolveInstructionCaches(vint firstInstruction, vint lastInstruction);
 			public:
 				Ptr<WfAssembly>					assembly;
 				Ptr<WfRuntimeVariableContext>	globalVariables;
+				/// <summary>Inline caches for all instructions in the assembly. This index is the same as [F:vl.workflow.runtime.WfAssembly.instructions].</summary>
+				collections::Array<WfInstructionCache>	instructionCaches;
 				
 				/// <summary>Create a global context for executing a Workflow program.</summary>
 				/// <param name="_assembly">The assembly.</param>
 				WfRuntimeGlobalContext(Ptr<WfAssembly> _assembly);
 				~WfRuntimeGlobalContext();
+
+				/// <summary>Load instructions of a function and resolve inline caches for them. It is called before the function is executed for the first time.</summary>
+				/// <param name="functionIndex">The function index.</param>
+				void							PrepareFunction(vint functionIndex);
+			};
+
+			/// <summary>A slot in the stack of a <see cref="WfRuntimeThreadContext"/>. Results of primitive operators are kept unboxed in the slot, and they are only boxed when they are read as a <see cref="reflection::description::Value"/>.</summary>
+			struct WfRuntimeStackValue
+			{
+				/// <summary>The type of the unboxed value. If it is [F:vl.workflow.runtime.WfInsType.Unknown], the value is stored in [F:vl.workflow.runtime.WfRuntimeStackValue.boxedValue].</summary>
+				WfInsType						type = WfInsType::Unknown;
+				union
+				{
+					bool						boolValue;
+					vint64_t					intValue;
+					vuint64_t					uintValue;
+					double						floatValue;
+				};
+				/// <summary>The boxed value.</summary>
+				reflection::description::Value	boxedValue;
+
+				WfRuntimeStackValue();
+				WfRuntimeStackValue(const reflection::description::Value& value);
+
+				/// <summary>Test if the slot contains a null value.</summary>
+				/// <returns>Returns true if the slot contains a null value.</returns>
+				bool							IsNull()const;
+				/// <summary>Get the value in the slot, an unboxed value will be boxed.</summary>
+				/// <returns>The value in the slot.</returns>
+				reflection::description::Value	GetValue()const;
 			};
 
 			struct WfRuntimeStackFrame
@@ -1602,7 +1673,7 @@ RuntimeThreadContext
 
 			class WfRuntimeThreadContext
 			{
-				typedef collections::List<reflection::description::Value>		VariableList;
+				typedef collections::List<WfRuntimeStackValue>					VariableList;
 				typedef collections::List<WfRuntimeStackFrame>					StackFrameList;
 				typedef collections::List<WfRuntimeTrapFrame>					TrapFrameList;
 			public:
@@ -1625,6 +1696,8 @@ RuntimeThreadContext
 				WfRuntimeThreadContextError		PopTrapFrame(vint saveStackPatternCount);
 				WfRuntimeThreadContextError		PushValue(const reflection::description::Value& value);
 				WfRuntimeThreadContextError		PopValue(reflection::description::Value& value);
+				WfRuntimeThreadContextError		PushStackValue(const WfRuntimeStackValue& value);
+				WfRuntimeThreadContextError		PopStackValue(WfRuntimeStackValue& value);
 				WfRuntimeThreadContextError		RaiseException(const WString& exception, bool fatalError, bool skipDebugger = false);
 				WfRuntimeThreadContextError		RaiseException(Ptr<WfRuntimeExceptionInfo> info, bool skipDebugger = false);
 
@@ -1635,8 +1708,11 @@ RuntimeThreadContext
 				WfRuntimeThreadContextError		StoreCapturedVariable(vint variableIndex, const reflection::description::Value& value);
 				WfRuntimeThreadContextError		LoadLocalVariable(vint variableIndex, reflection::description::Value& value);
 				WfRuntimeThreadContextError		StoreLocalVariable(vint variableIndex, const reflection::description::Value& value);
+				WfRuntimeThreadContextError		LoadLocalStackValue(vint variableIndex, WfRuntimeStackValue& value);
+				WfRuntimeThreadContextError		StoreLocalStackValue(vint variableIndex, const WfRuntimeStackValue& value);
 
-				WfRuntimeExecutionAction		ExecuteInternal(WfInstruction& ins, WfRuntimeStackFrame& stackFrame, IWfDebuggerCallback* callback);
+				reflection::description::Value	InvokeNativeMethod(WfInstructionCache& cache, reflection::description::IMethodInfo* method, const reflection::description::Value& thisValue, collections::Array<reflection::description::Value>& arguments);
+				WfRuntimeExecutionAction		ExecuteInternal(WfInstruction& ins, WfInstructionCache& cache, WfRuntimeStackFrame& stackFrame, IWfDebuggerCallback* callback);
 				WfRuntimeExecutionAction		Execute(IWfDebuggerCallback* callback);
 				void							ExecuteToEnd();
 			};
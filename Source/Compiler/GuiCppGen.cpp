@@ -10,13 +10,45 @@ namespace vl
 		using namespace workflow;
 		using namespace workflow::cppcodegen;
 
+		bool WriteStreamIfChanged(MemoryStream& stream, const filesystem::FilePath& filePath)
+		{
+			vint size = (vint)stream.Size();
+			stream.SeekFromBegin(0);
+			{
+				FileStream fileStream(filePath.GetFullPath(), FileStream::ReadOnly);
+				if (fileStream.IsAvailable() && fileStream.Size() == size)
+				{
+					const vint block = 65536;
+					char buffer[block];
+					bool changed = false;
+					for (vint offset = 0; offset < size && !changed; offset += block)
+					{
+						vint length = size - offset < block ? size - offset : block;
+						changed = fileStream.Read(buffer, length) != length || memcmp(buffer, (char*)stream.GetInternalBuffer() + offset, length) != 0;
+					}
+					if (!changed)
+					{
+						return true;
+					}
+				}
+			}
+
+			FileStream fileStream(filePath.GetFullPath(), FileStream::WriteOnly);
+			if (!fileStream.IsAvailable())
+			{
+				return false;
+			}
+			return fileStream.Write(stream.GetInternalBuffer(), size) == size;
+		}
+
 		Ptr<GuiResourceFolder> PrecompileAndWriteErrors(
 			Ptr<GuiResource> resource,
 			IGuiResourcePrecompileCallback* callback,
 			collections::List<GuiResourceError>& errors,
-			const filesystem::FilePath& errorPath)
+			const filesystem::FilePath& errorPath,
+			vint workerCount)
 		{
-			auto precompiledFolder = resource->Precompile(callback, errors);
+			auto precompiledFolder = resource->Precompile(callback, errors, workerCount);
 			if (errors.Count() > 0)
 			{
 				List<WString> output;
@@ -125,20 +157,16 @@ namespace vl
 				precompiled->RemoveFolder(L"Workflow");
 			}
 
-			FileStream fileStream(filePath.GetFullPath(), FileStream::WriteOnly);
-
-			if (fileStream.IsAvailable())
+			MemoryStream binaryStream;
+			if (compress)
 			{
-				if (compress)
-				{
-					LzwEncoder encoder;
-					EncoderStream encoderStream(fileStream, encoder);
-					resource->SavePrecompiledBinary(encoderStream);
-				}
-				else
-				{
-					resource->SavePrecompiledBinary(fileStream);
-				}
+				LzwEncoder encoder;
+				EncoderStream encoderStream(binaryStream, encoder);
+				resource->SavePrecompiledBinary(encoderStream);
+			}
+			else
+			{
+				resource->SavePrecompiledBinary(binaryStream);
 			}
 
 			if (folder && !workflow)
@@ -146,7 +174,7 @@ namespace vl
 				precompiled->AddFolder(L"Workflow", folder);
 			}
 
-			return fileStream.IsAvailable();
+			return WriteStreamIfChanged(binaryStream, filePath);
 		}
 
 		void WriteEmbeddedBinaryClass(MemoryStream& binaryStream, bool compress, const WString& className, const WString& prefix, StreamWriter& writer)
@@ -304,5 +332,133 @@ namespace vl
 			}
 			return file.WriteAllText(code, true, BomEncoder::Utf8);
 		}
+
+/***********************************************************************
+Build Manifest
+***********************************************************************/
+
+		// the manifest records hashes of every file that a build reads or writes
+		// it only decides whether the whole build could be skipped, no precompiled output of any resource item is kept
+		// any change to an input or output file rebuilds everything
+		// modules generated from instances are not kept for each item, because
+		//   all modules are compiled into one assembly in Instance_CompileInstanceClass, which takes most of the precompiling time
+		//   generated modules use names like <bind-cache>0 that WfParseModule does not accept, so they could not be loaded from text
+
+		bool HashFileContent(const filesystem::FilePath& filePath, vuint64_t& hash)
+		{
+			FileStream fileStream(filePath.GetFullPath(), FileStream::ReadOnly);
+			if (!fileStream.IsAvailable())
+			{
+				return false;
+			}
+
+			// FNV-1a
+			hash = 14695981039346656037ULL;
+			const vint block = 65536;
+			vuint8_t buffer[block];
+			while (true)
+			{
+				vint length = fileStream.Read(buffer, block);
+				if (length == 0)
+				{
+					break;
+				}
+				for (vint i = 0; i < length; i++)
+				{
+					hash = (hash ^ buffer[i]) * 1099511628211ULL;
+				}
+			}
+			return true;
+		}
+
+		void CollectResourceFiles(Ptr<GuiResourceFolder> folder, SortedList<WString>& filePaths)
+		{
+			if (folder->GetFileAbsolutePath() != L"" && !filePaths.Contains(folder->GetFileAbsolutePath()))
+			{
+				filePaths.Add(folder->GetFileAbsolutePath());
+			}
+			FOREACH(Ptr<GuiResourceItem>, item, folder->GetItems())
+			{
+				if (item->GetFileAbsolutePath() != L"" && !filePaths.Contains(item->GetFileAbsolutePath()))
+				{
+					filePaths.Add(item->GetFileAbsolutePath());
+				}
+			}
+			FOREACH(Ptr<GuiResourceFolder>, subFolder, folder->GetFolders())
+			{
+				CollectResourceFiles(subFolder, filePaths);
+			}
+		}
+
+		bool IsResourceBuildUpToDate(
+			const filesystem::FilePath& manifestPath,
+			const WString& configuration)
+		{
+			File file(manifestPath);
+			if (!file.Exists())
+			{
+				return false;
+			}
+
+			List<WString> lines;
+			if (!file.ReadAllLinesByBom(lines) || lines.Count() < 2 || lines[0] != configuration)
+			{
+				return false;
+			}
+
+			for (vint i = 1; i < lines.Count(); i++)
+			{
+				auto line = lines[i];
+				if (line == L"")
+				{
+					continue;
+				}
+
+				auto buffer = line.Buffer();
+				auto separator = wcschr(buffer, L'\t');
+				if (!separator)
+				{
+					return false;
+				}
+
+				vuint64_t hash = 0;
+				WString filePath = separator + 1;
+				if (!HashFileContent(filePath, hash) || hash != wtou64(line.Left(separator - buffer)))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool WriteResourceBuildManifest(
+			Ptr<GuiResource> resource,
+			collections::List<filesystem::FilePath>& outputPaths,
+			const filesystem::FilePath& manifestPath,
+			const WString& configuration)
+		{
+			SortedList<WString> filePaths;
+			CollectResourceFiles(resource, filePaths);
+			FOREACH(FilePath, outputPath, outputPaths)
+			{
+				if (!filePaths.Contains(outputPath.GetFullPath()))
+				{
+					filePaths.Add(outputPath.GetFullPath());
+				}
+			}
+
+			List<WString> lines;
+			lines.Add(configuration);
+			FOREACH(WString, filePath, filePaths)
+			{
+				vuint64_t hash = 0;
+				if (!HashFileContent(filePath, hash))
+				{
+					return false;
+				}
+				lines.Add(u64tow(hash) + L"\t" + filePath);
+			}
+			return File(manifestPath).WriteAllLines(lines, true, BomEncoder::Utf8);
+		}
 	}
 }
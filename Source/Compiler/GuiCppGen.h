@@ -21,7 +21,8 @@ namespace vl
 															Ptr<GuiResource> resource,
 															IGuiResourcePrecompileCallback* callback,
 															collections::List<GuiResourceError>& errors,
-															const filesystem::FilePath& errorPath);
+															const filesystem::FilePath& errorPath,
+															vint workerCount = 1);
 
 		extern Ptr<GuiInstanceCompiledWorkflow>			WriteWorkflowScript(
 															Ptr<GuiResourceFolder> precompiledFolder,
@@ -43,6 +44,16 @@ namespace vl
 															Ptr<workflow::cppcodegen::WfCppOutput> cppOutput,
 															bool compress,
 															const filesystem::FilePath& filePath);
+
+		extern bool										IsResourceBuildUpToDate(
+															const filesystem::FilePath& manifestPath,
+															const WString& configuration);
+
+		extern bool										WriteResourceBuildManifest(
+															Ptr<GuiResource> resource,
+															collections::List<filesystem::FilePath>& outputPaths,
+															const filesystem::FilePath& manifestPath,
+															const WString& configuration);
 	}
 }
 
@@ -192,15 +192,39 @@ GuiDefaultInstanceLoader
 			typedef Tuple<ITypeDescriptor*, GlobalStringKey>				FieldKey;
 			typedef Tuple<Ptr<GuiInstancePropertyInfo>, IPropertyInfo*>		PropertyType;
 
+			SpinLock														cacheLock;	// caches are filled by instances precompiled in parallel, values are computed outside of the lock
 			Dictionary<FieldKey, PropertyType>								propertyTypes;
 			Dictionary<ITypeDescriptor*, IMethodInfo*>						defaultConstructors;
 			Dictionary<ITypeDescriptor*, IMethodInfo*>						instanceConstructors;
+
+			template<typename TKey, typename TValue>
+			bool GetCache(Dictionary<TKey, TValue>& cache, const TKey& key, TValue& value)
+			{
+				SPIN_LOCK(cacheLock)
+				{
+					vint index = cache.Keys().IndexOf(key);
+					if (index != -1)
+					{
+						value = cache.Values()[index];
+						return true;
+					}
+				}
+				return false;
+			}
+
+			template<typename TKey, typename TValue>
+			void SetCache(Dictionary<TKey, TValue>& cache, const TKey& key, const TValue& value)
+			{
+				SPIN_LOCK(cacheLock)
+				{
+					cache.Set(key, value);
+				}
+			}
 		public:
 			IMethodInfo* GetDefaultConstructor(ITypeDescriptor* typeDescriptor)
 			{
 				IMethodInfo* ctor = nullptr;
-				vint index = defaultConstructors.Keys().IndexOf(typeDescriptor);
-				if (index == -1)
+				if (!GetCache(defaultConstructors, typeDescriptor, ctor))
 				{
 					if (auto ctors = typeDescriptor->GetConstructorGroup())
 					{
@@ -215,11 +239,7 @@ GuiDefaultInstanceLoader
 							}
 						}
 					}
-					defaultConstructors.Add(typeDescriptor, ctor);
-				}
-				else
-				{
-					ctor = defaultConstructors.Values()[index];
+					SetCache(defaultConstructors, typeDescriptor, ctor);
 				}
 				return ctor;
 			}
@@ -229,8 +249,7 @@ GuiDefaultInstanceLoader
 				CTOR_PARAM_PREFIX
 					
 				IMethodInfo* ctor = nullptr;
-				vint index = instanceConstructors.Keys().IndexOf(typeDescriptor);
-				if (index == -1)
+				if (!GetCache(instanceConstructors, typeDescriptor, ctor))
 				{
 					if (dynamic_cast<WfClass*>(typeDescriptor))
 					{
@@ -258,11 +277,7 @@ GuiDefaultInstanceLoader
 						}
 					}
 				FINISHED:
-					instanceConstructors.Add(typeDescriptor, ctor);
-				}
-				else
-				{
-					ctor = instanceConstructors.Values()[index];
+					SetCache(instanceConstructors, typeDescriptor, ctor);
 				}
 				return ctor;
 			}
@@ -274,9 +289,12 @@ GuiDefaultInstanceLoader
 
 			void ClearReflectionCache()override
 			{
-				propertyTypes.Clear();
-				defaultConstructors.Clear();
-				instanceConstructors.Clear();
+				SPIN_LOCK(cacheLock)
+				{
+					propertyTypes.Clear();
+					defaultConstructors.Clear();
+					instanceConstructors.Clear();
+				}
 			}
 
 			//***********************************************************************************
@@ -442,8 +460,8 @@ GuiDefaultInstanceLoader
 				CTOR_PARAM_PREFIX
 
 				FieldKey key(propertyInfo.typeInfo.typeInfo->GetTypeDescriptor(), propertyInfo.propertyName);
-				vint index = propertyTypes.Keys().IndexOf(key);
-				if (index == -1)
+				PropertyType value;
+				if (!GetCache(propertyTypes, key, value))
 				{
 					GuiInstancePropertyInfo::Support support = GuiInstancePropertyInfo::NotSupport;
 					if (ITypeInfo* propType = GetPropertyReflectionTypeInfo(propertyInfo, support))
@@ -467,21 +485,15 @@ GuiDefaultInstanceLoader
 						}
 
 						IPropertyInfo* prop = propertyInfo.typeInfo.typeInfo->GetTypeDescriptor()->GetPropertyByName(propertyInfo.propertyName.ToString(), true);
-						PropertyType value(result, prop);
-						propertyTypes.Add(key, value);
-						return value;
+						value = PropertyType(result, prop);
 					}
 					else
 					{
-						PropertyType value(GuiInstancePropertyInfo::Unsupported(), 0);
-						propertyTypes.Add(key, value);
-						return value;
+						value = PropertyType(GuiInstancePropertyInfo::Unsupported(), 0);
 					}
+					SetCache(propertyTypes, key, value);
 				}
-				else
-				{
-					return propertyTypes.Values()[index];
-				}
+				return value;
 			}
 
 			Ptr<GuiInstancePropertyInfo> GetPropertyType(const PropertyInfo& propertyInfo)override
@@ -705,12 +717,14 @@ GuiInstanceLoaderManager
 				GlobalStringKey						parentTypeName;				// for virtual type only
 				Ptr<IGuiInstanceLoader>				loader;
 
+				bool								parentTypesFilled = false;	// parentTypes and parentTypeInfos are filled on demand, to avoid loading members of all base types on startup
 				List<ITypeDescriptor*>				parentTypes;				// all direct or indirect base types that does not has a type info
 				List<VirtualTypeInfo*>				parentTypeInfos;			// type infos for all registered direct or indirect base types
 			};
 
 			typedef Dictionary<GlobalStringKey, Ptr<VirtualTypeInfo>>		VirtualTypeInfoMap;
 
+			SpinLock								parentTypesLock;			// parent types are filled by instances precompiled in parallel
 			Ptr<IGuiInstanceLoader>					rootLoader;
 			BinderMap								binders;
 			EventBinderMap							eventBinders;
@@ -722,7 +736,7 @@ GuiInstanceLoaderManager
 				return GetGlobalTypeManager()->GetTypeDescriptor(name.ToString()) != 0 || typeInfos.Keys().Contains(name);
 			}
 
-			void FindParentTypeInfos(Ptr<VirtualTypeInfo> typeInfo, ITypeDescriptor* searchType)
+			void FindParentTypeInfos(VirtualTypeInfo* typeInfo, ITypeDescriptor* searchType)
 			{
 				if (searchType != typeInfo->typeDescriptor)
 				{
@@ -746,16 +760,15 @@ GuiInstanceLoaderManager
 				}
 			}
 
-			void FillParentTypeInfos(Ptr<VirtualTypeInfo> typeInfo)
+			void FillParentTypeInfos(VirtualTypeInfo* typeInfo)
 			{
-				if (typeInfo->parentTypeName != GlobalStringKey::Empty)
-				{
-					typeInfo->typeDescriptor = nullptr;
-				}
+				if (typeInfo->parentTypesFilled) return;
+				typeInfo->parentTypesFilled = true;
 				typeInfo->parentTypes.Clear();
 				typeInfo->parentTypeInfos.Clear();
 
-				ITypeDescriptor* searchType = typeInfo->typeDescriptor;
+				// typeDescriptor is read without the lock, so it is only overwritten by the resolved value
+				ITypeDescriptor* searchType = typeInfo->parentTypeName == GlobalStringKey::Empty ? typeInfo->typeDescriptor : nullptr;
 				if (!searchType)
 				{
 					vint index = typeInfos.Keys().IndexOf(typeInfo->parentTypeName);
@@ -875,8 +888,13 @@ GuiInstanceLoaderManager
 				typeInfo->typeName = loader->GetTypeName();
 				typeInfo->parentTypeName = parentType;
 				typeInfo->loader = loader;
+				{
+					vint index = typeInfos.Keys().IndexOf(parentType);
+					typeInfo->typeDescriptor = index == -1
+						? GetGlobalTypeManager()->GetTypeDescriptor(parentType.ToString())
+						: typeInfos.Values()[index]->typeDescriptor;
+				}
 				typeInfos.Add(loader->GetTypeName(), typeInfo);
-				FillParentTypeInfos(typeInfo);
 
 				return true;
 			}
@@ -894,13 +912,12 @@ GuiInstanceLoaderManager
 				typeInfo->typeDescriptor = typeDescriptor;
 				typeInfo->loader = loader;
 				typeInfos.Add(typeInfo->typeName, typeInfo);
-				FillParentTypeInfos(typeInfo);
 
 				FOREACH(Ptr<VirtualTypeInfo>, derived, typeInfos.Values())
 				{
 					if (derived->parentTypes.Contains(typeInfo->typeDescriptor))
 					{
-						FillParentTypeInfos(derived);
+						derived->parentTypesFilled = false;
 					}
 				}
 
@@ -929,10 +946,14 @@ GuiInstanceLoaderManager
 				vint index = typeInfos.Keys().IndexOf(loader->GetTypeName());
 				if (index != -1)
 				{
-					Ptr<VirtualTypeInfo> typeInfo = typeInfos.Values()[index];
-					if (typeInfo->parentTypeInfos.Count() > 0)
+					auto typeInfo = typeInfos.Values()[index].Obj();
+					SPIN_LOCK(parentTypesLock)
 					{
-						return typeInfo->parentTypeInfos[0]->loader.Obj();
+						FillParentTypeInfos(typeInfo);
+						if (typeInfo->parentTypeInfos.Count() > 0)
+						{
+							return typeInfo->parentTypeInfos[0]->loader.Obj();
+						}
 					}
 					return rootLoader.Obj();
 				}
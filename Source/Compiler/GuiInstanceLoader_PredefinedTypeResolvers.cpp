@@ -105,26 +105,29 @@ namespace vl
 
 		void Workflow_AddModule(GuiResourcePrecompileContext& context, const WString& path, Ptr<WfModule> module, GuiInstanceCompiledWorkflow::AssemblyType assemblyType, GuiResourceTextPos tagPosition)
 		{
-			auto compiled = Workflow_GetModule(context, path);
-			if (!compiled)
+			context.UpdateSharedStates([=](GuiResourcePrecompileContext& sharedContext)
 			{
-				compiled = new GuiInstanceCompiledWorkflow;
-				compiled->type = assemblyType;
-				context.targetFolder->CreateValueByPath(path, L"Workflow", compiled);
-			}
-			else
-			{
-				CHECK_ERROR(compiled->type == assemblyType, L"Workflow_AddModule(GuiResourcePrecompiledContext&, const WString&, GuiInstanceCompiledWorkflow::AssemblyType)#Unexpected assembly type.");
-			}
+				auto compiled = Workflow_GetModule(sharedContext, path);
+				if (!compiled)
+				{
+					compiled = new GuiInstanceCompiledWorkflow;
+					compiled->type = assemblyType;
+					sharedContext.targetFolder->CreateValueByPath(path, L"Workflow", compiled);
+				}
+				else
+				{
+					CHECK_ERROR(compiled->type == assemblyType, L"Workflow_AddModule(GuiResourcePrecompiledContext&, const WString&, GuiInstanceCompiledWorkflow::AssemblyType)#Unexpected assembly type.");
+				}
 
-			if (compiled)
-			{
-				GuiInstanceCompiledWorkflow::ModuleRecord record;
-				record.module = module;
-				record.position = tagPosition;
-				record.shared = assemblyType == GuiInstanceCompiledWorkflow::Shared;
-				compiled->modules.Add(record);
-			}
+				if (compiled)
+				{
+					GuiInstanceCompiledWorkflow::ModuleRecord record;
+					record.module = module;
+					record.position = tagPosition;
+					record.shared = assemblyType == GuiInstanceCompiledWorkflow::Shared;
+					compiled->modules.Add(record);
+				}
+			});
 		}
 
 		void Workflow_GenerateAssembly(GuiResourcePrecompileContext& context, const WString& path, GuiResourceError::List& errors, bool keepMetadata, IWfCompilerCallback* compilerCallback)
@@ -251,7 +254,7 @@ Shared Script Type Resolver (Script)
 				switch (passIndex)
 				{
 				case Workflow_Collect:
-					return PerResource;
+					return PerResourceParallel;
 				case Workflow_Compile:
 					return PerPass;
 				default:
@@ -379,7 +382,7 @@ Instance Type Resolver (Instance)
 				case Instance_CollectInstanceTypes:
 				case Instance_CollectEventHandlers:
 				case Instance_GenerateInstanceClass:
-					return PerResource;
+					return PerResourceParallel;
 				case Instance_CompileInstanceTypes:
 				case Instance_CompileEventHandlers:
 				case Instance_CompileInstanceClass:
@@ -448,13 +451,17 @@ Instance Type Resolver (Instance)
 
 							if (context.passIndex == Instance_CollectInstanceTypes)
 							{
-								auto record = context.targetFolder->GetValueByPath(L"ClassNameRecord").Cast<GuiResourceClassNameRecord>();
-								if (!record)
+								auto className = obj->className;
+								context.UpdateSharedStates([=](GuiResourcePrecompileContext& sharedContext)
 								{
-									record = MakePtr<GuiResourceClassNameRecord>();
-									context.targetFolder->CreateValueByPath(L"ClassNameRecord", L"ClassNameRecord", record);
-								}
-								record->classNames.Add(obj->className);
+									auto record = sharedContext.targetFolder->GetValueByPath(L"ClassNameRecord").Cast<GuiResourceClassNameRecord>();
+									if (!record)
+									{
+										record = MakePtr<GuiResourceClassNameRecord>();
+										sharedContext.targetFolder->CreateValueByPath(L"ClassNameRecord", L"ClassNameRecord", record);
+									}
+									record->classNames.Add(className);
+								});
 							}
 						}
 					}
@@ -684,7 +691,7 @@ Animation Type Resolver (Animation)
 				case Instance_CollectInstanceTypes:
 				case Instance_CollectEventHandlers:
 				case Instance_GenerateInstanceClass:
-					return PerResource;
+					return PerResourceParallel;
 				default:
 					return NotSupported;
 				}
@@ -807,7 +814,7 @@ Localized Strings Type Resolver (LocalizedStrings)
 				switch (passIndex)
 				{
 				case Workflow_Collect:
-					return PerResource;
+					return PerResourceParallel;
 				default:
 					return NotSupported;
 				}
@@ -74,27 +74,42 @@ WorkflowCompiler_ScriptPosition
 
 		void Workflow_RecordScriptPosition(GuiResourcePrecompileContext& context, GuiResourceTextPos position, Ptr<workflow::WfType> node, parsing::ParsingTextPos availableAfter)
 		{
-			WorkflowScriptPositionVisitor(context, position, availableAfter).VisitField(node.Obj());
+			context.UpdateSharedStates([=](GuiResourcePrecompileContext& sharedContext)
+			{
+				WorkflowScriptPositionVisitor(sharedContext, position, availableAfter).VisitField(node.Obj());
+			});
 		}
 
 		void Workflow_RecordScriptPosition(GuiResourcePrecompileContext& context, GuiResourceTextPos position, Ptr<workflow::WfExpression> node, parsing::ParsingTextPos availableAfter)
 		{
-			WorkflowScriptPositionVisitor(context, position, availableAfter).VisitField(node.Obj());
+			context.UpdateSharedStates([=](GuiResourcePrecompileContext& sharedContext)
+			{
+				WorkflowScriptPositionVisitor(sharedContext, position, availableAfter).VisitField(node.Obj());
+			});
 		}
 
 		void Workflow_RecordScriptPosition(GuiResourcePrecompileContext& context, GuiResourceTextPos position, Ptr<workflow::WfStatement> node, parsing::ParsingTextPos availableAfter)
 		{
-			WorkflowScriptPositionVisitor(context, position, availableAfter).VisitField(node.Obj());
+			context.UpdateSharedStates([=](GuiResourcePrecompileContext& sharedContext)
+			{
+				WorkflowScriptPositionVisitor(sharedContext, position, availableAfter).VisitField(node.Obj());
+			});
 		}
 
 		void Workflow_RecordScriptPosition(GuiResourcePrecompileContext& context, GuiResourceTextPos position, Ptr<workflow::WfDeclaration> node, parsing::ParsingTextPos availableAfter)
 		{
-			WorkflowScriptPositionVisitor(context, position, availableAfter).VisitField(node.Obj());
+			context.UpdateSharedStates([=](GuiResourcePrecompileContext& sharedContext)
+			{
+				WorkflowScriptPositionVisitor(sharedContext, position, availableAfter).VisitField(node.Obj());
+			});
 		}
 
 		void Workflow_RecordScriptPosition(GuiResourcePrecompileContext& context, GuiResourceTextPos position, Ptr<workflow::WfModule> node, parsing::ParsingTextPos availableAfter)
 		{
-			WorkflowScriptPositionVisitor(context, position, availableAfter).VisitField(node.Obj());
+			context.UpdateSharedStates([=](GuiResourcePrecompileContext& sharedContext)
+			{
+				WorkflowScriptPositionVisitor(sharedContext, position, availableAfter).VisitField(node.Obj());
+			});
 		}
 
 		Ptr<types::ScriptPosition> Workflow_GetScriptPosition(GuiResourcePrecompileContext& context)
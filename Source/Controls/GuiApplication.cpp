@@ -519,10 +519,11 @@ GuiApplicationMain
 				DestroyPluginManager();
 				theme::FinalizeTheme();
 				ThreadLocalStorage::DisposeStorages();
-				FinalizeGlobalStorage();
 #ifndef VCZH_DEBUG_NO_REFLECTION
+				// names in type descriptors are interned, they are released with global storages
 				DestroyGlobalTypeManager();
 #endif
+				FinalizeGlobalStorage();
 			}
 		}
 	}
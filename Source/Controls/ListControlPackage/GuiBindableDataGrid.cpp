@@ -1,5 +1,6 @@
 #include "GuiBindableDataGrid.h"
 #include "GuiBindableListControls.h"
+#include "../GuiApplication.h"
 
 namespace vl
 {
@@ -156,6 +157,52 @@ DataSorterBase
 					callback = value;
 				}
 
+/***********************************************************************
+DataKeySorterBase
+***********************************************************************/
+
+				vint DataSortKey::Compare(const DataSortKey& key1, const DataSortKey& key2)
+				{
+					if (key1.integer != key2.integer) return key1.integer < key2.integer ? -1 : 1;
+					if (key1.number != key2.number) return key1.number < key2.number ? -1 : 1;
+					return WString::Compare(key1.text, key2.text);
+				}
+
+				vint DataKeySorterBase::Compare(const description::Value& row1, const description::Value& row2)
+				{
+					DataSortKey key1, key2;
+					GetSortKey(row1, key1);
+					GetSortKey(row2, key2);
+					return DataSortKey::Compare(key1, key2);
+				}
+
+/***********************************************************************
+DataKeySorter
+***********************************************************************/
+
+				DataKeySorter::DataKeySorter()
+				{
+				}
+
+				ItemProperty<DataSortKey> DataKeySorter::GetKeyProperty()
+				{
+					return keyProperty;
+				}
+
+				void DataKeySorter::SetKeyProperty(const ItemProperty<DataSortKey>& value)
+				{
+					keyProperty = value;
+					InvokeOnProcessorChanged();
+				}
+
+				void DataKeySorter::GetSortKey(const description::Value& row, DataSortKey& key)
+				{
+					if (keyProperty)
+					{
+						key = keyProperty(row);
+					}
+				}
+
 /***********************************************************************
 DataMultipleSorter
 ***********************************************************************/
@@ -489,19 +536,25 @@ DataProvider
 				void DataProvider::OnProcessorChanged()
 				{
 					RebuildFilter();
-					ReorderRows(true);
+					ReorderRowsInBackground();
 				}
 
 				void DataProvider::OnItemSourceModified(vint start, vint count, vint newCount)
 				{
+					itemSourceSnapshot = nullptr;
+					vint oldRowCount = (itemSource ? itemSource->GetCount() : 0) - newCount + count;
 					if (!currentSorter && !currentFilter && count == newCount)
 					{
 						InvokeOnItemModified(start, count, newCount);
 					}
-					else
+					else if (filterTask || (count + newCount) * 2 > oldRowCount)
 					{
 						ReorderRows(true);
 					}
+					else
+					{
+						ReorderRowsIncrementally(start, count, newCount);
+					}
 				}
 
 				ListViewDataColumns& DataProvider::GetDataColumns()
@@ -595,6 +648,7 @@ DataProvider
 
 				void DataProvider::ReorderRows(bool invokeCallback)
 				{
+					CancelFilterTask();
 					vint oldRowCount = virtualRowToSourceRow.Count();
 					virtualRowToSourceRow.Clear();
 					vint rowCount = itemSource ? itemSource->GetCount() : 0;
@@ -617,21 +671,424 @@ DataProvider
 						}
 					}
 
-					if (currentSorter && virtualRowToSourceRow.Count() > 0)
+					SortRows();
+					if (invokeCallback)
+					{
+						NotifyAllItemsUpdate();
+					}
+				}
+
+				void DataProvider::ReorderRowsInBackground()
+				{
+					if (!filterInBackground || !currentFilter || !itemSource || !GetApplication())
+					{
+						ReorderRows(true);
+						return;
+					}
+
+					// the previous rows are displayed until the new filter is evaluated
+					auto task = CreateFilterTask();
+					ThreadPoolLite::QueueLambda([=]()
+					{
+						task->Run();
+						if (task->cancelled) return;
+						GetApplication()->InvokeInMainThread(nullptr, [=]()
+						{
+							// a cancelled task never touches the data provider, which could have been deleted
+							if (task->cancelled) return;
+							PublishFilterTask(task);
+						});
+					});
+				}
+
+				void DataProvider::FilterTask::Run()
+				{
+					for (vint i = 0; i < rows->Count(); i++)
+					{
+						if (cancelled) return;
+						if (filter->Filter(rows->Get(i)))
+						{
+							filteredRows.Add(i);
+						}
+					}
+				}
+
+				Ptr<DataProvider::FilterTask> DataProvider::CreateFilterTask()
+				{
+					// the item source is copied in the UI thread only once, all tasks share the copy until the item source is modified
+					CancelFilterTask();
+					if (!itemSourceSnapshot)
+					{
+						itemSourceSnapshot = MakePtr<Array<Value>>(itemSource->GetCount());
+						for (vint i = 0; i < itemSourceSnapshot->Count(); i++)
+						{
+							itemSourceSnapshot->Set(i, itemSource->Get(i));
+						}
+					}
+
+					auto task = MakePtr<FilterTask>();
+					task->filter = currentFilter;
+					task->rows = itemSourceSnapshot;
+					filterTask = task;
+					return task;
+				}
+
+				void DataProvider::PublishFilterTask(Ptr<FilterTask> task)
+				{
+					// a task is cancelled when a newer filter or a modified item source replaces its result
+					if (task->cancelled || task != filterTask) return;
+					filterTask = nullptr;
+					CopyFrom(virtualRowToSourceRow, task->filteredRows);
+					SortRows();
+					NotifyAllItemsUpdate();
+				}
+
+				void DataProvider::CancelFilterTask()
+				{
+					if (filterTask)
+					{
+						filterTask->cancelled = true;
+						filterTask = nullptr;
+					}
+				}
+
+				namespace data_provider_sorting
+				{
+					template<typename TOrderer>
+					void MergeSortedRuns(const vint* source, vint* target, vint start, vint middle, vint end, const TOrderer& orderer)
+					{
+						vint left = start;
+						vint right = middle;
+						vint index = start;
+						while (left < middle && right < end)
+						{
+							target[index++] = orderer(source[right], source[left]) < 0 ? source[right++] : source[left++];
+						}
+						while (left < middle) target[index++] = source[left++];
+						while (right < end) target[index++] = source[right++];
+					}
+
+					template<typename TOrderer>
+					void MergeSortRows(vint* items, vint* buffer, vint count, const TOrderer& orderer)
+					{
+						const vint RunLength = 16;
+						for (vint start = 0; start < count; start += RunLength)
+						{
+							vint end = start + RunLength < count ? start + RunLength : count;
+							for (vint i = start + 1; i < end; i++)
+							{
+								vint item = items[i];
+								vint j = i;
+								while (j > start && orderer(item, items[j - 1]) < 0)
+								{
+									items[j] = items[j - 1];
+									j--;
+								}
+								items[j] = item;
+							}
+						}
+
+						vint* source = items;
+						vint* target = buffer;
+						for (vint width = RunLength; width < count; width *= 2)
+						{
+							for (vint start = 0; start < count; start += width * 2)
+							{
+								vint middle = start + width < count ? start + width : count;
+								vint end = start + width * 2 < count ? start + width * 2 : count;
+								MergeSortedRuns(source, target, start, middle, end, orderer);
+							}
+							vint* temp = source;
+							source = target;
+							target = temp;
+						}
+
+						if (source != items)
+						{
+							memcpy(items, source, sizeof(vint) * count);
+						}
+					}
+				}
+
+				void DataProvider::SortRows()
+				{
+					using namespace data_provider_sorting;
+					if (currentSorter && virtualRowToSourceRow.Count() > 0 && !SortRowsByKeys())
 					{
+						// the sorting is stable, rows with equal keys keep the source order like in SortRowsByKeys
 						IDataSorter* sorter = currentSorter.Obj();
-						SortLambda(
-							&virtualRowToSourceRow[0],
-							virtualRowToSourceRow.Count(),
-							[=](vint a, vint b)
+						vint rowCount = virtualRowToSourceRow.Count();
+						Array<vint> items(rowCount), buffer(rowCount);
+						for (vint i = 0; i < rowCount; i++)
+						{
+							items[i] = virtualRowToSourceRow[i];
+						}
+						MergeSortRows(&items[0], &buffer[0], rowCount, [=](vint a, vint b)
+						{
+							return sorter->Compare(itemSource->Get(a), itemSource->Get(b));
+						});
+						CopyFrom(virtualRowToSourceRow, items);
+					}
+				}
+
+				void DataProvider::CollectSortLevels(IDataSorter* sorter, bool reversed, collections::List<SortLevel>& levels)
+				{
+					if (!sorter)
+					{
+						return;
+					}
+					else if (auto multipleSorter = dynamic_cast<DataMultipleSorter*>(sorter))
+					{
+						CollectSortLevels(multipleSorter->leftSorter.Obj(), reversed, levels);
+						CollectSortLevels(multipleSorter->rightSorter.Obj(), reversed, levels);
+					}
+					else if (auto reverseSorter = dynamic_cast<DataReverseSorter*>(sorter))
+					{
+						CollectSortLevels(reverseSorter->sorter.Obj(), !reversed, levels);
+					}
+					else
+					{
+						SortLevel level;
+						level.sorter = sorter;
+						level.keySorter = dynamic_cast<DataKeySorterBase*>(sorter);
+						level.reversed = reversed;
+						levels.Add(level);
+					}
+				}
+
+				bool DataProvider::SortRowsByKeys()
+				{
+					using namespace data_provider_sorting;
+					const vint ParallelSortThreshold = 8192;
+					const vint ParallelSortChunks = 4;
+
+					// a sorter is flattened to levels, keys of key sorters are computed only once for each row
+					// sorters that are not key sorters still compare rows, but key sorters in the same tree do not compute keys again
+					List<SortLevel> levels;
+					CollectSortLevels(currentSorter.Obj(), false, levels);
+					vint levelCount = levels.Count();
+					vint keyCount = 0;
+					FOREACH(SortLevel, level, levels)
+					{
+						if (level.keySorter) keyCount++;
+					}
+					if (keyCount == 0) return false;
+					bool keysOnly = keyCount == levelCount;
+
+					// keys are computed in the UI thread, only comparing and moving keys happens in other threads
+					vint rowCount = virtualRowToSourceRow.Count();
+					Array<DataSortKey> keys(rowCount * levelCount);
+					Array<description::Value> rows(keysOnly ? 0 : rowCount);
+					for (vint i = 0; i < rowCount; i++)
+					{
+						auto row = itemSource->Get(virtualRowToSourceRow[i]);
+						for (vint j = 0; j < levelCount; j++)
+						{
+							if (auto keySorter = levels[j].keySorter)
+							{
+								keySorter->GetSortKey(row, keys[i * levelCount + j]);
+							}
+						}
+						if (!keysOnly)
+						{
+							rows[i] = row;
+						}
+					}
+
+					auto orderer = [&](vint a, vint b)
+					{
+						for (vint j = 0; j < levelCount; j++)
+						{
+							const auto& level = levels[j];
+							vint result = level.keySorter
+								? DataSortKey::Compare(keys[a * levelCount + j], keys[b * levelCount + j])
+								: level.sorter->Compare(rows[a], rows[b])
+								;
+							if (result != 0) return level.reversed ? -result : result;
+						}
+						return (vint)0;
+					};
+
+					Array<vint> items(rowCount), buffer(rowCount);
+					for (vint i = 0; i < rowCount; i++)
+					{
+						items[i] = i;
+					}
+
+					// sorters that are not key sorters could be implemented in Workflow, they are only called in the UI thread
+					if (rowCount < ParallelSortThreshold || !keysOnly)
+					{
+						MergeSortRows(&items[0], &buffer[0], rowCount, orderer);
+					}
+					else
+					{
+						vint bounds[ParallelSortChunks + 1];
+						for (vint i = 0; i <= ParallelSortChunks; i++)
+						{
+							bounds[i] = rowCount * i / ParallelSortChunks;
+						}
+
+						Semaphore semaphore;
+						semaphore.Create(0, ParallelSortChunks);
+						for (vint i = 1; i < ParallelSortChunks; i++)
+						{
+							ThreadPoolLite::QueueLambda([&, i]()
 							{
-								return sorter->Compare(itemSource->Get(a), itemSource->Get(b));
+								MergeSortRows(&items[bounds[i]], &buffer[bounds[i]], bounds[i + 1] - bounds[i], orderer);
+								semaphore.Release();
 							});
+						}
+						MergeSortRows(&items[0], &buffer[0], bounds[1], orderer);
+						for (vint i = 1; i < ParallelSortChunks; i++)
+						{
+							semaphore.Wait();
+						}
+
+						vint* source = &items[0];
+						vint* target = &buffer[0];
+						for (vint width = 1; width < ParallelSortChunks; width *= 2)
+						{
+							vint queued = 0;
+							for (vint i = width * 2; i < ParallelSortChunks; i += width * 2)
+							{
+								vint middle = i + width < ParallelSortChunks ? i + width : ParallelSortChunks;
+								vint end = i + width * 2 < ParallelSortChunks ? i + width * 2 : ParallelSortChunks;
+								ThreadPoolLite::QueueLambda([&, i, middle, end, source, target]()
+								{
+									MergeSortedRuns(source, target, bounds[i], bounds[middle], bounds[end], orderer);
+									semaphore.Release();
+								});
+								queued++;
+							}
+							{
+								vint middle = width < ParallelSortChunks ? width : ParallelSortChunks;
+								vint end = width * 2 < ParallelSortChunks ? width * 2 : ParallelSortChunks;
+								MergeSortedRuns(source, target, bounds[0], bounds[middle], bounds[end], orderer);
+							}
+							for (vint i = 0; i < queued; i++)
+							{
+								semaphore.Wait();
+							}
+							vint* temp = source;
+							source = target;
+							target = temp;
+						}
+
+						if (source != &items[0])
+						{
+							memcpy(&items[0], source, sizeof(vint) * rowCount);
+						}
 					}
 
-					if (invokeCallback)
+					for (vint i = 0; i < rowCount; i++)
 					{
-						NotifyAllItemsUpdate();
+						buffer[i] = virtualRowToSourceRow[items[i]];
+					}
+					for (vint i = 0; i < rowCount; i++)
+					{
+						virtualRowToSourceRow[i] = buffer[i];
+					}
+					return true;
+				}
+
+				void DataProvider::ReorderRowsIncrementally(vint start, vint count, vint newCount)
+				{
+					using namespace data_provider_sorting;
+
+					// source rows in [start, start + count) are replaced by source rows in [start, start + newCount)
+					vint delta = newCount - count;
+					auto adjustSourceRow = [=](vint sourceRow)
+					{
+						return
+							sourceRow < start ? sourceRow :
+							sourceRow < start + count ? -1 :
+							sourceRow + delta
+							;
+					};
+
+					// remaining rows are still sorted, rows with equal keys are still in the source order
+					List<vint> keptRows;
+					FOREACH(vint, sourceRow, virtualRowToSourceRow)
+					{
+						vint newSourceRow = adjustSourceRow(sourceRow);
+						if (newSourceRow != -1)
+						{
+							keptRows.Add(newSourceRow);
+						}
+					}
+
+					// rows with equal keys are ordered by source rows, which is what a stable full sorting does
+					IDataSorter* sorter = currentSorter.Obj();
+					auto orderer = [=](vint a, vint b)
+					{
+						vint result = sorter ? sorter->Compare(itemSource->Get(a), itemSource->Get(b)) : 0;
+						return result != 0 ? result : a < b ? -1 : a > b ? 1 : 0;
+					};
+
+					Array<vint> addedRows(newCount);
+					vint addedCount = 0;
+					for (vint i = start; i < start + newCount; i++)
+					{
+						if (!currentFilter || currentFilter->Filter(itemSource->Get(i)))
+						{
+							addedRows[addedCount++] = i;
+						}
+					}
+					if (addedCount > 1)
+					{
+						Array<vint> buffer(addedCount);
+						MergeSortRows(&addedRows[0], &buffer[0], addedCount, orderer);
+					}
+
+					// merge new rows into remaining rows in one pass, each new row searches only remaining rows that are not copied yet
+					Array<vint> rows(keptRows.Count() + addedCount);
+					vint kept = 0;
+					vint index = 0;
+					for (vint i = 0; i < addedCount; i++)
+					{
+						vint first = kept;
+						vint last = keptRows.Count();
+						while (first < last)
+						{
+							vint middle = first + (last - first) / 2;
+							if (orderer(addedRows[i], keptRows[middle]) < 0)
+							{
+								last = middle;
+							}
+							else
+							{
+								first = middle + 1;
+							}
+						}
+						while (kept < first)
+						{
+							rows[index++] = keptRows[kept++];
+						}
+						rows[index++] = addedRows[i];
+					}
+					while (kept < keptRows.Count())
+					{
+						rows[index++] = keptRows[kept++];
+					}
+
+					// only notify the range that is different between the old view and the new view
+					vint oldRows = virtualRowToSourceRow.Count();
+					vint newRows = rows.Count();
+					vint prefix = 0;
+					while (prefix < oldRows && prefix < newRows && adjustSourceRow(virtualRowToSourceRow[prefix]) == rows[prefix])
+					{
+						prefix++;
+					}
+					vint suffix = 0;
+					while (suffix < oldRows - prefix && suffix < newRows - prefix && adjustSourceRow(virtualRowToSourceRow[oldRows - suffix - 1]) == rows[newRows - suffix - 1])
+					{
+						suffix++;
+					}
+
+					CopyFrom(virtualRowToSourceRow, rows);
+					if (oldRows - prefix - suffix > 0 || newRows - prefix - suffix > 0)
+					{
+						InvokeOnItemModified(prefix, oldRows - prefix - suffix, newRows - prefix - suffix);
 					}
 				}
 
@@ -645,6 +1102,7 @@ DataProvider
 
 				DataProvider::~DataProvider()
 				{
+					CancelFilterTask();
 				}
 
 				Ptr<IDataFilter> DataProvider::GetAdditionalFilter()
@@ -656,7 +1114,17 @@ DataProvider
 				{
 					additionalFilter = value;
 					RebuildFilter();
-					ReorderRows(true);
+					ReorderRowsInBackground();
+				}
+
+				bool DataProvider::GetFilterInBackground()
+				{
+					return filterInBackground;
+				}
+
+				void DataProvider::SetFilterInBackground(bool value)
+				{
+					filterInBackground = value;
 				}
 
 				// ===================== GuiListControl::IItemProvider =====================
@@ -923,6 +1391,16 @@ GuiBindableDataGrid
 				dataProvider->SetAdditionalFilter(value);
 			}
 
+			bool GuiBindableDataGrid::GetFilterInBackground()
+			{
+				return dataProvider->GetFilterInBackground();
+			}
+
+			void GuiBindableDataGrid::SetFilterInBackground(bool value)
+			{
+				dataProvider->SetFilterInBackground(value);
+			}
+
 			ItemProperty<Ptr<GuiImageData>> GuiBindableDataGrid::GetLargeImageProperty()
 			{
 				return dataProvider->largeImageProperty;
@@ -139,10 +139,64 @@ Sorter Extensions
 
 					void												SetCallback(IDataProcessorCallback* value)override;
 				};
+
+				/// <summary>A pre-computed sort key for a row. Keys are compared by the integer, then by the number, and then by the text.</summary>
+				struct DataSortKey
+				{
+					/// <summary>The integer part of the key.</summary>
+					vint64_t											integer = 0;
+					/// <summary>The floating point part of the key.</summary>
+					double												number = 0;
+					/// <summary>The text part of the key.</summary>
+					WString												text;
+
+					/// <summary>Compare two keys.</summary>
+					/// <returns>Returns the order of the two keys.</returns>
+					/// <param name="key1">The first key.</param>
+					/// <param name="key2">The second key.</param>
+					static vint											Compare(const DataSortKey& key1, const DataSortKey& key2);
+				};
+
+				/// <summary>
+				/// Base class for <see cref="IDataSorter"/> whose order is decided by a key computed from each row.
+				/// <see cref="DataProvider"/> computes keys only once for each row before sorting. When all sub sorters of the current sorter are key sorters, large lists are sorted in parallel.
+				/// </summary>
+				class DataKeySorterBase : public DataSorterBase, public Description<DataKeySorterBase>
+				{
+				public:
+					/// <summary>Compute the sort key for a row. This function is called in the UI thread.</summary>
+					/// <param name="row">The row.</param>
+					/// <param name="key">The sort key to fill.</param>
+					virtual void										GetSortKey(const description::Value& row, DataSortKey& key) = 0;
+
+					vint												Compare(const description::Value& row1, const description::Value& row2)override;
+				};
+
+				/// <summary>A <see cref="DataKeySorterBase"/> that computes keys using a property. It could be used in Workflow scripts and GacUI XML resources.</summary>
+				class DataKeySorter : public DataKeySorterBase, public Description<DataKeySorter>
+				{
+				protected:
+					ItemProperty<DataSortKey>							keyProperty;
+				public:
+					/// <summary>Create the sorter.</summary>
+					DataKeySorter();
+
+					/// <summary>Get the property to compute the sort key from a row.</summary>
+					/// <returns>The property.</returns>
+					ItemProperty<DataSortKey>							GetKeyProperty();
+					/// <summary>Set the property to compute the sort key from a row.</summary>
+					/// <param name="value">The property.</param>
+					void												SetKeyProperty(const ItemProperty<DataSortKey>& value);
+
+					void												GetSortKey(const description::Value& row, DataSortKey& key)override;
+				};
+
+				class DataProvider;
 				
 				/// <summary>A multi-level <see cref="IDataSorter"/>.</summary>
 				class DataMultipleSorter : public DataSorterBase, public Description<DataMultipleSorter>
 				{
+					friend class DataProvider;
 				protected:
 					Ptr<IDataSorter>							leftSorter;
 					Ptr<IDataSorter>							rightSorter;
@@ -165,6 +219,7 @@ Sorter Extensions
 				/// <summary>A reverse order <see cref="IDataSorter"/>.</summary>
 				class DataReverseSorter : public DataSorterBase, public Description<DataReverseSorter>
 				{
+					friend class DataProvider;
 				protected:
 					Ptr<IDataSorter>							sorter;
 				public:
@@ -335,6 +390,27 @@ DataProvider
 					friend class DataColumns;
 					friend class controls::GuiBindableDataGrid;
 				protected:
+					class FilterTask : public Object
+					{
+					public:
+						volatile bool										cancelled = false;
+						Ptr<IDataFilter>									filter;
+						Ptr<collections::Array<description::Value>>			rows;
+						collections::List<vint>								filteredRows;
+
+						void												Run();
+					};
+
+					struct SortLevel
+					{
+						IDataSorter*										sorter = nullptr;
+						DataKeySorterBase*									keySorter = nullptr;
+						bool												reversed = false;
+
+						bool operator==(const SortLevel& value)const { return sorter == value.sorter && reversed == value.reversed; }
+						bool operator!=(const SortLevel& value)const { return !(*this == value); }
+					};
+
 					ListViewDataColumns										dataColumns;
 					DataColumns												columns;
 					ListViewColumnItemArranger::IColumnItemViewCallback*	columnItemViewCallback = nullptr;
@@ -345,6 +421,9 @@ DataProvider
 					Ptr<IDataFilter>										currentFilter;
 					Ptr<IDataSorter>										currentSorter;
 					collections::List<vint>									virtualRowToSourceRow;
+					bool													filterInBackground = false;
+					Ptr<FilterTask>											filterTask;
+					Ptr<collections::Array<description::Value>>				itemSourceSnapshot;
 
 					void													NotifyAllItemsUpdate()override;
 					void													NotifyAllColumnsUpdate()override;
@@ -355,6 +434,14 @@ DataProvider
 
 					void													RebuildFilter();
 					void													ReorderRows(bool invokeCallback);
+					void													ReorderRowsInBackground();
+					Ptr<FilterTask>											CreateFilterTask();
+					void													PublishFilterTask(Ptr<FilterTask> task);
+					void													CancelFilterTask();
+					void													SortRows();
+					void													ReorderRowsIncrementally(vint start, vint count, vint newCount);
+					void													CollectSortLevels(IDataSorter* sorter, bool reversed, collections::List<SortLevel>& levels);
+					bool													SortRowsByKeys();
 
 				public:
 					ItemProperty<Ptr<GuiImageData>>							largeImageProperty;
@@ -373,6 +460,8 @@ DataProvider
 					
 					Ptr<IDataFilter>									GetAdditionalFilter();
 					void												SetAdditionalFilter(Ptr<IDataFilter> value);
+					bool												GetFilterInBackground();
+					void												SetFilterInBackground(bool value);
 
 					// ===================== GuiListControl::IItemProvider =====================
 
@@ -453,6 +542,17 @@ GuiBindableDataGrid
 				/// <param name="value">The additional filter.</param>
 				void												SetAdditionalFilter(Ptr<list::IDataFilter> value);
 
+				/// <summary>Test if filters are evaluated in a background thread.</summary>
+				/// <returns>Returns true if filters are evaluated in a background thread.</returns>
+				bool												GetFilterInBackground();
+				/// <summary>
+				/// Set if filters are evaluated in a background thread.
+				/// When a filter is changed, rows are filtered in a background thread, and the grid keeps displaying the previous rows until the result is ready.
+				/// A filter change cancels the evaluation for the previous one. All filters should be safe to call in any thread when this is enabled.
+				/// </summary>
+				/// <param name="value">Set to true to evaluate filters in a background thread.</param>
+				void												SetFilterInBackground(bool value);
+
 				/// <summary>Large image property name changed event.</summary>
 				compositions::GuiNotifyEvent						LargeImagePropertyChanged;
 				/// <summary>Small image property name changed event.</summary>
@@ -63,10 +63,11 @@ RangedItemArrangerBase
 					if (backgroundButton)
 					{
 						itemStyle->SetAlignmentToParent(Margin(0, 0, 0, 0));
-						itemStyle->SelectedChanged.AttachLambda([=](GuiGraphicsComposition* sender, GuiEventArgs& arguments)
+						auto handler = itemStyle->SelectedChanged.AttachLambda([=](GuiGraphicsComposition* sender, GuiEventArgs& arguments)
 						{
 							backgroundButton->SetSelected(itemStyle->GetSelected());
 						});
+						backgroundHandlers.Add(itemStyle, handler);
 						backgroundButton->GetContainerComposition()->AddChild(itemStyle);
 					}
 					return { itemStyle, backgroundButton };
@@ -74,6 +75,13 @@ RangedItemArrangerBase
 
 				void RangedItemArrangerBase::DeleteStyle(ItemStyleRecord style)
 				{
+					vint index = backgroundHandlers.Keys().IndexOf(style.key);
+					if (index != -1)
+					{
+						// the item template may be recycled and outlive the background button
+						style.key->SelectedChanged.Detach(backgroundHandlers.Values()[index]);
+						backgroundHandlers.Remove(style.key);
+					}
 					callback->ReleaseItem(style.key);
 					if (style.value)
 					{
@@ -520,6 +528,355 @@ FixedHeightItemArranger
 					return expectedSize;
 				}
 
+/***********************************************************************
+VariableHeightItemArranger
+***********************************************************************/
+
+				void VariableHeightItemArranger::ResetItemHeights(vint count)
+				{
+					itemHeights.Resize(count);
+					for (vint i = 0; i < count; i++)
+					{
+						itemHeights[i] = -1;
+					}
+					BuildItemHeightTrees();
+				}
+
+				void VariableHeightItemArranger::BuildItemHeightTrees()
+				{
+					// trees are 1-based, node i stores the sum of items in [i - lowbit(i), i)
+					vint count = itemHeights.Count();
+					measuredHeightTree.Resize(count + 1);
+					measuredCountTree.Resize(count + 1);
+					measuredHeightTree[0] = 0;
+					measuredCountTree[0] = 0;
+					measuredHeight = 0;
+					measuredCount = 0;
+
+					for (vint i = 0; i < count; i++)
+					{
+						vint height = itemHeights[i];
+						if (height == -1)
+						{
+							measuredHeightTree[i + 1] = 0;
+							measuredCountTree[i + 1] = 0;
+						}
+						else
+						{
+							measuredHeightTree[i + 1] = height;
+							measuredCountTree[i + 1] = 1;
+							measuredHeight += height;
+							measuredCount++;
+						}
+					}
+
+					for (vint i = 1; i <= count; i++)
+					{
+						vint parent = i + (i & -i);
+						if (parent <= count)
+						{
+							measuredHeightTree[parent] += measuredHeightTree[i];
+							measuredCountTree[parent] += measuredCountTree[i];
+						}
+					}
+				}
+
+				void VariableHeightItemArranger::UpdateItemHeight(vint itemIndex, vint height)
+				{
+					vint oldHeight = itemHeights[itemIndex];
+					if (oldHeight == height) return;
+					itemHeights[itemIndex] = height;
+
+					vint deltaHeight = (height == -1 ? 0 : height) - (oldHeight == -1 ? 0 : oldHeight);
+					vint deltaCount = (height == -1 ? 0 : 1) - (oldHeight == -1 ? 0 : 1);
+					measuredHeight += deltaHeight;
+					measuredCount += deltaCount;
+
+					vint count = itemHeights.Count();
+					for (vint i = itemIndex + 1; i <= count; i += i & -i)
+					{
+						measuredHeightTree[i] += deltaHeight;
+						measuredCountTree[i] += deltaCount;
+					}
+					pim_heightChanged = true;
+				}
+
+				bool VariableHeightItemArranger::UpdateEstimatedHeight()
+				{
+					if (measuredCount == 0) return false;
+					vint height = (measuredHeight + measuredCount / 2) / measuredCount;
+					if (height < 1) height = 1;
+					if (estimatedHeight == height) return false;
+					estimatedHeight = height;
+					return true;
+				}
+
+				vint VariableHeightItemArranger::GetItemHeight(vint itemIndex)
+				{
+					vint height = itemHeights[itemIndex];
+					return height == -1 ? estimatedHeight : height;
+				}
+
+				vint VariableHeightItemArranger::GetItemOffset(vint itemIndex)
+				{
+					vint height = 0;
+					vint count = 0;
+					for (vint i = itemIndex; i > 0; i -= i & -i)
+					{
+						height += measuredHeightTree[i];
+						count += measuredCountTree[i];
+					}
+					return height + (itemIndex - count) * estimatedHeight;
+				}
+
+				vint VariableHeightItemArranger::GetItemIndexFromOffset(vint offset)
+				{
+					vint count = itemHeights.Count();
+					if (count == 0 || offset < 0) return 0;
+
+					vint step = 1;
+					while (step * 2 <= count)
+					{
+						step *= 2;
+					}
+
+					// find the number of leading items that end before or at the offset
+					vint index = 0;
+					for (; step > 0; step /= 2)
+					{
+						vint node = index + step;
+						if (node <= count)
+						{
+							vint height = measuredHeightTree[node] + (step - measuredCountTree[node]) * estimatedHeight;
+							if (height <= offset)
+							{
+								index = node;
+								offset -= height;
+							}
+						}
+					}
+					return index < count ? index : count - 1;
+				}
+
+				void VariableHeightItemArranger::BeginPlaceItem(bool forMoving, Rect newBounds, vint& newStartIndex)
+				{
+					if (forMoving)
+					{
+						pim_heightChanged = false;
+						newStartIndex = GetItemIndexFromOffset(newBounds.Top());
+					}
+				}
+
+				void VariableHeightItemArranger::PlaceItem(bool forMoving, vint index, ItemStyleRecord style, Rect viewBounds, Rect& bounds, Margin& alignmentToParent)
+				{
+					if (forMoving)
+					{
+						UpdateItemHeight(index, callback->GetStylePreferredSize(GetStyleBounds(style)).y);
+					}
+					alignmentToParent = Margin(0, -1, 0, -1);
+					bounds = Rect(Point(0, GetItemOffset(index)), Size(0, GetItemHeight(index)));
+				}
+
+				bool VariableHeightItemArranger::IsItemOutOfViewBounds(vint index, ItemStyleRecord style, Rect bounds, Rect viewBounds)
+				{
+					return bounds.Top() >= viewBounds.Bottom();
+				}
+
+				bool VariableHeightItemArranger::EndPlaceItem(bool forMoving, Rect newBounds, vint newStartIndex)
+				{
+					if (forMoving)
+					{
+						// only items before the first visible item are moved by a new estimated height
+						vint oldTop = GetItemOffset(newStartIndex);
+						if (UpdateEstimatedHeight())
+						{
+							vint offset = GetItemOffset(newStartIndex) - oldTop;
+							if (offset != 0)
+							{
+								callback->SetViewLocation(Point(0, newBounds.Top() + offset));
+							}
+							return true;
+						}
+						return pim_heightChanged;
+					}
+					return false;
+				}
+
+				void VariableHeightItemArranger::InvalidateItemSizeCache()
+				{
+					ResetItemHeights(itemProvider ? itemProvider->Count() : 0);
+				}
+
+				Size VariableHeightItemArranger::OnCalculateTotalSize()
+				{
+					return Size(0, GetItemOffset(itemHeights.Count()));
+				}
+
+				VariableHeightItemArranger::VariableHeightItemArranger()
+				{
+				}
+
+				VariableHeightItemArranger::~VariableHeightItemArranger()
+				{
+				}
+
+				void VariableHeightItemArranger::OnItemModified(vint start, vint count, vint newCount)
+				{
+					vint oldItemCount = itemHeights.Count();
+					vint itemCount = itemProvider ? itemProvider->Count() : 0;
+					if (start < 0 || count < 0 || start + count > oldItemCount || oldItemCount - count + newCount != itemCount)
+					{
+						ResetItemHeights(itemCount);
+					}
+					else if (count != newCount)
+					{
+						// move heights of following items and forget heights of new items, the trees are rebuilt in O(n)
+						vint moveCount = oldItemCount - start - count;
+						if (newCount > count)
+						{
+							itemHeights.Resize(itemCount);
+							for (vint i = moveCount - 1; i >= 0; i--)
+							{
+								itemHeights[start + newCount + i] = itemHeights[start + count + i];
+							}
+						}
+						else
+						{
+							for (vint i = 0; i < moveCount; i++)
+							{
+								itemHeights[start + newCount + i] = itemHeights[start + count + i];
+							}
+							itemHeights.Resize(itemCount);
+						}
+
+						for (vint i = 0; i < newCount; i++)
+						{
+							itemHeights[start + i] = -1;
+						}
+						BuildItemHeightTrees();
+					}
+					else if (!itemProvider->IsEditing())
+					{
+						for (vint i = 0; i < newCount; i++)
+						{
+							UpdateItemHeight(start + i, -1);
+						}
+					}
+					RangedItemArrangerBase::OnItemModified(start, count, newCount);
+				}
+
+				vint VariableHeightItemArranger::FindItem(vint itemIndex, compositions::KeyDirection key)
+				{
+					vint count = itemProvider->Count();
+					if (count == 0) return -1;
+					switch (key)
+					{
+					case KeyDirection::Up:
+						itemIndex--;
+						break;
+					case KeyDirection::Down:
+						itemIndex++;
+						break;
+					case KeyDirection::Home:
+						itemIndex = 0;
+						break;
+					case KeyDirection::End:
+						itemIndex = count;
+						break;
+					case KeyDirection::PageUp:
+					case KeyDirection::PageDown:
+						{
+							if (itemIndex < 0) itemIndex = 0;
+							else if (itemIndex >= count) itemIndex = count - 1;
+
+							vint offset = GetItemOffset(itemIndex);
+							if (key == KeyDirection::PageUp)
+							{
+								vint newIndex = GetItemIndexFromOffset(offset - viewBounds.Height());
+								itemIndex = newIndex < itemIndex ? newIndex : itemIndex - 1;
+							}
+							else
+							{
+								vint newIndex = GetItemIndexFromOffset(offset + viewBounds.Height());
+								itemIndex = newIndex > itemIndex ? newIndex : itemIndex + 1;
+							}
+						}
+						break;
+					default:
+						return -1;
+					}
+
+					if (itemIndex < 0) return 0;
+					else if (itemIndex >= count) return count - 1;
+					else return itemIndex;
+				}
+
+				bool VariableHeightItemArranger::EnsureItemVisible(vint itemIndex)
+				{
+					if (callback)
+					{
+						if (itemIndex < 0 || itemIndex >= itemProvider->Count())
+						{
+							return false;
+						}
+						while (true)
+						{
+							vint top = GetItemOffset(itemIndex);
+							vint bottom = top + GetItemHeight(itemIndex);
+
+							if (viewBounds.Height() < bottom - top)
+							{
+								if (viewBounds.Top() < bottom && top < viewBounds.Bottom())
+								{
+									break;
+								}
+							}
+
+							Point location = viewBounds.LeftTop();
+							if (top < viewBounds.Top())
+							{
+								location.y = top;
+							}
+							else if (viewBounds.Bottom() < bottom)
+							{
+								location.y = bottom - viewBounds.Height();
+							}
+							else
+							{
+								break;
+							}
+
+							// measuring the item may move it, stop if the view could not be scrolled any further
+							if (location == viewBounds.LeftTop())
+							{
+								break;
+							}
+							callback->SetViewLocation(location);
+						}
+						return true;
+					}
+					return false;
+				}
+
+				Size VariableHeightItemArranger::GetAdoptedSize(Size expectedSize)
+				{
+					if (itemProvider)
+					{
+						vint count = itemHeights.Count();
+						vint totalHeight = GetItemOffset(count);
+						if (totalHeight <= expectedSize.y)
+						{
+							return Size(expectedSize.x, totalHeight);
+						}
+
+						vint index = GetItemIndexFromOffset(expectedSize.y);
+						vint top = GetItemOffset(index);
+						vint bottom = top + GetItemHeight(index);
+						return Size(expectedSize.x, bottom - expectedSize.y < expectedSize.y - top ? bottom : top);
+					}
+					return expectedSize;
+				}
+
 /***********************************************************************
 FixedSizeMultiColumnItemArranger
 ***********************************************************************/
@@ -30,6 +30,7 @@ Predefined ItemArranger
 				protected:
 					using ItemStyleRecord = collections::Pair<GuiListControl::ItemStyle*, GuiSelectableButton*>;
 					typedef collections::List<ItemStyleRecord>	StyleList;
+					typedef collections::Dictionary<GuiListControl::ItemStyle*, Ptr<compositions::IGuiGraphicsEventHandler>>	BackgroundHandlerMap;
 
 					GuiListControl*								listControl = nullptr;
 					GuiListControl::IItemArrangerCallback*		callback = nullptr;
@@ -39,6 +40,7 @@ Predefined ItemArranger
 					Rect										viewBounds;
 					vint										startIndex = 0;
 					StyleList									visibleStyles;
+					BackgroundHandlerMap						backgroundHandlers;
 
 				protected:
 
@@ -104,6 +106,46 @@ Predefined ItemArranger
 					Size										GetAdoptedSize(Size expectedSize)override;
 				};
 
+				/// <summary>Variable height item arranger. This arranger lists all item with their own minimum heights. Heights of items that have never been displayed are estimated using the average height of displayed items. Offsets of items are calculated using binary indexed trees, so that finding an item from a position takes O(log n) time.</summary>
+				class VariableHeightItemArranger : public RangedItemArrangerBase, public Description<VariableHeightItemArranger>
+				{
+					typedef collections::Array<vint>			HeightArray;
+				private:
+					bool										pim_heightChanged = false;
+
+				protected:
+					HeightArray									itemHeights;
+					HeightArray									measuredHeightTree;
+					HeightArray									measuredCountTree;
+					vint										measuredHeight = 0;
+					vint										measuredCount = 0;
+					vint										estimatedHeight = 1;
+
+					void										ResetItemHeights(vint count);
+					void										BuildItemHeightTrees();
+					void										UpdateItemHeight(vint itemIndex, vint height);
+					bool										UpdateEstimatedHeight();
+					vint										GetItemHeight(vint itemIndex);
+					vint										GetItemOffset(vint itemIndex);
+					vint										GetItemIndexFromOffset(vint offset);
+
+					void										BeginPlaceItem(bool forMoving, Rect newBounds, vint& newStartIndex)override;
+					void										PlaceItem(bool forMoving, vint index, ItemStyleRecord style, Rect viewBounds, Rect& bounds, Margin& alignmentToParent)override;
+					bool										IsItemOutOfViewBounds(vint index, ItemStyleRecord style, Rect bounds, Rect viewBounds)override;
+					bool										EndPlaceItem(bool forMoving, Rect newBounds, vint newStartIndex)override;
+					void										InvalidateItemSizeCache()override;
+					Size										OnCalculateTotalSize()override;
+				public:
+					/// <summary>Create the arranger.</summary>
+					VariableHeightItemArranger();
+					~VariableHeightItemArranger();
+
+					void										OnItemModified(vint start, vint count, vint newCount)override;
+					vint										FindItem(vint itemIndex, compositions::KeyDirection key)override;
+					bool										EnsureItemVisible(vint itemIndex)override;
+					Size										GetAdoptedSize(Size expectedSize)override;
+				};
+
 				/// <summary>Fixed size multiple columns item arranger. This arranger adjust all items in multiple lines with the same size. The width is the maximum width of all minimum widths of displayed items. The same to height.</summary>
 				class FixedSizeMultiColumnItemArranger : public RangedItemArrangerBase, public Description<FixedSizeMultiColumnItemArranger>
 				{
@@ -33,6 +33,17 @@ GuiListControl::ItemCallback
 				return style;
 			}
 
+			void GuiListControl::ItemCallback::DeleteRecycledStyles(vint keepCount)
+			{
+				while (recycledStyles.Count() > keepCount)
+				{
+					vint index = recycledStyles.Count() - 1;
+					auto style = recycledStyles[index];
+					recycledStyles.RemoveAt(index);
+					SafeDeleteComposition(style);
+				}
+			}
+
 			void GuiListControl::ItemCallback::OnStyleBoundsChanged(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments)
 			{
 				listControl->CalculateView();
@@ -56,6 +67,42 @@ GuiListControl::ItemCallback
 					SafeDeleteComposition(style);
 				}
 				installedStyles.Clear();
+				expiredStyles.Clear();
+				DeleteRecycledStyles(0);
+			}
+
+			void GuiListControl::ItemCallback::ExpireStyles()
+			{
+				DeleteRecycledStyles(0);
+				for (vint i = 0; i < installedStyles.Count(); i++)
+				{
+					auto style = installedStyles.Keys()[i];
+					if (!expiredStyles.Contains(style))
+					{
+						expiredStyles.Add(style);
+					}
+				}
+			}
+
+			vint GuiListControl::ItemCallback::GetRecycleLimit()
+			{
+				return recycleLimit;
+			}
+
+			void GuiListControl::ItemCallback::SetRecycleLimit(vint value)
+			{
+				recycleLimit = value < 0 ? 0 : value;
+				DeleteRecycledStyles(recycleLimit);
+			}
+
+			vint GuiListControl::ItemCallback::GetRecycleHitCount()
+			{
+				return recycleHitCount;
+			}
+
+			vint GuiListControl::ItemCallback::GetRecycleMissCount()
+			{
+				return recycleMissCount;
 			}
 
 			void GuiListControl::ItemCallback::OnAttached(IItemProvider* provider)
@@ -73,7 +120,20 @@ GuiListControl::ItemCallback
 				CHECK_ERROR(0 <= itemIndex && itemIndex < itemProvider->Count(), L"GuiListControl::ItemCallback::RequestItem(vint)#Index out of range.");
 				CHECK_ERROR(listControl->itemStyleProperty, L"GuiListControl::ItemCallback::RequestItem(vint)#SetItemTemplate function should be called before adding items to the list control.");
 
-				auto style = listControl->itemStyleProperty(itemProvider->GetBindingValue(itemIndex));
+				ItemStyle* style = nullptr;
+				if (recycledStyles.Count() > 0)
+				{
+					vint index = recycledStyles.Count() - 1;
+					style = recycledStyles[index];
+					recycledStyles.RemoveAt(index);
+					recycleHitCount++;
+				}
+				else
+				{
+					style = listControl->itemStyleProperty(itemProvider->GetBindingValue(itemIndex));
+					recycleMissCount++;
+				}
+
 				auto handler = InstallStyle(style, itemIndex, itemComposition);
 				installedStyles.Add(style, handler);
 				return style;
@@ -86,7 +146,22 @@ GuiListControl::ItemCallback
 				{
 					auto style = UninstallStyle(index);
 					installedStyles.Remove(style);
-					SafeDeleteComposition(style);
+					bool expired = expiredStyles.Remove(style);
+					if (!expired && recycledStyles.Count() < recycleLimit && style->GetRecyclable())
+					{
+						// the arranger may put the style in another composition that is about to be deleted
+						if (auto parent = style->GetParent())
+						{
+							parent->RemoveChild(style);
+						}
+						// arrangers measure a style using its bounds, which should not be inherited from a previous item
+						style->SetBounds(Rect());
+						recycledStyles.Add(style);
+					}
+					else
+					{
+						SafeDeleteComposition(style);
+					}
 				}
 			}
 
@@ -144,6 +219,8 @@ GuiListControl
 			{
 				if (itemArranger)
 				{
+					// item templates may use sub templates from the control template
+					callback->ExpireStyles();
 					itemArranger->ReloadVisibleStyles();
 					CalculateView();
 				}
@@ -503,6 +580,26 @@ GuiListControl
 				}
 			}
 
+			vint GuiListControl::GetItemTemplateRecycleLimit()
+			{
+				return callback->GetRecycleLimit();
+			}
+
+			void GuiListControl::SetItemTemplateRecycleLimit(vint value)
+			{
+				callback->SetRecycleLimit(value);
+			}
+
+			vint GuiListControl::GetItemTemplateRecycleHitCount()
+			{
+				return callback->GetRecycleHitCount();
+			}
+
+			vint GuiListControl::GetItemTemplateRecycleMissCount()
+			{
+				return callback->GetRecycleMissCount();
+			}
+
 /***********************************************************************
 GuiSelectableListControl
 ***********************************************************************/
@@ -202,15 +202,26 @@ List Control
 					GuiListControl*								listControl = nullptr;
 					IItemProvider*								itemProvider = nullptr;
 					InstalledStyleMap							installedStyles;
+					StyleList									recycledStyles;
+					collections::SortedList<ItemStyle*>			expiredStyles;
+					vint										recycleLimit = 32;
+					vint										recycleHitCount = 0;
+					vint										recycleMissCount = 0;
 
 					Ptr<BoundsChangedHandler>					InstallStyle(ItemStyle* style, vint itemIndex, compositions::GuiBoundsComposition* itemComposition);
 					ItemStyle*									UninstallStyle(vint index);
+					void										DeleteRecycledStyles(vint keepCount);
 					void										OnStyleBoundsChanged(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments);
 				public:
 					ItemCallback(GuiListControl* _listControl);
 					~ItemCallback();
 
 					void										ClearCache();
+					void										ExpireStyles();
+					vint										GetRecycleLimit();
+					void										SetRecycleLimit(vint value);
+					vint										GetRecycleHitCount();
+					vint										GetRecycleMissCount();
 
 					void										OnAttached(IItemProvider* provider)override;
 					void										OnItemModified(vint start, vint count, vint newCount)override;
@@ -360,6 +371,18 @@ List Control
 				/// <summary>Set if the list control displays predefined item background.</summary>
 				/// <param name="value">Set to true to display item background.</param>
 				void											SetDisplayItemBackground(bool value);
+				/// <summary>Get the maximum number of released item templates that are kept for displaying other items. Only item templates that are recyclable are kept, see [M:vl.presentation.templates.GuiListItemTemplate.Initialize] for details. Kept item templates are deleted when the item template property, the arranger or the control template is changed.</summary>
+				/// <returns>The maximum number of kept item templates.</returns>
+				vint											GetItemTemplateRecycleLimit();
+				/// <summary>Set the maximum number of released item templates that are kept for displaying other items.</summary>
+				/// <param name="value">The maximum number of kept item templates. Set to 0 to disable recycling.</param>
+				void											SetItemTemplateRecycleLimit(vint value);
+				/// <summary>Get the number of item requests that are fulfilled by a recycled item template.</summary>
+				/// <returns>The number of item requests.</returns>
+				vint											GetItemTemplateRecycleHitCount();
+				/// <summary>Get the number of item requests that create a new item template.</summary>
+				/// <returns>The number of item requests.</returns>
+				vint											GetItemTemplateRecycleMissCount();
 			};
 
 /***********************************************************************
@@ -31,6 +31,28 @@ DefaultListViewItemTemplate
 BigIconListViewItemTemplate
 ***********************************************************************/
 
+				void BigIconListViewItemTemplate::OnRefresh()
+				{
+					if (auto listView = dynamic_cast<GuiVirtualListView*>(listControl))
+					{
+						auto itemIndex = GetIndex();
+						if (auto view = dynamic_cast<IListViewItemView*>(listView->GetItemProvider()->RequestView(IListViewItemView::Identifier)))
+						{
+							auto imageData = view->GetLargeImage(itemIndex);
+							if (imageData)
+							{
+								image->SetImage(imageData->GetImage(), imageData->GetFrameIndex());
+							}
+							else
+							{
+								image->SetImage(nullptr);
+							}
+							text->SetText(view->GetText(itemIndex));
+							text->SetColor(listView->GetControlTemplateObject()->GetPrimaryTextColor());
+						}
+					}
+				}
+
 				void BigIconListViewItemTemplate::OnInitialize()
 				{
 					DefaultListViewItemTemplate::OnInitialize();
@@ -70,24 +92,7 @@ BigIconListViewItemTemplate
 						}
 					}
 
-					if (auto listView = dynamic_cast<GuiVirtualListView*>(listControl))
-					{
-						auto itemIndex = GetIndex();
-						if (auto view = dynamic_cast<IListViewItemView*>(listView->GetItemProvider()->RequestView(IListViewItemView::Identifier)))
-						{
-							auto imageData = view->GetLargeImage(itemIndex);
-							if (imageData)
-							{
-								image->SetImage(imageData->GetImage(), imageData->GetFrameIndex());
-							}
-							else
-							{
-								image->SetImage(nullptr);
-							}
-							text->SetText(view->GetText(itemIndex));
-							text->SetColor(listView->GetControlTemplateObject()->GetPrimaryTextColor());
-						}
-					}
+					OnRefresh();
 
 					FontChanged.AttachMethod(this, &BigIconListViewItemTemplate::OnFontChanged);
 
@@ -101,6 +106,7 @@ BigIconListViewItemTemplate
 
 				BigIconListViewItemTemplate::BigIconListViewItemTemplate()
 				{
+					SetRecyclable(true);
 				}
 
 				BigIconListViewItemTemplate::~BigIconListViewItemTemplate()
@@ -111,6 +117,28 @@ BigIconListViewItemTemplate
 SmallIconListViewItemTemplate
 ***********************************************************************/
 
+				void SmallIconListViewItemTemplate::OnRefresh()
+				{
+					if (auto listView = dynamic_cast<GuiVirtualListView*>(listControl))
+					{
+						auto itemIndex = GetIndex();
+						if (auto view = dynamic_cast<IListViewItemView*>(listView->GetItemProvider()->RequestView(IListViewItemView::Identifier)))
+						{
+							auto imageData = view->GetSmallImage(itemIndex);
+							if (imageData)
+							{
+								image->SetImage(imageData->GetImage(), imageData->GetFrameIndex());
+							}
+							else
+							{
+								image->SetImage(nullptr);
+							}
+							text->SetText(view->GetText(itemIndex));
+							text->SetColor(listView->GetControlTemplateObject()->GetPrimaryTextColor());
+						}
+					}
+				}
+
 				void SmallIconListViewItemTemplate::OnInitialize()
 				{
 					DefaultListViewItemTemplate::OnInitialize();
@@ -148,24 +176,7 @@ SmallIconListViewItemTemplate
 						}
 					}
 
-					if (auto listView = dynamic_cast<GuiVirtualListView*>(listControl))
-					{
-						auto itemIndex = GetIndex();
-						if (auto view = dynamic_cast<IListViewItemView*>(listView->GetItemProvider()->RequestView(IListViewItemView::Identifier)))
-						{
-							auto imageData = view->GetSmallImage(itemIndex);
-							if (imageData)
-							{
-								image->SetImage(imageData->GetImage(), imageData->GetFrameIndex());
-							}
-							else
-							{
-								image->SetImage(nullptr);
-							}
-							text->SetText(view->GetText(itemIndex));
-							text->SetColor(listView->GetControlTemplateObject()->GetPrimaryTextColor());
-						}
-					}
+					OnRefresh();
 
 					FontChanged.AttachMethod(this, &SmallIconListViewItemTemplate::OnFontChanged);
 
@@ -179,6 +190,7 @@ SmallIconListViewItemTemplate
 
 				SmallIconListViewItemTemplate::SmallIconListViewItemTemplate()
 				{
+					SetRecyclable(true);
 				}
 
 				SmallIconListViewItemTemplate::~SmallIconListViewItemTemplate()
@@ -189,6 +201,28 @@ SmallIconListViewItemTemplate
 ListListViewItemTemplate
 ***********************************************************************/
 
+				void ListListViewItemTemplate::OnRefresh()
+				{
+					if (auto listView = dynamic_cast<GuiVirtualListView*>(listControl))
+					{
+						auto itemIndex = GetIndex();
+						if (auto view = dynamic_cast<IListViewItemView*>(listView->GetItemProvider()->RequestView(IListViewItemView::Identifier)))
+						{
+							auto imageData = view->GetSmallImage(itemIndex);
+							if (imageData)
+							{
+								image->SetImage(imageData->GetImage(), imageData->GetFrameIndex());
+							}
+							else
+							{
+								image->SetImage(nullptr);
+							}
+							text->SetText(view->GetText(itemIndex));
+							text->SetColor(listView->GetControlTemplateObject()->GetPrimaryTextColor());
+						}
+					}
+				}
+
 				void ListListViewItemTemplate::OnInitialize()
 				{
 					DefaultListViewItemTemplate::OnInitialize();
@@ -225,24 +259,7 @@ ListListViewItemTemplate
 						}
 					}
 
-					if (auto listView = dynamic_cast<GuiVirtualListView*>(listControl))
-					{
-						auto itemIndex = GetIndex();
-						if (auto view = dynamic_cast<IListViewItemView*>(listView->GetItemProvider()->RequestView(IListViewItemView::Identifier)))
-						{
-							auto imageData = view->GetSmallImage(itemIndex);
-							if (imageData)
-							{
-								image->SetImage(imageData->GetImage(), imageData->GetFrameIndex());
-							}
-							else
-							{
-								image->SetImage(nullptr);
-							}
-							text->SetText(view->GetText(itemIndex));
-							text->SetColor(listView->GetControlTemplateObject()->GetPrimaryTextColor());
-						}
-					}
+					OnRefresh();
 
 					FontChanged.AttachMethod(this, &ListListViewItemTemplate::OnFontChanged);
 
@@ -256,6 +273,7 @@ ListListViewItemTemplate
 
 				ListListViewItemTemplate::ListListViewItemTemplate()
 				{
+					SetRecyclable(true);
 				}
 
 				ListListViewItemTemplate::~ListListViewItemTemplate()
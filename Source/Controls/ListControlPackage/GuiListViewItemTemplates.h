@@ -33,6 +33,7 @@ namespace vl
 					elements::GuiSolidLabelElement*			text = nullptr;
 
 					void									OnInitialize()override;
+					void									OnRefresh()override;
 					void									OnFontChanged(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments);
 				public:
 					BigIconListViewItemTemplate();
@@ -46,6 +47,7 @@ namespace vl
 					elements::GuiSolidLabelElement*			text = nullptr;
 
 					void									OnInitialize()override;
+					void									OnRefresh()override;
 					void									OnFontChanged(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments);
 				public:
 					SmallIconListViewItemTemplate();
@@ -59,6 +61,7 @@ namespace vl
 					elements::GuiSolidLabelElement*			text = nullptr;
 
 					void									OnInitialize()override;
+					void									OnRefresh()override;
 					void									OnFontChanged(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments);
 				public:
 					ListListViewItemTemplate();
@@ -123,6 +123,7 @@ DefaultTextListItemTemplate
 
 				DefaultTextListItemTemplate::DefaultTextListItemTemplate()
 				{
+					SetRecyclable(true);
 				}
 
 				DefaultTextListItemTemplate::~DefaultTextListItemTemplate()
@@ -16,42 +16,162 @@ namespace vl
 			{
 				const wchar_t* const INodeItemView::Identifier = L"vl::presentation::controls::tree::INodeItemView";
 
+/***********************************************************************
+NodeItemProvider::ChildVisibleNodeCache
+***********************************************************************/
+
+				NodeItemProvider::ChildVisibleNodeCache::ChildVisibleNodeCache(INodeProvider* node)
+				{
+					// countTree is a 1-based binary indexed tree, node i stores the sum of children in [i - lowbit(i), i)
+					vint count = node->GetChildCount();
+					countTree.Resize(count + 1);
+					countTree[0] = 0;
+					for (vint i = 0; i < count; i++)
+					{
+						INodeProvider* child = node->GetChild(i);
+						vint visibleCount = child->CalculateTotalVisibleNodes();
+						countTree[i + 1] = visibleCount;
+						totalCount += visibleCount;
+						childIndices.Add(child, i);
+						child->Release();
+					}
+
+					for (vint i = 1; i <= count; i++)
+					{
+						vint parent = i + (i & -i);
+						if (parent <= count)
+						{
+							countTree[parent] += countTree[i];
+						}
+					}
+				}
+
+				vint NodeItemProvider::ChildVisibleNodeCache::GetTotalCount()
+				{
+					return totalCount;
+				}
+
+				vint NodeItemProvider::ChildVisibleNodeCache::GetOffset(vint childIndex)
+				{
+					vint offset = 0;
+					for (vint i = childIndex; i > 0; i -= i & -i)
+					{
+						offset += countTree[i];
+					}
+					return offset;
+				}
+
+				vint NodeItemProvider::ChildVisibleNodeCache::GetChildIndex(INodeProvider* child)
+				{
+					vint index = childIndices.Keys().IndexOf(child);
+					return index == -1 ? -1 : childIndices.Values()[index];
+				}
+
+				vint NodeItemProvider::ChildVisibleNodeCache::FindChild(vint& offset)
+				{
+					if (offset < 0 || offset >= totalCount) return -1;
+					vint count = countTree.Count() - 1;
+					vint step = 1;
+					while (step * 2 <= count)
+					{
+						step *= 2;
+					}
+
+					vint index = 0;
+					for (; step > 0; step /= 2)
+					{
+						vint node = index + step;
+						if (node <= count && countTree[node] <= offset)
+						{
+							index = node;
+							offset -= countTree[node];
+						}
+					}
+					return index;
+				}
+
+				void NodeItemProvider::ChildVisibleNodeCache::UpdateCount(vint childIndex, vint delta)
+				{
+					vint count = countTree.Count() - 1;
+					for (vint i = childIndex + 1; i <= count; i += i & -i)
+					{
+						countTree[i] += delta;
+					}
+					totalCount += delta;
+				}
+
 /***********************************************************************
 NodeItemProvider
 ***********************************************************************/
 
-				INodeProvider* NodeItemProvider::GetNodeByOffset(INodeProvider* provider, vint offset)
+				NodeItemProvider::ChildVisibleNodeCache* NodeItemProvider::GetChildVisibleNodeCache(INodeProvider* node)
 				{
-					if(offset==0) return provider;
-					INodeProvider* result=0;
-					if(provider->GetExpanding() && offset>0)
+					vint index = childVisibleNodeCaches.Keys().IndexOf(node);
+					if (index != -1)
 					{
-						offset-=1;
-						vint count=provider->GetChildCount();
-						for(vint i=0;(!result && i<count);i++)
+						return childVisibleNodeCaches.Values()[index].Obj();
+					}
+					auto cache = MakePtr<ChildVisibleNodeCache>(node);
+					childVisibleNodeCaches.Add(node, cache);
+					return cache.Obj();
+				}
+
+				void NodeItemProvider::UpdateChildVisibleNodeCaches(INodeProvider* node, vint delta)
+				{
+					// the change stops affecting ancestors at the first collapsed one
+					while (delta != 0)
+					{
+						INodeProvider* parent = node->GetParent();
+						if (!parent) break;
+
+						vint index = childVisibleNodeCaches.Keys().IndexOf(parent);
+						if (index != -1)
 						{
-							INodeProvider* child=provider->GetChild(i);
-							vint visibleCount=child->CalculateTotalVisibleNodes();
-							if(offset<visibleCount)
-							{
-								result=GetNodeByOffset(child, offset);
-							}
-							else
+							auto cache = childVisibleNodeCaches.Values()[index];
+							vint childIndex = cache->GetChildIndex(node);
+							if (childIndex != -1)
 							{
-								offset-=visibleCount;
+								cache->UpdateCount(childIndex, delta);
 							}
 						}
+
+						if (!parent->GetExpanding()) break;
+						node = parent;
 					}
-					ReleaseNode(provider);
-					return result;
+				}
+
+				INodeProvider* NodeItemProvider::GetNodeByOffset(INodeProvider* provider, vint offset)
+				{
+					while (offset != 0)
+					{
+						vint childIndex = -1;
+						if (provider->GetExpanding() && offset > 0)
+						{
+							offset -= 1;
+							childIndex = GetChildVisibleNodeCache(provider)->FindChild(offset);
+						}
+
+						INodeProvider* child = childIndex == -1 ? nullptr : provider->GetChild(childIndex);
+						ReleaseNode(provider);
+						if (!child) return nullptr;
+						provider = child;
+					}
+					return provider;
 				}
 
 				void NodeItemProvider::OnAttached(INodeRootProvider* provider)
 				{
+					childVisibleNodeCaches.Clear();
 				}
 
 				void NodeItemProvider::OnBeforeItemModified(INodeProvider* parentNode, vint start, vint count, vint newCount)
 				{
+					if (count > 0)
+					{
+						// removed nodes could be deleted, cached pointers of them and their descendants are no longer valid
+						childVisibleNodeCaches.Clear();
+					}
+
 					vint offset = 0;
 					vint base=CalculateNodeVisibilityIndexInternal(parentNode);
 					if(base!=-2 && parentNode->GetExpanding())
@@ -78,6 +198,27 @@ NodeItemProvider
 						}
 					}
 
+					if (count > 0)
+					{
+						childVisibleNodeCaches.Clear();
+					}
+					else if (newCount > 0)
+					{
+						// indices of following children are changed
+						childVisibleNodeCaches.Remove(parentNode);
+						if (parentNode->GetExpanding())
+						{
+							vint delta = 0;
+							for (vint i = 0; i < newCount; i++)
+							{
+								INodeProvider* child = parentNode->GetChild(start + i);
+								delta += child->CalculateTotalVisibleNodes();
+								child->Release();
+							}
+							UpdateChildVisibleNodeCaches(parentNode, delta);
+						}
+					}
+
 					vint base=CalculateNodeVisibilityIndexInternal(parentNode);
 					if(base!=-2 && parentNode->GetExpanding())
 					{
@@ -121,27 +262,25 @@ NodeItemProvider
 
 				void NodeItemProvider::OnItemExpanded(INodeProvider* node)
 				{
+					vint visibility=node->CalculateTotalVisibleNodes();
+					UpdateChildVisibleNodeCaches(node, visibility-1);
+
 					vint base=CalculateNodeVisibilityIndexInternal(node);
 					if(base!=-2)
 					{
-						vint visibility=node->CalculateTotalVisibleNodes();
 						InvokeOnItemModified(base+1, 0, visibility-1);
 					}
 				}
 
 				void NodeItemProvider::OnItemCollapsed(INodeProvider* node)
 				{
+					// children are not changed when collapsing, their cached numbers of visible nodes are still valid
+					vint visibility=GetChildVisibleNodeCache(node)->GetTotalCount();
+					UpdateChildVisibleNodeCaches(node, -visibility);
+
 					vint base=CalculateNodeVisibilityIndexInternal(node);
 					if(base!=-2)
 					{
-						vint visibility=0;
-						vint count=node->GetChildCount();
-						for(vint i=0;i<count;i++)
-						{
-							INodeProvider* child=node->GetChild(i);
-							visibility+=child->CalculateTotalVisibleNodes();
-							child->Release();
-						}
 						InvokeOnItemModified(base+1, visibility, 0);
 					}
 				}
@@ -164,26 +303,13 @@ NodeItemProvider
 						return -2;
 					}
 
-					vint count=parent->GetChildCount();
-					for(vint i=0;i<count;i++)
+					auto cache=GetChildVisibleNodeCache(parent);
+					vint childIndex=cache->GetChildIndex(node);
+					if(childIndex==-1)
 					{
-						INodeProvider* child=parent->GetChild(i);
-						bool findResult=child==node;
-						if(findResult)
-						{
-							index++;
-						}
-						else
-						{
-							index+=child->CalculateTotalVisibleNodes();
-						}
-						child->Release();
-						if(findResult)
-						{
-							return index;
-						}
+						return -1;
 					}
-					return -1;
+					return index+cache->GetOffset(childIndex)+1;
 				}
 
 				vint NodeItemProvider::CalculateNodeVisibilityIndex(INodeProvider* node)
@@ -230,7 +356,8 @@ NodeItemProvider
 
 				vint NodeItemProvider::Count()
 				{
-					return root->GetRootNode()->CalculateTotalVisibleNodes()-1;
+					INodeProvider* rootNode=root->GetRootNode();
+					return rootNode->GetExpanding()?GetChildVisibleNodeCache(rootNode)->GetTotalCount():0;
 				}
 
 				WString NodeItemProvider::GetTextValue(vint itemIndex)
@@ -363,7 +490,7 @@ MemoryNodeProvider
 				void MemoryNodeProvider::OnChildTotalVisibleNodesChanged(vint offset)
 				{
 					totalVisibleNodeCount+=offset;
-					if(parent)
+					if(parent && parent->expanding)
 					{
 						parent->OnChildTotalVisibleNodesChanged(offset);
 					}
@@ -1135,6 +1262,7 @@ DefaultTreeItemTemplate
 
 				DefaultTreeItemTemplate::DefaultTreeItemTemplate()
 				{
+					SetRecyclable(true);
 				}
 
 				DefaultTreeItemTemplate::~DefaultTreeItemTemplate()
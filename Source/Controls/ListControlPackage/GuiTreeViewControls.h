@@ -164,10 +164,31 @@ NodeItemProvider
 				{
 					typedef collections::Dictionary<INodeProvider*, vint>			NodeIntMap;
 				protected:
+					class ChildVisibleNodeCache : public Object
+					{
+						typedef collections::HashDictionary<INodeProvider*, vint>	NodeIndexMap;
+					protected:
+						collections::Array<vint>	countTree;
+						NodeIndexMap				childIndices;
+						vint						totalCount = 0;
+
+					public:
+						ChildVisibleNodeCache(INodeProvider* node);
+
+						vint						GetTotalCount();
+						vint						GetOffset(vint childIndex);
+						vint						GetChildIndex(INodeProvider* child);
+						vint						FindChild(vint& offset);
+						void						UpdateCount(vint childIndex, vint delta);
+					};
+					typedef collections::HashDictionary<INodeProvider*, Ptr<ChildVisibleNodeCache>>	NodeCacheMap;
+
 					Ptr<INodeRootProvider>			root;
 					NodeIntMap						offsetBeforeChildModifieds;
-					
+					NodeCacheMap					childVisibleNodeCaches;
 
+					ChildVisibleNodeCache*			GetChildVisibleNodeCache(INodeProvider* node);
+					void							UpdateChildVisibleNodeCaches(INodeProvider* node, vint delta);
 					INodeProvider*					GetNodeByOffset(INodeProvider* provider, vint offset);
 					void							OnAttached(INodeRootProvider* provider)override;
 					void							OnBeforeItemModified(INodeProvider* parentNode, vint start, vint count, vint newCount)override;
@@ -47,6 +47,10 @@ Item GuiListItemTemplate
 			{
 			}
 
+			void GuiListItemTemplate::OnRefresh()
+			{
+			}
+
 			GuiListItemTemplate_PROPERTIES(GUI_TEMPLATE_PROPERTY_IMPL)
 
 			GuiListItemTemplate::GuiListItemTemplate()
@@ -71,9 +75,16 @@ Item GuiListItemTemplate
 
 			void GuiListItemTemplate::Initialize(controls::GuiListControl* _listControl)
 			{
-				CHECK_ERROR(listControl == nullptr, L"GuiListItemTemplate::Initialize(GuiListControl*)#This function can only be called once.");
-				listControl = _listControl;
-				OnInitialize();
+				if (listControl)
+				{
+					CHECK_ERROR(listControl == _listControl && GetRecyclable(), L"GuiListItemTemplate::Initialize(GuiListControl*)#This function can only be called once, unless the item template is recycled by the same list control.");
+					OnRefresh();
+				}
+				else
+				{
+					listControl = _listControl;
+					OnInitialize();
+				}
 			}
 
 /***********************************************************************
@@ -139,6 +139,7 @@ GuiListItemTemplate
 				controls::GuiListControl*	listControl = nullptr;
 
 				virtual void				OnInitialize();
+				virtual void				OnRefresh();
 			public:
 				GuiListItemTemplate();
 				~GuiListItemTemplate();
@@ -146,11 +147,17 @@ GuiListItemTemplate
 #define GuiListItemTemplate_PROPERTIES(F)\
 				F(GuiListItemTemplate, bool, Selected, false)\
 				F(GuiListItemTemplate, vint, Index, 0)\
+				F(GuiListItemTemplate, bool, Recyclable, false)\
 
 				GuiListItemTemplate_PROPERTIES(GUI_TEMPLATE_PROPERTY_DECL)
 
 					void						BeginEditListItem();
 				void						EndEditListItem();
+				/// <summary>
+				/// Initialize the item template for a list control. If a recycled item template is installed to the same list control again, this function refreshes the content instead.
+				/// An item template is recycled only when the Recyclable property is true. A recyclable item template must not depend on the value that is given to the item template property, and must update all its content in OnRefresh or in handlers of property changed events, like IndexChanged or TextChanged.
+				/// </summary>
+				/// <param name="_listControl">The list control.</param>
 				void						Initialize(controls::GuiListControl* _listControl);
 			};
 
@@ -276,6 +283,7 @@ Control Template
 #define GuiListItemTemplate_PROPERTIES(F)\
 				F(GuiListItemTemplate, bool, Selected, false)\
 				F(GuiListItemTemplate, vint, Index, 0)\
+				F(GuiListItemTemplate, bool, Recyclable, false)\
 
 /***********************************************************************
 Item Template
@@ -52,12 +52,26 @@ GuiTextBoxColorizerBase
 						if(lineIndex<colorizer->colorizedLineCount && lineIndex<colorizer->element->GetLines().GetCount())
 						{
 							TextLine& line=colorizer->element->GetLines().GetLine(lineIndex);
+							bool stateUnchanged=line.lexerFinalState==lexerState && line.contextFinalState==contextState;
 							line.lexerFinalState=lexerState;
 							line.contextFinalState=contextState;
 							for(vint i=0;i<length;i++)
 							{
 								line.att[i].colorIndex=colors[i];
 							}
+
+							if(lineIndex+1>=colorizer->reusableLineEnd)
+							{
+								colorizer->modifiedLineEnd=-1;
+								colorizer->reusableLineEnd=0;
+							}
+							else if(stateUnchanged && lineIndex>colorizer->modifiedLineEnd && lineIndex+1==colorizer->colorizedLineCount)
+							{
+								// following lines were colorized from the same state in the previous run, skip them
+								colorizer->colorizedLineCount=colorizer->reusableLineEnd;
+								colorizer->modifiedLineEnd=-1;
+								colorizer->reusableLineEnd=0;
+							}
 						}
 						delete[] text;
 						delete[] colors;
@@ -83,6 +97,8 @@ GuiTextBoxColorizerBase
 				colorizerRunningEvent.Enter();
 				colorizerRunningEvent.Leave();
 				colorizedLineCount=0;
+				modifiedLineEnd=-1;
+				reusableLineEnd=0;
 				if(!forever)
 				{
 					isFinalizing=false;
@@ -98,6 +114,8 @@ GuiTextBoxColorizerBase
 				:element(0)
 				,elementModifyLock(0)
 				,colorizedLineCount(0)
+				,modifiedLineEnd(-1)
+				,reusableLineEnd(0)
 				,isColorizerRunning(false)
 				,isFinalizing(false)
 			{
@@ -148,6 +166,30 @@ GuiTextBoxColorizerBase
 							=arguments.originalStart.row<arguments.originalEnd.row
 							?arguments.originalStart.row
 							:arguments.originalEnd.row;
+						vint originalEnd=arguments.originalEnd.row;
+						vint inputEnd=arguments.inputEnd.row;
+						vint delta=inputEnd-originalEnd;
+
+						// lines after the modified range keep their colors, until a line ends with the same state as before
+						// the line being colorized is written back only if it is before the modified line, so it is not reusable
+						vint colorizedEnd=isColorizerRunning && colorizedLineCount>0?colorizedLineCount-1:colorizedLineCount;
+						vint reusableEnd=colorizedEnd>reusableLineEnd?colorizedEnd:reusableLineEnd;
+						if(reusableEnd>originalEnd+1)
+						{
+							vint modifiedEnd=modifiedLineEnd>originalEnd?modifiedLineEnd+delta:modifiedLineEnd;
+							if(modifiedEnd<inputEnd)
+							{
+								modifiedEnd=inputEnd;
+							}
+							modifiedLineEnd=modifiedEnd;
+							reusableLineEnd=reusableEnd+delta;
+						}
+						else
+						{
+							modifiedLineEnd=-1;
+							reusableLineEnd=0;
+						}
+
 						if(colorizedLineCount>line)
 						{
 							colorizedLineCount=line;
@@ -172,6 +214,8 @@ GuiTextBoxColorizerBase
 					SPIN_LOCK(*elementModifyLock)
 					{
 						colorizedLineCount=0;
+						modifiedLineEnd=-1;
+						reusableLineEnd=0;
 						StartColorizer();
 					}
 				}
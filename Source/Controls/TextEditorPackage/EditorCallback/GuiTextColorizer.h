@@ -31,6 +31,8 @@ GuiTextBoxColorizerBase
 				elements::GuiColorizedTextElement*			element;
 				SpinLock*									elementModifyLock;
 				volatile vint								colorizedLineCount;
+				volatile vint								modifiedLineEnd;
+				volatile vint								reusableLineEnd;
 				volatile bool								isColorizerRunning;
 				volatile bool								isFinalizing;
 				SpinLock									colorizerRunningEvent;
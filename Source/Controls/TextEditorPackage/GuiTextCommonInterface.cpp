@@ -575,6 +575,10 @@ GuiTextBoxCommonInterface
 			{
 				if(textElement)
 				{
+					if(textElement->GetLines().GetLineProvider())
+					{
+						textElement->GetLines().SetLineProvider(nullptr);
+					}
 					TextPos end;
 					if(textElement->GetLines().GetCount()>0)
 					{
@@ -1,4 +1,5 @@
 #include "GuiTextControls.h"
+#include "../GuiWindowControls.h"
 
 namespace vl
 {
@@ -76,9 +77,48 @@ GuiMultilineTextBox::CommandExecutor
 
 			void GuiMultilineTextBox::CommandExecutor::UnsafeSetText(const WString& value)
 			{
+				textBox->ReleaseLineProvider();
 				textBox->UnsafeSetText(value);
 			}
 
+/***********************************************************************
+GuiMultilineTextBox::LineCountCallback
+***********************************************************************/
+
+			class GuiMultilineTextBox::LineCountCallback : public Object, public IGuiGraphicsTimerCallback
+			{
+			public:
+				GuiMultilineTextBox*				textBox;
+				vint								lineCount = -1;
+				bool								alive = true;
+
+				LineCountCallback(GuiMultilineTextBox* _textBox)
+					:textBox(_textBox)
+				{
+				}
+
+				bool Play()override
+				{
+					if (alive)
+					{
+						// the scroll bars follow the line provider until all lines are counted
+						auto lineProvider = textBox->GetLineProvider();
+						bool finished = !lineProvider || lineProvider->IsLineCountFinal();
+						vint count = textBox->textElement->GetLines().GetCount();
+						if (lineCount != count)
+						{
+							lineCount = count;
+							textBox->CalculateView();
+						}
+						if (finished)
+						{
+							textBox->UninstallLineCountCallback();
+						}
+					}
+					return alive;
+				}
+			};
+
 /***********************************************************************
 GuiMultilineTextBox
 ***********************************************************************/
@@ -99,6 +139,39 @@ GuiMultilineTextBox
 				ct->SetCommands(commandExecutor.Obj());
 			}
 
+			void GuiMultilineTextBox::InstallLineCountCallback()
+			{
+				UninstallLineCountCallback();
+				auto lineProvider = GetLineProvider();
+				if (lineProvider && !lineProvider->IsLineCountFinal())
+				{
+					if (auto controlHost = GetRelatedControlHost())
+					{
+						lineCountCallback = new LineCountCallback(this);
+						controlHost->GetTimerManager()->AddCallback(lineCountCallback);
+					}
+				}
+			}
+
+			void GuiMultilineTextBox::UninstallLineCountCallback()
+			{
+				if (lineCountCallback)
+				{
+					lineCountCallback->alive = false;
+					lineCountCallback = nullptr;
+				}
+			}
+
+			void GuiMultilineTextBox::ReleaseLineProvider()
+			{
+				if (GetLineProvider())
+				{
+					UninstallLineCountCallback();
+					textElement->GetLines().SetLineProvider(nullptr);
+					SetReadonly(readonlyBeforeLineProvider);
+				}
+			}
+
 			void GuiMultilineTextBox::CalculateViewAndSetScroll()
 			{
 				auto ct = GetControlTemplateObject();
@@ -129,6 +202,7 @@ GuiMultilineTextBox
 
 			void GuiMultilineTextBox::OnRenderTargetChanged(elements::IGuiGraphicsRenderTarget* renderTarget)
 			{
+				InstallLineCountCallback();
 				CalculateViewAndSetScroll();
 				GuiScrollView::OnRenderTargetChanged(renderTarget);
 			}
@@ -167,6 +241,7 @@ GuiMultilineTextBox
 
 			GuiMultilineTextBox::~GuiMultilineTextBox()
 			{
+				UninstallLineCountCallback();
 			}
 
 			const WString& GuiMultilineTextBox::GetText()
@@ -177,6 +252,7 @@ GuiMultilineTextBox
 
 			void GuiMultilineTextBox::SetText(const WString& value)
 			{
+				ReleaseLineProvider();
 				UnsafeSetText(value);
 				textElement->SetCaretBegin(TextPos(0, 0));
 				textElement->SetCaretEnd(TextPos(0, 0));
@@ -190,6 +266,34 @@ GuiMultilineTextBox
 				CalculateViewAndSetScroll();
 			}
 
+			Ptr<elements::text::ITextLineProvider> GuiMultilineTextBox::GetLineProvider()
+			{
+				return textElement->GetLines().GetLineProvider();
+			}
+
+			void GuiMultilineTextBox::SetLineProvider(Ptr<elements::text::ITextLineProvider> value)
+			{
+				ClearUndoRedo();
+				if (value)
+				{
+					if (!GetLineProvider())
+					{
+						readonlyBeforeLineProvider = GetReadonly();
+					}
+					SetReadonly(true);
+					textElement->GetLines().SetLineProvider(value);
+				}
+				else
+				{
+					ReleaseLineProvider();
+				}
+				InstallLineCountCallback();
+				textElement->SetCaretBegin(TextPos(0, 0));
+				textElement->SetCaretEnd(TextPos(0, 0));
+				CalculateView();
+				TextChanged.Execute(GetNotifyEventArguments());
+			}
+
 /***********************************************************************
 GuiSinglelineTextBox::DefaultTextElementOperatorCallback
 ***********************************************************************/
@@ -54,12 +54,19 @@ MultilineTextBox
 					vint									GetTextMargin()override;
 				};
 
+				class LineCountCallback;
+
 			protected:
 				Ptr<TextElementOperatorCallback>			callback;
 				Ptr<CommandExecutor>						commandExecutor;
 				elements::GuiColorizedTextElement*			textElement = nullptr;
 				compositions::GuiBoundsComposition*			textComposition = nullptr;
+				bool										readonlyBeforeLineProvider = false;
+				Ptr<LineCountCallback>						lineCountCallback;
 
+				void										InstallLineCountCallback();
+				void										UninstallLineCountCallback();
+				void										ReleaseLineProvider();
 				void										CalculateViewAndSetScroll();
 				void										OnRenderTargetChanged(elements::IGuiGraphicsRenderTarget* renderTarget)override;
 				Size										QueryFullSize()override;
@@ -75,6 +82,18 @@ MultilineTextBox
 				const WString&								GetText()override;
 				void										SetText(const WString& value)override;
 				void										SetFont(const FontProperties& value)override;
+
+				/// <summary>Get the line provider for displaying a large read-only document.</summary>
+				/// <returns>The line provider. Returns null if the text box is displaying its own text.</returns>
+				Ptr<elements::text::ITextLineProvider>		GetLineProvider();
+				/// <summary>
+				/// Display a large document from a line provider, for example a <see cref="elements::text::FileTextLineProvider"/>. Lines are loaded on demand, and the text box becomes read-only.
+				/// The scroll bars are updated while the line provider is still counting lines.
+				/// Colorizers and auto complete should not be attached in this mode. Setting the text removes the line provider.
+				/// When the line provider is removed, the text box is read-only only if it was read-only before the line provider is set.
+				/// </summary>
+				/// <param name="value">The line provider. Set to null to display an empty document.</param>
+				void										SetLineProvider(Ptr<elements::text::ITextLineProvider> value);
 			};
 
 /***********************************************************************
@@ -13,7 +13,144 @@ namespace vl
 
 			void InvokeOnCompositionStateChanged(compositions::GuiGraphicsComposition* composition)
 			{
-				composition->InvokeOnCompositionStateChanged();
+				// an element only changes how the composition looks, a new minimum size of the element is found by the next GetBounds
+				composition->InvokeOnCompositionStateChanged(false);
+			}
+
+/***********************************************************************
+GuiGraphicsHitTestGrid
+***********************************************************************/
+
+			void GuiGraphicsHitTestGrid::GetCellRange(Rect bounds, vint& c1, vint& r1, vint& c2, vint& r2)
+			{
+				c1 = (bounds.x1 - area.x1) / cellWidth;
+				r1 = (bounds.y1 - area.y1) / cellHeight;
+				c2 = (bounds.x2 - 1 - area.x1) / cellWidth;
+				r2 = (bounds.y2 - 1 - area.y1) / cellHeight;
+			}
+
+			GuiGraphicsHitTestGrid::GuiGraphicsHitTestGrid()
+			{
+			}
+
+			GuiGraphicsHitTestGrid::~GuiGraphicsHitTestGrid()
+			{
+			}
+
+			void GuiGraphicsHitTestGrid::Build(const collections::List<GuiGraphicsComposition*>& children)
+			{
+				vint count = children.Count();
+				itemBounds.Resize(count);
+				area = Rect();
+				for (vint i = 0; i < count; i++)
+				{
+					itemBounds[i] = children[i]->GetBounds();
+					area = area.Union(itemBounds[i]);
+				}
+
+				available = false;
+				if (count == 0 || area.IsEmpty())
+				{
+					columns = 0;
+					rows = 0;
+					cellStarts.Resize(0);
+					cellItems.Resize(0);
+					return;
+				}
+
+				// choose nearly square cells so that there is about one item in each cell
+				double cellArea = (double)area.Width() * (double)area.Height() / count;
+				cellWidth = (vint)ceil(sqrt(cellArea));
+				if (cellWidth > area.Width()) cellWidth = area.Width();
+				if (cellWidth < 1) cellWidth = 1;
+				cellHeight = (vint)ceil(cellArea / cellWidth);
+				if (cellHeight > area.Height()) cellHeight = area.Height();
+				if (cellHeight < 1) cellHeight = 1;
+				columns = (area.Width() + cellWidth - 1) / cellWidth;
+				rows = (area.Height() + cellHeight - 1) / cellHeight;
+
+				vint cellCount = columns * rows;
+				cellStarts.Resize(cellCount + 1);
+				for (vint i = 0; i <= cellCount; i++)
+				{
+					cellStarts[i] = 0;
+				}
+
+				vint total = 0;
+				for (vint i = 0; i < count; i++)
+				{
+					Rect bounds = itemBounds[i];
+					if (bounds.IsEmpty()) continue;
+
+					vint c1, r1, c2, r2;
+					GetCellRange(bounds, c1, r1, c2, r2);
+					total += (c2 - c1 + 1) * (r2 - r1 + 1);
+					if (total > count * 8 + cellCount)
+					{
+						// items overlap too much, testing all children is cheaper
+						cellStarts.Resize(0);
+						return;
+					}
+
+					for (vint r = r1; r <= r2; r++)
+					{
+						for (vint c = c1; c <= c2; c++)
+						{
+							cellStarts[r * columns + c + 1]++;
+						}
+					}
+				}
+
+				for (vint i = 0; i < cellCount; i++)
+				{
+					cellStarts[i + 1] += cellStarts[i];
+				}
+
+				Array<vint> cursors(cellCount);
+				for (vint i = 0; i < cellCount; i++)
+				{
+					cursors[i] = cellStarts[i];
+				}
+
+				cellItems.Resize(total);
+				for (vint i = 0; i < count; i++)
+				{
+					Rect bounds = itemBounds[i];
+					if (bounds.IsEmpty()) continue;
+
+					vint c1, r1, c2, r2;
+					GetCellRange(bounds, c1, r1, c2, r2);
+					for (vint r = r1; r <= r2; r++)
+					{
+						for (vint c = c1; c <= c2; c++)
+						{
+							cellItems[cursors[r * columns + c]++] = i;
+						}
+					}
+				}
+				available = true;
+			}
+
+			bool GuiGraphicsHitTestGrid::IsAvailable()
+			{
+				return available;
+			}
+
+			vint GuiGraphicsHitTestGrid::Find(Point location, vint before)
+			{
+				if (!available || !area.Contains(location)) return -1;
+				vint cell = ((location.y - area.y1) / cellHeight) * columns + (location.x - area.x1) / cellWidth;
+
+				// items in a cell are sorted by z-order from low to high
+				for (vint i = cellStarts[cell + 1] - 1; i >= cellStarts[cell]; i--)
+				{
+					vint item = cellItems[i];
+					if (item < before && itemBounds[item].Contains(location))
+					{
+						return item;
+					}
+				}
+				return -1;
 			}
 
 /***********************************************************************
@@ -118,14 +255,46 @@ GuiGraphicsComposition
 				}
 			}
 
-			void GuiGraphicsComposition::InvokeOnCompositionStateChanged()
+			void GuiGraphicsComposition::InvokeOnCompositionStateChanged(bool layoutChanged)
 			{
+				if (layoutChanged)
+				{
+					// children or this composition could be moved without calling GetBounds on them
+					hitTestGridOutdated = true;
+					if (parent)
+					{
+						parent->hitTestGridOutdated = true;
+					}
+				}
+
 				if (relatedHostRecord)
 				{
-					relatedHostRecord->host->RequestRender();
+					relatedHostRecord->host->InvalidateComposition(this);
 				}
 			}
 
+			GuiGraphicsHitTestGrid* GuiGraphicsComposition::GetHitTestGrid()
+			{
+				if (children.Count() < HitTestGridThreshold)
+				{
+					hitTestGrid = nullptr;
+					return nullptr;
+				}
+
+				if (!hitTestGrid)
+				{
+					hitTestGrid = new GuiGraphicsHitTestGrid;
+					hitTestGridOutdated = true;
+				}
+				if (hitTestGridOutdated)
+				{
+					// calculating bounds of children may mark the grid outdated again, but the grid is built using the latest bounds
+					hitTestGrid->Build(children);
+					hitTestGridOutdated = false;
+				}
+				return hitTestGrid->IsAvailable() ? hitTestGrid.Obj() : nullptr;
+			}
+
 			bool GuiGraphicsComposition::SharedPtrDestructorProc(DescriptableObject* obj, bool forceDisposing)
 			{
 				GuiGraphicsComposition* value=dynamic_cast<GuiGraphicsComposition*>(obj);
@@ -273,8 +442,23 @@ GuiGraphicsComposition
 
 			void GuiGraphicsComposition::Render(Size offset)
 			{
+				Rect visibleArea;
+				if (relatedHostRecord && relatedHostRecord->nativeWindow)
+				{
+					visibleArea = Rect(Point(0, 0), relatedHostRecord->nativeWindow->GetClientSize());
+				}
+				else
+				{
+					visibleArea = Rect(Point(0, 0) + offset, GetBounds().GetSize());
+				}
+				RenderInternal(offset, visibleArea);
+			}
+
+			void GuiGraphicsComposition::RenderInternal(Size offset, Rect visibleArea)
+			{
+				renderedBounds = Rect();
 				auto renderTarget = GetRenderTarget();
-				if (visible && renderTarget && !renderTarget->IsClipperCoverWholeTarget())
+				if (visible && renderTarget)
 				{
 					Rect bounds = GetBounds();
 					bounds.x1 += margin.left;
@@ -289,6 +473,20 @@ GuiGraphicsComposition
 						bounds.y1 += offset.y;
 						bounds.y2 += offset.y;
 
+						// record the area on the screen clipped by parent compositions but not by the invalidated area
+						// it is where the composition is displayed even if it is not redrawn in this frame
+						renderedBounds = bounds.Intersect(visibleArea);
+						if (renderedBounds.IsEmpty() || renderTarget->IsClipperCoverWholeTarget())
+						{
+							return;
+						}
+
+						// the element and all children are rendered inside the bounds, skip if nothing is visible in the clipper
+						if (bounds.Intersect(renderTarget->GetClipper()).IsEmpty())
+						{
+							return;
+						}
+
 						if (ownedElement)
 						{
 							IGuiGraphicsRenderer* renderer = ownedElement->GetRenderer();
@@ -306,12 +504,13 @@ GuiGraphicsComposition
 							if (bounds.x1 <= bounds.x2 && bounds.y1 <= bounds.y2)
 							{
 								offset = bounds.GetSize();
+								Rect childVisibleArea = bounds.Intersect(renderedBounds);
 								renderTarget->PushClipper(bounds);
 								if (!renderTarget->IsClipperCoverWholeTarget())
 								{
 									for (vint i = 0; i < children.Count(); i++)
 									{
-										children[i]->Render(Size(bounds.x1, bounds.y1));
+										children[i]->RenderInternal(Size(bounds.x1, bounds.y1), childVisibleArea);
 									}
 								}
 								renderTarget->PopClipper();
@@ -343,17 +542,34 @@ GuiGraphicsComposition
 				if (relativeBounds.Contains(location))
 				{
 					Rect clientArea = GetClientArea();
-					for (vint i = children.Count() - 1; i >= 0; i--)
+					auto findInChild = [&](GuiGraphicsComposition* child)
 					{
-						GuiGraphicsComposition* child = children[i];
 						Rect childBounds = child->GetBounds();
 						vint offsetX = childBounds.x1 + (clientArea.x1 - bounds.x1);
 						vint offsetY = childBounds.y1 + (clientArea.y1 - bounds.y1);
 						Point newLocation = location - Size(offsetX, offsetY);
-						GuiGraphicsComposition* childResult = child->FindComposition(newLocation, forMouseEvent);
-						if (childResult)
+						return child->FindComposition(newLocation, forMouseEvent);
+					};
+
+					if (auto grid = GetHitTestGrid())
+					{
+						Point clientLocation = location - Size(clientArea.x1 - bounds.x1, clientArea.y1 - bounds.y1);
+						for (vint i = grid->Find(clientLocation, children.Count()); i != -1; i = grid->Find(clientLocation, i))
+						{
+							if (auto childResult = findInChild(children[i]))
+							{
+								return childResult;
+							}
+						}
+					}
+					else
+					{
+						for (vint i = children.Count() - 1; i >= 0; i--)
 						{
-							return childResult;
+							if (auto childResult = findInChild(children[i]))
+							{
+								return childResult;
+							}
 						}
 					}
 
@@ -32,6 +32,42 @@ namespace vl
 Basic Construction
 ***********************************************************************/
 
+			class GuiGraphicsComposition;
+
+			/// <summary>
+			/// A uniform grid over bounds of child compositions, to find children under a location without testing all of them.
+			/// </summary>
+			class GuiGraphicsHitTestGrid : public Object
+			{
+			protected:
+				Rect										area;
+				vint										cellWidth = 1;
+				vint										cellHeight = 1;
+				vint										columns = 0;
+				vint										rows = 0;
+				bool										available = false;
+				collections::Array<Rect>					itemBounds;
+				collections::Array<vint>					cellStarts;
+				collections::Array<vint>					cellItems;
+
+				void										GetCellRange(Rect bounds, vint& c1, vint& r1, vint& c2, vint& r2);
+			public:
+				GuiGraphicsHitTestGrid();
+				~GuiGraphicsHitTestGrid();
+
+				/// <summary>Rebuild the grid using current bounds of child compositions.</summary>
+				/// <param name="children">Child compositions ordered by z-order from low to high.</param>
+				void										Build(const collections::List<GuiGraphicsComposition*>& children);
+				/// <summary>Test is the grid usable. If child compositions overlap too much, the grid is not built.</summary>
+				/// <returns>Returns true if the grid is usable.</returns>
+				bool										IsAvailable();
+				/// <summary>Find the child composition with the highest z-order that is lower than a specified z-order and contains a location.</summary>
+				/// <returns>The index of the child composition. Returns -1 if there is no such child composition.</returns>
+				/// <param name="location">The location in the client area of the parent composition.</param>
+				/// <param name="before">The specified z-order.</param>
+				vint										Find(Point location, vint before);
+			};
+
 			/// <summary>
 			/// Represents a composition for <see cref="elements::IGuiGraphicsElement"/>. A composition is a way to define the size and the position using the information from graphics elements and sub compositions.
 			/// When a graphics composition is destroyed, all sub composition will be destroyed. The life cycle of the contained graphics element is partially controlled by the smart pointer to the graphics element inside the composition.
@@ -42,6 +78,7 @@ Basic Construction
 
 				friend class controls::GuiControl;
 				friend class GuiGraphicsHost;
+				friend class GuiGraphicsSite;
 				friend void InvokeOnCompositionStateChanged(compositions::GuiGraphicsComposition* composition);
 			public:
 				/// <summary>
@@ -57,6 +94,11 @@ Basic Construction
 					LimitToElementAndChildren,
 				};
 
+				/// <summary>
+				/// A composition with at least this number of children uses a <see cref="GuiGraphicsHitTestGrid"/> in <see cref="FindComposition"/>.
+				/// </summary>
+				static const vint							HitTestGridThreshold = 32;
+
 			protected:
 
 				struct GraphicsHostRecord
@@ -83,6 +125,9 @@ Basic Construction
 				Margin										margin;
 				Margin										internalMargin;
 				Size										preferredMinSize;
+				Rect										renderedBounds;
+				Ptr<GuiGraphicsHitTestGrid>					hitTestGrid;
+				bool										hitTestGridOutdated = true;
 
 				virtual void								OnControlParentChanged(controls::GuiControl* control);
 				virtual void								OnChildInserted(GuiGraphicsComposition* child);
@@ -93,7 +138,9 @@ Basic Construction
 				
 				void										UpdateRelatedHostRecord(GraphicsHostRecord* record);
 				void										SetAssociatedControl(controls::GuiControl* control);
-				void										InvokeOnCompositionStateChanged();
+				void										InvokeOnCompositionStateChanged(bool layoutChanged = true);
+				GuiGraphicsHitTestGrid*						GetHitTestGrid();
+				void										RenderInternal(Size offset, Rect visibleArea);
 
 				static bool									SharedPtrDestructorProc(DescriptableObject* obj, bool forceDisposing);
 			public:
@@ -81,31 +81,18 @@ Event
 					}
 				};
 			protected:
-				struct HandlerNode
-				{
-					Ptr<FunctionHandler>								handler;
-					Ptr<HandlerNode>									next;
-				};
-
 				GuiGraphicsComposition*									sender;
-				Ptr<HandlerNode>										handlers;
+				collections::List<Ptr<FunctionHandler>>					handlers;
+				vint													executingCount = 0;
+				bool													detachedWhileExecuting = false;
 
 				bool Attach(Ptr<FunctionHandler> handler)
 				{
-					Ptr<HandlerNode>* currentHandler = &handlers;
-					while (*currentHandler)
+					if (handlers.Contains(handler.Obj()))
 					{
-						if ((*currentHandler)->handler == handler)
-						{
-							return false;
-						}
-						else
-						{
-							currentHandler = &(*currentHandler)->next;
-						}
+						return false;
 					}
-					(*currentHandler) = new HandlerNode;
-					(*currentHandler)->handler = handler;
+					handlers.Add(handler);
 					return true;
 				}
 			public:
@@ -166,32 +153,48 @@ Event
 						return false;
 					}
 
-					auto currentHandler=&handlers;
-					while(*currentHandler)
+					vint index = handlers.IndexOf(typedHandler.Obj());
+					if (index == -1)
 					{
-						if((*currentHandler)->handler == typedHandler)
-						{
-							(*currentHandler)->handler->isAttached = false;
+						return false;
+					}
 
-							auto next=(*currentHandler)->next;
-							(*currentHandler)=next;
-							return true;
-						}
-						else
-						{
-							currentHandler=&(*currentHandler)->next;
-						}
+					typedHandler->isAttached = false;
+					if (executingCount > 0)
+					{
+						// keep indices stable for the running ExecuteWithNewSender, the slot is removed when it finishes
+						handlers.Set(index, nullptr);
+						detachedWhileExecuting = true;
+					}
+					else
+					{
+						handlers.RemoveAt(index);
 					}
-					return false;
+					return true;
 				}
 
 				void ExecuteWithNewSender(T& argument, GuiGraphicsComposition* newSender)
 				{
-					auto currentHandler=&handlers;
-					while(*currentHandler)
+					auto currentSender = newSender ? newSender : sender;
+					executingCount++;
+					for (vint i = 0; i < handlers.Count(); i++)
+					{
+						if (auto handler = handlers[i])
+						{
+							handler->Execute(currentSender, argument);
+						}
+					}
+
+					if (--executingCount == 0 && detachedWhileExecuting)
 					{
-						(*currentHandler)->handler->Execute(newSender?newSender:sender, argument);
-						currentHandler=&(*currentHandler)->next;
+						detachedWhileExecuting = false;
+						for (vint i = handlers.Count() - 1; i >= 0; i--)
+						{
+							if (!handlers[i])
+							{
+								handlers.RemoveAt(i);
+							}
+						}
 					}
 				}
 
@@ -182,6 +182,12 @@ Basic Construction
 				/// </summary>
 				/// <returns>Return true if the combined clipper is as large as the render target.</returns>
 				virtual bool							IsClipperCoverWholeTarget()=0;
+				/// <summary>
+				/// Test is the content of the previous frame kept when starting a new rendering.
+				/// If it is kept, the graphics host only renders areas that are changed since the last rendering.
+				/// </summary>
+				/// <returns>Returns true if the content of the previous frame is kept.</returns>
+				virtual bool							IsContentPreserved()=0;
 			};
 		}
 	}
@@ -308,8 +308,31 @@ GuiGraphicsHost
 				windowComposition->UpdateRelatedHostRecord(&hostRecord);
 			}
 
+			Rect GuiGraphicsHost::CollectInvalidatedArea()
+			{
+				Rect area;
+				// calculating bounds may update layout and invalidate more compositions
+				while (invalidatedCompositions.Count() > 0)
+				{
+					CompositionList compositions;
+					CopyFrom(compositions, invalidatedCompositions);
+					invalidatedCompositions.Clear();
+
+					FOREACH(GuiGraphicsComposition*, composition, compositions)
+					{
+						area = area.Union(composition->renderedBounds);
+						if (composition->GetVisible())
+						{
+							area = area.Union(composition->GetGlobalBounds());
+						}
+					}
+				}
+				return area.Intersect(Rect(Point(0, 0), hostRecord.nativeWindow->GetClientSize()));
+			}
+
 			void GuiGraphicsHost::DisconnectCompositionInternal(GuiGraphicsComposition* composition)
 			{
+				invalidatedCompositions.Remove(composition);
 				for(vint i=0;i<composition->Children().Count();i++)
 				{
 					DisconnectCompositionInternal(composition->Children().Get(i));
@@ -468,6 +491,11 @@ GuiGraphicsHost
 				{
 					composition=windowComposition->FindComposition(Point(info.x, info.y), true);
 				}
+				OnMouseInput(info, composition, eventReceiverEvent);
+			}
+
+			void GuiGraphicsHost::OnMouseInput(const NativeWindowMouseInfo& info, GuiGraphicsComposition* composition, GuiMouseEvent GuiGraphicsEventReceiver::* eventReceiverEvent)
+			{
 				if(composition)
 				{
 					Rect bounds=composition->GetGlobalBounds();
@@ -551,6 +579,7 @@ GuiGraphicsHost
 					previousClientSize = size;
 					minSize = windowComposition->GetPreferredBounds().GetSize();
 					needRender = true;
+					needFullRender = true;
 				}
 			}
 
@@ -559,6 +588,7 @@ GuiGraphicsHost
 				if (!supressPaint)
 				{
 					needRender = true;
+					needFullRender = true;
 				}
 			}
 
@@ -629,16 +659,52 @@ GuiGraphicsHost
 				OnMouseInput(info, &GuiGraphicsEventReceiver::verticalWheel);
 			}
 
+			void GuiGraphicsHost::SetWindowCursor(GuiGraphicsComposition* composition)
+			{
+				INativeCursor* cursor = 0;
+				if (composition)
+				{
+					cursor = composition->GetRelatedCursor();
+				}
+				if (cursor)
+				{
+					hostRecord.nativeWindow->SetWindowCursor(cursor);
+				}
+				else
+				{
+					hostRecord.nativeWindow->SetWindowCursor(GetCurrentController()->ResourceService()->GetDefaultSystemCursor());
+				}
+			}
+
 			void GuiGraphicsHost::MouseMoving(const NativeWindowMouseInfo& info)
 			{
+				GuiGraphicsComposition* hitComposition = windowComposition->FindComposition(Point(info.x, info.y), true);
+
+				// mouseEnterCompositions is the route from the root to the hovered composition
+				// compositions removed from the host are also removed from the route
+				// so if the hovered composition is not changed, the route is still valid
+				vint routeLength = mouseEnterCompositions.Count();
+				if (routeLength > 0 && mouseEnterCompositions[routeLength - 1] == hitComposition)
+				{
+					SetWindowCursor(hitComposition);
+					OnMouseInput(info, (mouseCaptureComposition ? mouseCaptureComposition : hitComposition), &GuiGraphicsEventReceiver::mouseMove);
+					return;
+				}
+
 				CompositionList newCompositions;
 				{
-					GuiGraphicsComposition* composition = windowComposition->FindComposition(Point(info.x, info.y), true);
+					GuiGraphicsComposition* composition = hitComposition;
 					while (composition)
 					{
-						newCompositions.Insert(0, composition);
+						newCompositions.Add(composition);
 						composition = composition->GetParent();
 					}
+					for (vint i = 0, j = newCompositions.Count() - 1; i < j; i++, j--)
+					{
+						GuiGraphicsComposition* temp = newCompositions[i];
+						newCompositions.Set(i, newCompositions[j]);
+						newCompositions.Set(j, temp);
+					}
 				}
 
 				vint firstDifferentIndex = mouseEnterCompositions.Count();
@@ -675,20 +741,7 @@ GuiGraphicsHost
 					}
 				}
 
-				INativeCursor* cursor = 0;
-				if (newCompositions.Count() > 0)
-				{
-					cursor = newCompositions[newCompositions.Count() - 1]->GetRelatedCursor();
-				}
-				if (cursor)
-				{
-					hostRecord.nativeWindow->SetWindowCursor(cursor);
-				}
-				else
-				{
-					hostRecord.nativeWindow->SetWindowCursor(GetCurrentController()->ResourceService()->GetDefaultSystemCursor());
-				}
-
+				SetWindowCursor(hitComposition);
 				OnMouseInput(info, &GuiGraphicsEventReceiver::mouseMove);
 			}
 
@@ -885,6 +938,7 @@ GuiGraphicsHost
 						minSize = windowComposition->GetPreferredBounds().GetSize();
 						_nativeWindow->SetCaretPoint(caretPoint);
 						needRender = true;
+						needFullRender = true;
 					}
 
 					RefreshRelatedHostRecord(_nativeWindow);
@@ -906,9 +960,37 @@ GuiGraphicsHost
 
 				if(hostRecord.nativeWindow && hostRecord.nativeWindow->IsVisible())
 				{
+					bool fullRender = forceUpdate || needFullRender || !hostRecord.renderTarget->IsContentPreserved();
+					Rect invalidatedArea;
+					if (fullRender)
+					{
+						invalidatedCompositions.Clear();
+					}
+					else
+					{
+						invalidatedArea = CollectInvalidatedArea();
+						if (invalidatedArea.IsEmpty())
+						{
+							return;
+						}
+					}
+					needFullRender = false;
+
 					supressPaint = true;
 					hostRecord.renderTarget->StartRendering();
-					windowComposition->Render(Size());
+					if (fullRender)
+					{
+						windowComposition->Render(Size());
+					}
+					else
+					{
+						hostRecord.renderTarget->PushClipper(invalidatedArea);
+						if (!hostRecord.renderTarget->IsClipperCoverWholeTarget())
+						{
+							windowComposition->Render(Size());
+						}
+						hostRecord.renderTarget->PopClipper();
+					}
 					{
 						auto bounds = windowComposition->GetBounds();
 						auto preferred = windowComposition->GetPreferredBounds();
@@ -929,6 +1011,7 @@ GuiGraphicsHost
 						{
 							GetGuiGraphicsResourceManager()->ResizeRenderTarget(hostRecord.nativeWindow);
 							needRender = true;
+							needFullRender = true;
 						}
 						break;
 					case RenderTargetFailure::LostDevice:
@@ -937,6 +1020,7 @@ GuiGraphicsHost
 							GetGuiGraphicsResourceManager()->RecreateRenderTarget(hostRecord.nativeWindow);
 							RefreshRelatedHostRecord(hostRecord.nativeWindow);
 							needRender = true;
+							needFullRender = true;
 						}
 						break;
 					default:;
@@ -947,6 +1031,16 @@ GuiGraphicsHost
 			void GuiGraphicsHost::RequestRender()
 			{
 				needRender = true;
+				needFullRender = true;
+			}
+
+			void GuiGraphicsHost::InvalidateComposition(GuiGraphicsComposition* composition)
+			{
+				needRender = true;
+				if (!needFullRender && !invalidatedCompositions.Contains(composition))
+				{
+					invalidatedCompositions.Add(composition);
+				}
 			}
 
 			IGuiShortcutKeyManager* GuiGraphicsHost::GetShortcutKeyManager()
@@ -156,6 +156,7 @@ Host
 			class GuiGraphicsHost : public Object, private INativeWindowListener, private INativeControllerListener, public Description<GuiGraphicsHost>
 			{
 				typedef collections::List<GuiGraphicsComposition*>							CompositionList;
+				typedef collections::SortedList<GuiGraphicsComposition*>					SortedCompositionList;
 				typedef collections::Dictionary<WString, IGuiAltAction*>					AltActionMap;
 				typedef collections::Dictionary<WString, controls::GuiControl*>				AltControlMap;
 				typedef GuiGraphicsComposition::GraphicsHostRecord							HostRecord;
@@ -165,6 +166,8 @@ Host
 				HostRecord								hostRecord;
 				bool									supressPaint = false;
 				bool									needRender = true;
+				bool									needFullRender = true;
+				SortedCompositionList					invalidatedCompositions;
 
 				IGuiShortcutKeyManager*					shortcutKeyManager = nullptr;
 				controls::GuiControlHost*				controlHost = nullptr;
@@ -195,6 +198,7 @@ Host
 				void									CloseAltHost();
 				void									RefreshRelatedHostRecord(INativeWindow* nativeWindow);
 
+				Rect									CollectInvalidatedArea();
 				void									DisconnectCompositionInternal(GuiGraphicsComposition* composition);
 				void									MouseCapture(const NativeWindowMouseInfo& info);
 				void									MouseUncapture(const NativeWindowMouseInfo& info);
@@ -202,6 +206,8 @@ Host
 				void									OnKeyInput(const NativeWindowKeyInfo& info, GuiGraphicsComposition* composition, GuiKeyEvent GuiGraphicsEventReceiver::* eventReceiverEvent);
 				void									RaiseMouseEvent(GuiMouseEventArgs& arguments, GuiGraphicsComposition* composition, GuiMouseEvent GuiGraphicsEventReceiver::* eventReceiverEvent);
 				void									OnMouseInput(const NativeWindowMouseInfo& info, GuiMouseEvent GuiGraphicsEventReceiver::* eventReceiverEvent);
+				void									OnMouseInput(const NativeWindowMouseInfo& info, GuiGraphicsComposition* composition, GuiMouseEvent GuiGraphicsEventReceiver::* eventReceiverEvent);
+				void									SetWindowCursor(GuiGraphicsComposition* composition);
 				
 			private:
 				INativeWindowListener::HitTestResult	HitTest(Point location)override;
@@ -246,8 +252,11 @@ Host
 				GuiGraphicsComposition*					GetMainComposition();
 				/// <summary>Render the main composition and all content to the associated window.</summary>
 				void									Render(bool forceUpdate);
-				/// <summary>Request a rendering</summary>
+				/// <summary>Request a rendering for the whole window.</summary>
 				void									RequestRender();
+				/// <summary>Request a rendering for the area that is covered by a composition, before and after the change.</summary>
+				/// <param name="composition">The composition whose appearance or bounds is changed.</param>
+				void									InvalidateComposition(GuiGraphicsComposition* composition);
 
 				/// <summary>Get the <see cref="IGuiShortcutKeyManager"/> attached with this graphics host.</summary>
 				/// <returns>The shortcut key manager.</returns>
@@ -138,15 +138,106 @@ text::TextLine
 text::CharMeasurer
 ***********************************************************************/
 
+				namespace char_measurer_helper
+				{
+					vint ReadCodePoint(const wchar_t* characters, vint count, vint& length)
+					{
+						wchar_t c=characters[0];
+						if(sizeof(wchar_t)==2 && count>1 && 0xD800<=c && c<0xDC00)
+						{
+							wchar_t d=characters[1];
+							if(0xDC00<=d && d<0xE000)
+							{
+								length=2;
+								return 0x10000+(((vint)c-0xD800)<<10)+((vint)d-0xDC00);
+							}
+						}
+						length=1;
+						return (vint)c;
+					}
+				}
+				using namespace char_measurer_helper;
+
+				vint CharMeasurer::GetCachedWidth(vint codePoint)
+				{
+					if(0<=codePoint && codePoint<65536)
+					{
+						vint* page=widthPages[codePoint>>WidthPageBits];
+						return page?page[codePoint&(WidthPageSize-1)]:0;
+					}
+					else
+					{
+						vint index=supplementaryWidths.Keys().IndexOf(codePoint);
+						return index==-1?0:supplementaryWidths.Values()[index];
+					}
+				}
+
+				void CharMeasurer::SetCachedWidth(vint codePoint, vint width)
+				{
+					if(0<=codePoint && codePoint<65536)
+					{
+						vint*& page=widthPages[codePoint>>WidthPageBits];
+						if(!page)
+						{
+							page=new vint[WidthPageSize];
+							memset(page, 0, sizeof(vint)*WidthPageSize);
+						}
+						page[codePoint&(WidthPageSize-1)]=width;
+					}
+					else
+					{
+						supplementaryWidths.Set(codePoint, width);
+					}
+				}
+
+				void CharMeasurer::ClearCachedWidths()
+				{
+					for(vint i=0;i<WidthPageCount;i++)
+					{
+						if(widthPages[i])
+						{
+							delete[] widthPages[i];
+							widthPages[i]=0;
+						}
+					}
+					supplementaryWidths.Clear();
+				}
+
+				vint CharMeasurer::MeasureCodePointWidthInternal(const wchar_t* characters, vint length, IGuiGraphicsRenderTarget* renderTarget)
+				{
+					vint width=0;
+					for(vint i=0;i<length;i++)
+					{
+						width+=MeasureWidthInternal(characters[i], renderTarget);
+					}
+					return width;
+				}
+
+				void CharMeasurer::MeasureWidthsInternal(const wchar_t* characters, vint count, vint* widths, IGuiGraphicsRenderTarget* renderTarget)
+				{
+					for(vint i=0;i<count;)
+					{
+						vint length=0;
+						ReadCodePoint(characters+i, count-i, length);
+						widths[i]=MeasureCodePointWidthInternal(characters+i, length, renderTarget);
+						if(length==2)
+						{
+							widths[i+1]=0;
+						}
+						i+=length;
+					}
+				}
+
 				CharMeasurer::CharMeasurer(vint _rowHeight)
 					:oldRenderTarget(0)
 					,rowHeight(_rowHeight)
 				{
-					memset(widths, 0, sizeof(widths));
+					memset(widthPages, 0, sizeof(widthPages));
 				}
 
 				CharMeasurer::~CharMeasurer()
 				{
+					ClearCachedWidths();
 				}
 
 				void CharMeasurer::SetRenderTarget(IGuiGraphicsRenderTarget* value)
@@ -155,25 +246,537 @@ text::CharMeasurer
 					{
 						oldRenderTarget=value;
 						rowHeight=GetRowHeightInternal(oldRenderTarget);
-						memset(widths, 0, sizeof(widths));
+						ClearCachedWidths();
 					}
 				}
 
 				vint CharMeasurer::MeasureWidth(wchar_t character)
 				{
-					vint w=widths[character];
+					vint w=GetCachedWidth((vint)character);
 					if(w==0)
 					{
-						widths[character]=w=MeasureWidthInternal(character, oldRenderTarget);
+						MeasureWidths(&character, 1, &w);
 					}
 					return w;
 				}
 
+				void CharMeasurer::MeasureWidths(const wchar_t* characters, vint count, vint* widths)
+				{
+					// collect characters that are not cached, -1 marks a character that is already collected
+					collections::Array<wchar_t> missingCharacters(count);
+					vint missingCount=0;
+					for(vint i=0;i<count;)
+					{
+						vint length=0;
+						vint codePoint=ReadCodePoint(characters+i, count-i, length);
+						if(GetCachedWidth(codePoint)==0)
+						{
+							SetCachedWidth(codePoint, -1);
+							for(vint j=0;j<length;j++)
+							{
+								missingCharacters[missingCount++]=characters[i+j];
+							}
+						}
+						i+=length;
+					}
+
+					if(missingCount>0)
+					{
+						collections::Array<vint> missingWidths(missingCount);
+						MeasureWidthsInternal(&missingCharacters[0], missingCount, &missingWidths[0], oldRenderTarget);
+						for(vint i=0;i<missingCount;)
+						{
+							vint length=0;
+							vint codePoint=ReadCodePoint(&missingCharacters[i], missingCount-i, length);
+							SetCachedWidth(codePoint, missingWidths[i]);
+							i+=length;
+						}
+					}
+
+					for(vint i=0;i<count;)
+					{
+						vint length=0;
+						vint codePoint=ReadCodePoint(characters+i, count-i, length);
+						widths[i]=GetCachedWidth(codePoint);
+						if(length==2)
+						{
+							widths[i+1]=0;
+						}
+						i+=length;
+					}
+				}
+
 				vint CharMeasurer::GetRowHeight()
 				{
 					return rowHeight;
 				}
 
+/***********************************************************************
+text::FileTextLineProvider
+***********************************************************************/
+
+				void FileTextLineProvider::IndexThreadProc(void* argument)
+				{
+					auto provider=(FileTextLineProvider*)argument;
+					provider->BuildIndex();
+					provider->indexingRunningEvent.Leave();
+				}
+
+				void FileTextLineProvider::BuildIndex()
+				{
+					// the index is built with another file stream, so that lines could be read at the same time
+					stream::FileStream indexStream(filePath, stream::FileStream::ReadOnly);
+					Array<char> indexBuffer(IndexBufferSize);
+					vint lineBreaks=0;
+					if(indexStream.IsAvailable())
+					{
+						List<pos_t> newIndex;
+						pos_t position=dataStart;
+						indexStream.SeekFromBegin(dataStart);
+						while(!isFinalizing)
+						{
+							vint read=indexStream.Read(&indexBuffer[0], IndexBufferSize);
+							if(read<=0) break;
+
+							vint start=0;
+							while(true)
+							{
+								vint index=FindLineBreak(&indexBuffer[0], start, read);
+								if(index==-1) break;
+								start=index+(utf16?2:1);
+								lineBreaks++;
+								if(lineBreaks%IndexInterval==0)
+								{
+									newIndex.Add(position+start);
+								}
+							}
+							position+=read;
+
+							// only lines followed by a line break are complete before the whole file is scanned
+							SPIN_LOCK(indexLock)
+							{
+								CopyFrom(lineIndex, newIndex, true);
+								lineCount=lineBreaks;
+							}
+							newIndex.Clear();
+						}
+					}
+
+					SPIN_LOCK(indexLock)
+					{
+						lineCount=lineBreaks+1;
+						lineCountFinal=true;
+					}
+				}
+
+				vint FileTextLineProvider::FindLineBreak(const char* data, vint start, vint end)
+				{
+					if(utf16)
+					{
+						for(vint i=start;i+1<end;i+=2)
+						{
+							if(data[i]=='\n' && data[i+1]==0)
+							{
+								return i;
+							}
+						}
+						return -1;
+					}
+					else
+					{
+						if(start>=end) return -1;
+						auto found=(const char*)memchr(data+start, '\n', end-start);
+						return found?found-data:-1;
+					}
+				}
+
+				FileTextLineProvider::FileTextLineProvider(const WString& _filePath)
+					:filePath(_filePath)
+					,fileStream(_filePath, stream::FileStream::ReadOnly)
+				{
+					buffer.Resize(LineBufferSize);
+					lineIndex.Add(dataStart);
+					if(fileStream.IsAvailable())
+					{
+						unsigned char bom[3]={0, 0, 0};
+						vint read=fileStream.Read(bom, sizeof(bom));
+						if(read>=3 && bom[0]==0xEF && bom[1]==0xBB && bom[2]==0xBF)
+						{
+							dataStart=3;
+						}
+						else if(read>=2 && bom[0]==0xFF && bom[1]==0xFE)
+						{
+							utf16=true;
+							dataStart=2;
+						}
+						lineIndex[0]=dataStart;
+
+						lineCountFinal=false;
+						indexingRunningEvent.Enter();
+						ThreadPoolLite::Queue(&FileTextLineProvider::IndexThreadProc, this);
+					}
+					else
+					{
+						lineCount=1;
+					}
+				}
+
+				FileTextLineProvider::~FileTextLineProvider()
+				{
+					isFinalizing=true;
+					indexingRunningEvent.Enter();
+					indexingRunningEvent.Leave();
+				}
+
+				bool FileTextLineProvider::IsAvailable()
+				{
+					return fileStream.IsAvailable();
+				}
+
+				vint FileTextLineProvider::GetLineCount()
+				{
+					SPIN_LOCK(indexLock)
+					{
+						return lineCount;
+					}
+					return 0;
+				}
+
+				bool FileTextLineProvider::IsLineCountFinal()
+				{
+					SPIN_LOCK(indexLock)
+					{
+						return lineCountFinal;
+					}
+					return true;
+				}
+
+				WString FileTextLineProvider::GetLineText(vint row)
+				{
+					if(row<0 || row>=GetLineCount() || !fileStream.IsAvailable()) return L"";
+
+					// start from the closest indexed line, or from the line after the last read one when reading lines in order
+					vint currentRow=row-row%IndexInterval;
+					pos_t position=0;
+					SPIN_LOCK(indexLock)
+					{
+						position=lineIndex[row/IndexInterval];
+					}
+					if(nextRow!=-1 && currentRow<nextRow && nextRow<=row)
+					{
+						currentRow=nextRow;
+						position=nextRowPosition;
+					}
+					nextRow=-1;
+
+					// read small blocks, so that only the line itself is read when it is short
+					stream::MemoryStream lineStream;
+					vint lineBreakSize=utf16?2:1;
+					fileStream.SeekFromBegin(position);
+					while(true)
+					{
+						vint read=fileStream.Read(&buffer[0], LineBufferSize);
+						if(read<=0) break;
+
+						vint start=0;
+						while(currentRow<row)
+						{
+							vint index=FindLineBreak(&buffer[0], start, read);
+							if(index==-1)
+							{
+								start=read;
+								break;
+							}
+							start=index+lineBreakSize;
+							currentRow++;
+						}
+						if(currentRow<row)
+						{
+							position+=read;
+							continue;
+						}
+
+						vint index=FindLineBreak(&buffer[0], start, read);
+						vint end=index==-1?read:index;
+						if(end>start)
+						{
+							lineStream.Write(&buffer[start], end-start);
+						}
+						if(index!=-1)
+						{
+							nextRow=row+1;
+							nextRowPosition=position+index+lineBreakSize;
+							break;
+						}
+						position+=read;
+					}
+
+					WString text;
+					lineStream.SeekFromBegin(0);
+					if(utf16)
+					{
+						stream::Utf16Decoder decoder;
+						stream::DecoderStream decoderStream(lineStream, decoder);
+						stream::StreamReader reader(decoderStream);
+						text=reader.ReadToEnd();
+					}
+					else
+					{
+						stream::Utf8Decoder decoder;
+						stream::DecoderStream decoderStream(lineStream, decoder);
+						stream::StreamReader reader(decoderStream);
+						text=reader.ReadToEnd();
+					}
+
+					if(text.Length()>0 && text[text.Length()-1]==L'\r')
+					{
+						text=text.Left(text.Length()-1);
+					}
+					return text;
+				}
+
+/***********************************************************************
+text::TextLineStorage
+***********************************************************************/
+
+				void TextLineStorage::RebuildIndex()
+				{
+					vint blockCount=blocks.Count();
+					blockIndex.Resize(blockCount+1);
+					for(vint i=0;i<=blockCount;i++)
+					{
+						blockIndex[i]=0;
+					}
+
+					count=0;
+					for(vint i=1;i<=blockCount;i++)
+					{
+						vint size=blocks[i-1]->Count();
+						count+=size;
+						blockIndex[i]+=size;
+						vint parent=i+(i&-i);
+						if(parent<=blockCount)
+						{
+							blockIndex[parent]+=blockIndex[i];
+						}
+					}
+					cachedBlock=-1;
+					cachedStart=0;
+				}
+
+				void TextLineStorage::UpdateIndex(vint block, vint delta)
+				{
+					vint blockCount=blocks.Count();
+					for(vint i=block+1;i<=blockCount;i+=i&-i)
+					{
+						blockIndex[i]+=delta;
+					}
+					count+=delta;
+					if(cachedBlock>block)
+					{
+						cachedStart+=delta;
+					}
+				}
+
+				vint TextLineStorage::FindBlock(vint index, vint& blockStart)
+				{
+					if(cachedBlock!=-1)
+					{
+						// rows are usually accessed one by one, so the current and the next block are tried first
+						vint cachedCount=blocks[cachedBlock]->Count();
+						if(cachedStart<=index && index<cachedStart+cachedCount)
+						{
+							blockStart=cachedStart;
+							return cachedBlock;
+						}
+						if(cachedBlock+1<blocks.Count() && cachedStart+cachedCount<=index && index<cachedStart+cachedCount+blocks[cachedBlock+1]->Count())
+						{
+							cachedBlock++;
+							cachedStart+=cachedCount;
+							blockStart=cachedStart;
+							return cachedBlock;
+						}
+					}
+
+					vint blockCount=blocks.Count();
+					vint step=1;
+					while(step*2<=blockCount)
+					{
+						step*=2;
+					}
+
+					vint block=0;
+					vint remain=index;
+					for(;step>0;step/=2)
+					{
+						if(block+step<=blockCount && blockIndex[block+step]<=remain)
+						{
+							block+=step;
+							remain-=blockIndex[block];
+						}
+					}
+
+					cachedBlock=block;
+					cachedStart=index-remain;
+					blockStart=cachedStart;
+					return cachedBlock;
+				}
+
+				void TextLineStorage::SplitBlock(vint block)
+				{
+					Ptr<TextLineList> source=blocks[block];
+					Ptr<TextLineList> target=new TextLineList;
+					vint half=source->Count()/2;
+					for(vint i=half;i<source->Count();i++)
+					{
+						target->Add(source->Get(i));
+					}
+					source->RemoveRange(half, source->Count()-half);
+					blocks.Insert(block+1, target);
+				}
+
+				void TextLineStorage::MergeBlock(vint block)
+				{
+					Ptr<TextLineList> target=blocks[block];
+					Ptr<TextLineList> source=blocks[block+1];
+					for(vint i=0;i<source->Count();i++)
+					{
+						target->Add(source->Get(i));
+					}
+					blocks.RemoveAt(block+1);
+				}
+
+				TextLineStorage::TextLineStorage()
+				{
+				}
+
+				TextLineStorage::~TextLineStorage()
+				{
+				}
+
+				vint TextLineStorage::Count()
+				{
+					return count;
+				}
+
+				TextLine& TextLineStorage::operator[](vint index)
+				{
+					CHECK_ERROR(0<=index && index<count, L"TextLineStorage::operator[](vint)#Argument index not in range.");
+					vint blockStart=0;
+					vint block=FindBlock(index, blockStart);
+					TextLineList& lines=*blocks[block].Obj();
+					return lines[index-blockStart];
+				}
+
+				void TextLineStorage::Add(const TextLine& line)
+				{
+					Insert(count, line);
+				}
+
+				void TextLineStorage::Insert(vint index, const TextLine& line)
+				{
+					CHECK_ERROR(0<=index && index<=count, L"TextLineStorage::Insert(vint, const TextLine&)#Argument index not in range.");
+					if(blocks.Count()==0)
+					{
+						blocks.Add(new TextLineList);
+						RebuildIndex();
+					}
+
+					vint blockStart=0;
+					vint block=0;
+					if(index==count)
+					{
+						block=blocks.Count()-1;
+						blockStart=count-blocks[block]->Count();
+					}
+					else
+					{
+						block=FindBlock(index, blockStart);
+					}
+
+					blocks[block]->Insert(index-blockStart, line);
+					if(blocks[block]->Count()>BlockSize*2)
+					{
+						SplitBlock(block);
+						RebuildIndex();
+					}
+					else
+					{
+						UpdateIndex(block, 1);
+					}
+				}
+
+				void TextLineStorage::RemoveAt(vint index)
+				{
+					RemoveRange(index, 1);
+				}
+
+				void TextLineStorage::RemoveRange(vint index, vint removeCount)
+				{
+					CHECK_ERROR(0<=index && 0<=removeCount && index+removeCount<=count, L"TextLineStorage::RemoveRange(vint, vint)#Argument index not in range.");
+					if(removeCount==0) return;
+
+					vint blockStart=0;
+					vint firstBlock=FindBlock(index, blockStart);
+					vint offset=index-blockStart;
+					vint firstRemoved=0;
+					vint block=firstBlock;
+					vint remain=removeCount;
+					while(remain>0)
+					{
+						vint size=blocks[block]->Count()-offset;
+						vint removing=size<remain?size:remain;
+						blocks[block]->RemoveRange(offset, removing);
+						if(block==firstBlock)
+						{
+							firstRemoved=removing;
+						}
+						remain-=removing;
+						offset=0;
+						block++;
+					}
+
+					bool changed=false;
+					for(vint i=block-1;i>=firstBlock;i--)
+					{
+						if(blocks[i]->Count()==0)
+						{
+							blocks.RemoveAt(i);
+							changed=true;
+						}
+					}
+
+					// merge a small block into one of its neighbors, to keep the number of blocks proportional to the number of lines
+					vint small=firstBlock<blocks.Count()?firstBlock:blocks.Count()-1;
+					if(small>=0 && blocks[small]->Count()<BlockSize/2)
+					{
+						if(small+1<blocks.Count() && blocks[small]->Count()+blocks[small+1]->Count()<=BlockSize*2)
+						{
+							MergeBlock(small);
+							changed=true;
+						}
+						else if(small>0 && blocks[small-1]->Count()+blocks[small]->Count()<=BlockSize*2)
+						{
+							MergeBlock(small-1);
+							changed=true;
+						}
+					}
+
+					if(changed)
+					{
+						RebuildIndex();
+					}
+					else
+					{
+						// without empty blocks, at most two adjacent blocks are touched
+						UpdateIndex(firstBlock, -firstRemoved);
+						if(firstRemoved<removeCount)
+						{
+							UpdateIndex(firstBlock+1, firstRemoved-removeCount);
+						}
+					}
+				}
+
 /***********************************************************************
 text::TextLines
 ***********************************************************************/
@@ -189,22 +792,70 @@ text::TextLines
 					TextLine line;
 					line.Initialize();
 					lines.Add(line);
+					placeholderLine.Initialize();
 				}
 
 				TextLines::~TextLines()
 				{
+					ReleaseProvidedLines();
 					RemoveLines(0, lines.Count());
+					placeholderLine.Finalize();
+				}
+
+				TextLine& TextLines::GetProvidedLine(vint row)
+				{
+					if(row>=lineProvider->GetLineCount())
+					{
+						// the line is not counted by the provider yet
+						return placeholderLine;
+					}
+
+					vint index=providedLines.Keys().IndexOf(row);
+					if(index!=-1)
+					{
+						return *providedLines.Values()[index].Obj();
+					}
+
+					if(providedLines.Count()>=ProvidedLineCacheSize)
+					{
+						// only lines far away from the requested one are released, so that references to nearby lines are still valid
+						for(vint i=providedLines.Count()-1;i>=0;i--)
+						{
+							vint key=providedLines.Keys()[i];
+							if(key<row-ProvidedLineCacheSize/2 || key>row+ProvidedLineCacheSize/2)
+							{
+								providedLines.Values()[i]->Finalize();
+								providedLines.Remove(key);
+							}
+						}
+					}
+
+					Ptr<TextLine> line=new TextLine;
+					line->Initialize();
+					WString text=lineProvider->GetLineText(row);
+					line->Modify(0, 0, text.Buffer(), text.Length());
+					providedLines.Add(row, line);
+					return *line.Obj();
 				}
 
 				//--------------------------------------------------------
 
 				vint TextLines::GetCount()
 				{
+					if(lineProvider)
+					{
+						vint count=lineProvider->GetLineCount();
+						return count>0?count:1;
+					}
 					return lines.Count();
 				}
 
 				TextLine& TextLines::GetLine(vint row)
 				{
+					if(lineProvider)
+					{
+						return GetProvidedLine(row);
+					}
 					return lines[row];
 				}
 
@@ -232,21 +883,53 @@ text::TextLines
 					ClearMeasurement();
 				}
 
+				Ptr<ITextLineProvider> TextLines::GetLineProvider()
+				{
+					return lineProvider;
+				}
+
+				void TextLines::SetLineProvider(Ptr<ITextLineProvider> value)
+				{
+					ReleaseProvidedLines();
+					RemoveLines(0, lines.Count());
+					lineProvider=value;
+					if(!lineProvider)
+					{
+						TextLine line;
+						line.Initialize();
+						lines.Add(line);
+					}
+					if (ownerElement)
+					{
+						ownerElement->InvokeOnElementStateChanged();
+					}
+				}
+
+				void TextLines::ReleaseProvidedLines()
+				{
+					for(vint i=0;i<providedLines.Count();i++)
+					{
+						providedLines.Values()[i]->Finalize();
+					}
+					providedLines.Clear();
+					providedMaxWidth=0;
+				}
+
 				WString TextLines::GetText(TextPos start, TextPos end)
 				{
 					if(!IsAvailable(start) || !IsAvailable(end) || start>end) return L"";
 
 					if(start.row==end.row)
 					{
-						return WString(lines[start.row].text+start.column, end.column-start.column);
+						return WString(GetLine(start.row).text+start.column, end.column-start.column);
 					}
 
 					vint count=0;
 					for(vint i=start.row+1;i<end.row;i++)
 					{
-						count+=lines[i].dataLength;
+						count+=GetLine(i).dataLength;
 					}
-					count+=lines[start.row].dataLength-start.column;
+					count+=GetLine(start.row).dataLength-start.column;
 					count+=end.column;
 
 					Array<wchar_t> buffer;
@@ -255,12 +938,12 @@ text::TextLines
 
 					for(vint i=start.row;i<=end.row;i++)
 					{
-						wchar_t* text=lines[i].text;
+						wchar_t* text=GetLine(i).text;
 						vint chars=0;
 						if(i==start.row)
 						{
 							text+=start.column;
-							chars=lines[i].dataLength-start.column;
+							chars=GetLine(i).dataLength-start.column;
 						}
 						else if(i==end.row)
 						{
@@ -268,7 +951,7 @@ text::TextLines
 						}
 						else
 						{
-							chars=lines[i].dataLength;
+							chars=GetLine(i).dataLength;
 						}
 
 						if(i!=start.row)
@@ -284,11 +967,15 @@ text::TextLines
 
 				WString TextLines::GetText()
 				{
-					return GetText(TextPos(0, 0), TextPos(lines.Count()-1, lines[lines.Count()-1].dataLength));
+					return GetText(TextPos(0, 0), TextPos(GetCount()-1, GetLine(GetCount()-1).dataLength));
 				}
 
 				void TextLines::SetText(const WString& value)
 				{
+					if(lineProvider)
+					{
+						SetLineProvider(nullptr);
+					}
 					Modify(TextPos(0, 0), TextPos(lines.Count()-1, lines[lines.Count()-1].dataLength), value);
 				}
 
@@ -307,7 +994,7 @@ text::TextLines
 
 				bool TextLines::IsAvailable(TextPos pos)
 				{
-					return 0<=pos.row && pos.row<lines.Count() && 0<=pos.column && pos.column<=lines[pos.row].dataLength;
+					return 0<=pos.row && pos.row<GetCount() && 0<=pos.column && pos.column<=GetLine(pos.row).dataLength;
 				}
 
 				TextPos TextLines::Normalize(TextPos pos)
@@ -316,13 +1003,13 @@ text::TextLines
 					{
 						return TextPos(0, 0);
 					}
-					else if(pos.row>=lines.Count())
+					else if(pos.row>=GetCount())
 					{
-						return TextPos(lines.Count()-1, lines[lines.Count()-1].dataLength);
+						return TextPos(GetCount()-1, GetLine(GetCount()-1).dataLength);
 					}
 					else
 					{
-						TextLine& line=lines[pos.row];
+						TextLine& line=GetLine(pos.row);
 						if(pos.column<0)
 						{
 							return TextPos(pos.row, 0);
@@ -340,7 +1027,7 @@ text::TextLines
 
 				TextPos TextLines::Modify(TextPos start, TextPos end, const wchar_t** inputs, vint* inputCounts, vint rows)
 				{
-					if(!IsAvailable(start) || !IsAvailable(end) || start>end) return TextPos(-1, -1);
+					if(lineProvider || !IsAvailable(start) || !IsAvailable(end) || start>end) return TextPos(-1, -1);
 					if (ownerElement)
 					{
 						ownerElement->InvokeOnElementStateChanged();
@@ -442,6 +1129,11 @@ text::TextLines
 
 				void TextLines::Clear()
 				{
+					if(lineProvider)
+					{
+						SetLineProvider(nullptr);
+						return;
+					}
 					RemoveLines(0, lines.Count());
 					TextLine line;
 					line.Initialize();
@@ -460,6 +1152,11 @@ text::TextLines
 					{
 						lines[i].availableOffsetCount = 0;
 					}
+					for (vint i = 0; i < providedLines.Count(); i++)
+					{
+						providedLines.Values()[i]->availableOffsetCount = 0;
+					}
+					providedMaxWidth = 0;
 
 					tabWidth = tabSpaceCount * (charMeasurer ? charMeasurer->MeasureWidth(L' ') : 1);
 					if (tabWidth == 0)
@@ -490,12 +1187,20 @@ text::TextLines
 
 				void TextLines::MeasureRow(vint row)
 				{
-					TextLine& line=lines[row];
+					TextLine& line=GetLine(row);
 					vint offset=0;
 					if(line.availableOffsetCount)
 					{
 						offset=line.att[line.availableOffsetCount-1].rightOffset;
 					}
+					vint measuringCount=line.dataLength-line.availableOffsetCount;
+					collections::Array<vint> widths(passwordChar || !charMeasurer ? 0 : measuringCount);
+					if(widths.Count()>0)
+					{
+						charMeasurer->MeasureWidths(line.text+line.availableOffsetCount, measuringCount, &widths[0]);
+					}
+					vint passwordWidth = passwordChar && charMeasurer ? charMeasurer->MeasureWidth(passwordChar) : 1;
+
 					for(vint i=line.availableOffsetCount;i<line.dataLength;i++)
 					{
 						CharAtt& att=line.att[i];
@@ -503,7 +1208,7 @@ text::TextLines
 						vint width=0;
 						if(passwordChar)
 						{
-							width = charMeasurer ? charMeasurer->MeasureWidth(passwordChar) : 1;
+							width = passwordWidth;
 						}
 						else if(c==L'\t')
 						{
@@ -511,7 +1216,7 @@ text::TextLines
 						}
 						else
 						{
-							width = charMeasurer ? charMeasurer->MeasureWidth(line.text[i]) : 1;
+							width = charMeasurer ? widths[i-line.availableOffsetCount] : 1;
 						}
 						offset+=width;
 						att.rightOffset=(int)offset;
@@ -521,8 +1226,8 @@ text::TextLines
 
 				vint TextLines::GetRowWidth(vint row)
 				{
-					if(row<0 || row>=lines.Count()) return -1;
-					TextLine& line=lines[row];
+					if(row<0 || row>=GetCount()) return -1;
+					TextLine& line=GetLine(row);
 					if(line.dataLength==0)
 					{
 						return 0;
@@ -541,6 +1246,20 @@ text::TextLines
 
 				vint TextLines::GetMaxWidth()
 				{
+					if(lineProvider)
+					{
+						// only loaded lines are measured, the width grows when more lines are displayed
+						for(vint i=0;i<providedLines.Count();i++)
+						{
+							vint rowWidth=GetRowWidth(providedLines.Keys()[i]);
+							if(providedMaxWidth<rowWidth)
+							{
+								providedMaxWidth=rowWidth;
+							}
+						}
+						return providedMaxWidth;
+					}
+
 					vint width=0;
 					for(vint i=0;i<lines.Count();i++)
 					{
@@ -555,7 +1274,7 @@ text::TextLines
 
 				vint TextLines::GetMaxHeight()
 				{
-					return lines.Count() * GetRowHeight();
+					return GetCount() * GetRowHeight();
 				}
 
 				TextPos TextLines::GetTextPosFromPoint(Point point)
@@ -565,9 +1284,9 @@ text::TextLines
 					{
 						point.y=0;
 					}
-					else if(point.y>=h*lines.Count())
+					else if(point.y>=h*GetCount())
 					{
-						point.y=h*lines.Count()-1;
+						point.y=h*GetCount()-1;
 					}
 
 					vint row=point.y/h;
@@ -577,9 +1296,9 @@ text::TextLines
 					}
 					else if(point.x>=GetRowWidth(row))
 					{
-						return TextPos(row, lines[row].dataLength);
+						return TextPos(row, GetLine(row).dataLength);
 					}
-					TextLine& line=lines[row];
+					TextLine& line=GetLine(row);
 
 					vint i1=0, i2=line.dataLength;
 					vint p1=0, p2=line.att[line.dataLength-1].rightOffset;
@@ -613,7 +1332,7 @@ text::TextLines
 						else
 						{
 							MeasureRow(pos.row);
-							TextLine& line=lines[pos.row];
+							TextLine& line=GetLine(pos.row);
 							return Point(line.att[pos.column-1].rightOffset, y);
 						}
 					}
@@ -633,7 +1352,7 @@ text::TextLines
 					else
 					{
 						vint h = GetRowHeight();
-						TextLine& line=lines[pos.row];
+						TextLine& line=GetLine(pos.row);
 						if(pos.column==line.dataLength)
 						{
 							return Rect(point, Size(h/2, h));
@@ -707,6 +1426,11 @@ GuiColorizedTextElement
 
 			void GuiColorizedTextElement::ResetTextColorIndex(vint index)
 			{
+				if (lines.GetLineProvider())
+				{
+					lines.ReleaseProvidedLines();
+					return;
+				}
 				vint lineCount = lines.GetCount();
 				for (vint i = 0; i < lineCount; i++)
 				{
@@ -125,9 +125,19 @@ Colorized Plain Text (model)
 				class CharMeasurer : public virtual IDescriptable
 				{
 				protected:
+					static const vint					WidthPageBits=8;
+					static const vint					WidthPageSize=1<<WidthPageBits;
+					static const vint					WidthPageCount=65536>>WidthPageBits;
+					typedef collections::Dictionary<vint, vint>		SupplementaryWidthMap;
+
 					IGuiGraphicsRenderTarget*		oldRenderTarget;
 					vint								rowHeight;
-					vint								widths[65536];
+					vint*								widthPages[WidthPageCount];
+					SupplementaryWidthMap				supplementaryWidths;
+
+					vint								GetCachedWidth(vint codePoint);
+					void								SetCachedWidth(vint codePoint, vint width);
+					void								ClearCachedWidths();
 					
 					/// <summary>
 					/// Measure the width of a character.
@@ -137,6 +147,24 @@ Colorized Plain Text (model)
 					/// <param name="renderTarget">The render target which the character is going to be rendered. This is a pure virtual member function to be overrided.</param>
 					virtual vint						MeasureWidthInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)=0;
 					/// <summary>
+					/// Measure the width of a character, which is a single code unit or a surrogate pair.
+					/// The default implementation adds up <see cref="MeasureWidthInternal"/> of each code unit. Renderers should override this function to measure a surrogate pair as one glyph.
+					/// </summary>
+					/// <returns>The width in pixel.</returns>
+					/// <param name="characters">The code units of the character.</param>
+					/// <param name="length">The number of code units, which is 1 or 2.</param>
+					/// <param name="renderTarget">The render target which the character is going to be rendered.</param>
+					virtual vint						MeasureCodePointWidthInternal(const wchar_t* characters, vint length, IGuiGraphicsRenderTarget* renderTarget);
+					/// <summary>
+					/// Measure the width of characters in one call. A surrogate pair is measured as one character, its width is stored in the position of the first code unit, and 0 is stored in the position of the second one.
+					/// The default implementation calls <see cref="MeasureCodePointWidthInternal"/> for each character. Renderers should override this function to measure all characters at once.
+					/// </summary>
+					/// <param name="characters">The characters to measure.</param>
+					/// <param name="count">The number of code units in characters.</param>
+					/// <param name="widths">Returns the width in pixel of each code unit.</param>
+					/// <param name="renderTarget">The render target which the characters are going to be rendered.</param>
+					virtual void						MeasureWidthsInternal(const wchar_t* characters, vint count, vint* widths, IGuiGraphicsRenderTarget* renderTarget);
+					/// <summary>
 					/// Measure the height of a character.
 					/// </summary>
 					/// <returns>The height in pixel.</returns>
@@ -163,26 +191,172 @@ Colorized Plain Text (model)
 					/// <param name="character">The character to measure.</param>
 					vint								MeasureWidth(wchar_t character);
 					/// <summary>
+					/// Measure the width of characters using the binded render target. All characters that are not cached are measured in one call.
+					/// </summary>
+					/// <param name="characters">The characters to measure.</param>
+					/// <param name="count">The number of code units in characters.</param>
+					/// <param name="widths">Returns the width in pixel of each code unit. For a surrogate pair, the width is stored in the position of the first code unit, and 0 is stored in the position of the second one.</param>
+					void								MeasureWidths(const wchar_t* characters, vint count, vint* widths);
+					/// <summary>
 					/// Measure the height of a character.
 					/// </summary>
 					/// <returns>The height of a character, in pixel.</returns>
 					vint								GetRowHeight();
 				};
 
+				/// <summary>
+				/// A read-only source of text lines. <see cref="TextLines"/> loads lines from it on demand, so that a large document is never entirely kept in memory.
+				/// </summary>
+				class ITextLineProvider : public virtual Interface
+				{
+				public:
+					/// <summary>
+					/// Returns the number of text lines that are known. The number could grow until <see cref="IsLineCountFinal"/> returns true.
+					/// </summary>
+					/// <returns>The number of text lines.</returns>
+					virtual vint					GetLineCount()=0;
+					/// <summary>
+					/// Test if all text lines are counted.
+					/// </summary>
+					/// <returns>Returns true if <see cref="GetLineCount"/> will not change anymore.</returns>
+					virtual bool					IsLineCountFinal()=0;
+					/// <summary>
+					/// Returns the text of a specified row without line breaks.
+					/// </summary>
+					/// <returns>The text of the row.</returns>
+					/// <param name="row">The specified row number.</param>
+					virtual WString					GetLineText(vint row)=0;
+				};
+
+				/// <summary>
+				/// A <see cref="ITextLineProvider"/> reading a UTF-8 or UTF-16 file. Lines are counted in a background thread, and only the offset of every 64 lines is indexed, other lines are located by scanning from the closest indexed line or the line after the last read one.
+				/// </summary>
+				class FileTextLineProvider : public Object, public ITextLineProvider
+				{
+				protected:
+					static const vint				IndexInterval=64;
+					static const vint				IndexBufferSize=65536;
+					static const vint				LineBufferSize=4096;
+
+					WString							filePath;
+					stream::FileStream				fileStream;
+					bool							utf16=false;
+					pos_t							dataStart=0;
+					collections::Array<char>		buffer;
+					vint							nextRow=-1;
+					pos_t							nextRowPosition=0;
+
+					SpinLock						indexLock;
+					vint							lineCount=0;
+					bool							lineCountFinal=true;
+					collections::List<pos_t>		lineIndex;
+					volatile bool					isFinalizing=false;
+					SpinLock						indexingRunningEvent;
+
+					static void						IndexThreadProc(void* argument);
+					void							BuildIndex();
+					vint							FindLineBreak(const char* data, vint start, vint end);
+				public:
+					/// <summary>
+					/// Open a file. The encoding is decided by the BOM, a file without BOM is read as UTF-8.
+					/// </summary>
+					/// <param name="_filePath">The file path.</param>
+					FileTextLineProvider(const WString& _filePath);
+					~FileTextLineProvider();
+
+					/// <summary>
+					/// Test is the file successfully opened.
+					/// </summary>
+					/// <returns>Returns true if the file is successfully opened.</returns>
+					bool							IsAvailable();
+					vint							GetLineCount()override;
+					bool							IsLineCountFinal()override;
+					WString							GetLineText(vint row)override;
+				};
+
+				/// <summary>
+				/// A balanced storage for text lines. Lines are kept in blocks, a binary indexed tree of block sizes locates a line in O(log n), and inserting or removing a line only moves lines in one block.
+				/// </summary>
+				class TextLineStorage : public Object
+				{
+					typedef collections::List<TextLine>					TextLineList;
+					typedef collections::List<Ptr<TextLineList>>		TextLineBlockList;
+				protected:
+					static const vint				BlockSize=512;
+
+					TextLineBlockList				blocks;
+					collections::Array<vint>		blockIndex;
+					vint							count=0;
+					vint							cachedBlock=-1;
+					vint							cachedStart=0;
+
+					void							RebuildIndex();
+					void							UpdateIndex(vint block, vint delta);
+					vint							FindBlock(vint index, vint& blockStart);
+					void							SplitBlock(vint block);
+					void							MergeBlock(vint block);
+				public:
+					TextLineStorage();
+					~TextLineStorage();
+
+					/// <summary>
+					/// Returns the number of text lines.
+					/// </summary>
+					/// <returns>The number of text lines.</returns>
+					vint							Count();
+					/// <summary>
+					/// Returns the text line of a specified row number.
+					/// </summary>
+					/// <returns>The related text line object.</returns>
+					/// <param name="index">The specified row number.</param>
+					TextLine&						operator[](vint index);
+					/// <summary>
+					/// Add a text line after all text lines.
+					/// </summary>
+					/// <param name="line">The text line.</param>
+					void							Add(const TextLine& line);
+					/// <summary>
+					/// Insert a text line before a specified row.
+					/// </summary>
+					/// <param name="index">The specified row number.</param>
+					/// <param name="line">The text line.</param>
+					void							Insert(vint index, const TextLine& line);
+					/// <summary>
+					/// Remove a text line. Resources of the text line are not released.
+					/// </summary>
+					/// <param name="index">The row number of the text line.</param>
+					void							RemoveAt(vint index);
+					/// <summary>
+					/// Remove text lines in a specified range. Resources of text lines are not released.
+					/// </summary>
+					/// <param name="index">The first row number.</param>
+					/// <param name="removeCount">The number of text lines to be removed.</param>
+					void							RemoveRange(vint index, vint removeCount);
+				};
+
 				/// <summary>
 				/// A class to maintain multiple lines of text buffer.
 				/// </summary>
 				class TextLines : public Object, public Description<TextLines>
 				{
-					typedef collections::List<TextLine>		TextLineList;
+					typedef TextLineStorage									TextLineList;
+					typedef collections::Dictionary<vint, Ptr<TextLine>>	ProvidedLineMap;
 				protected:
+					static const vint				ProvidedLineCacheSize=1024;
+
 					GuiColorizedTextElement*		ownerElement;
 					TextLineList					lines;
+					Ptr<ITextLineProvider>			lineProvider;
+					ProvidedLineMap					providedLines;
+					TextLine						placeholderLine;
+					vint							providedMaxWidth=0;
 					CharMeasurer*					charMeasurer;
 					IGuiGraphicsRenderTarget*		renderTarget;
 					vint							tabWidth;
 					vint							tabSpaceCount;
 					wchar_t							passwordChar;
+
+					TextLine&						GetProvidedLine(vint row);
 				public:
 					TextLines(GuiColorizedTextElement* _ownerElement);
 					~TextLines();
@@ -219,6 +393,20 @@ Colorized Plain Text (model)
 					/// <param name="value">The <see cref="IGuiGraphicsRenderTarget"/> to bind.</param>
 					void							SetRenderTarget(IGuiGraphicsRenderTarget* value);
 					/// <summary>
+					/// Returns the binded <see cref="ITextLineProvider"/>.
+					/// </summary>
+					/// <returns>The binded <see cref="ITextLineProvider"/>.</returns>
+					Ptr<ITextLineProvider>			GetLineProvider();
+					/// <summary>
+					/// Bind a <see cref="ITextLineProvider"/> to replace all text lines. Lines are read-only and loaded on demand when a provider is binded, only lines close to recently accessed ones are kept with their colors and measurement.
+					/// </summary>
+					/// <param name="value">The <see cref="ITextLineProvider"/> to bind. Set to null to go back to an empty editable document.</param>
+					void							SetLineProvider(Ptr<ITextLineProvider> value);
+					/// <summary>
+					/// Release all lines loaded from the binded <see cref="ITextLineProvider"/>. They will be loaded again when they are accessed.
+					/// </summary>
+					void							ReleaseProvidedLines();
+					/// <summary>
 					/// Returns a string from a specified range of the text lines.
 					/// </summary>
 					/// <returns>The string.</returns>
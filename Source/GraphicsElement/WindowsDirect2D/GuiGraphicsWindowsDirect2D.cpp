@@ -222,15 +222,16 @@ CachedResourceAllocator
 				{
 				protected:
 					ComPtr<IDWriteTextFormat>		font;
+					ComPtr<IDWriteTypography>		typography;
 					vint								size;
 
-					Size MeasureInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
+					Size MeasureInternal(const wchar_t* characters, vint length, IGuiGraphicsRenderTarget* renderTarget)
 					{
 						Size charSize(0, 0);
 						IDWriteTextLayout* textLayout=0;
 						HRESULT hr=GetWindowsDirect2DObjectProvider()->GetDirectWriteFactory()->CreateTextLayout(
-							&character,
-							1,
+							characters,
+							(int)length,
 							font.Obj(),
 							0,
 							0,
@@ -248,11 +249,89 @@ CachedResourceAllocator
 						return charSize;
 					}
 
+					Size MeasureInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
+					{
+						return MeasureInternal(&character, 1, renderTarget);
+					}
+
 					vint MeasureWidthInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
 					{
 						return MeasureInternal(character, renderTarget).x;
 					}
 
+					vint MeasureCodePointWidthInternal(const wchar_t* characters, vint length, IGuiGraphicsRenderTarget* renderTarget)
+					{
+						return MeasureInternal(characters, length, renderTarget).x;
+					}
+
+					void MeasureWidthsInternal(const wchar_t* characters, vint count, vint* widths, IGuiGraphicsRenderTarget* renderTarget)
+					{
+						for(vint i=0;i<count;i++)
+						{
+							widths[i]=-1;
+						}
+
+						// measure all characters in one text layout, each cluster is a character or a surrogate pair
+						// without a typography that turns off kerning and ligatures, a width depends on neighbors and cannot be cached
+						IDWriteTextLayout* textLayout=0;
+						HRESULT hr=typography.Obj()?GetWindowsDirect2DObjectProvider()->GetDirectWriteFactory()->CreateTextLayout(
+							characters,
+							(int)count,
+							font.Obj(),
+							0,
+							0,
+							&textLayout):E_FAIL;
+						if(!FAILED(hr))
+						{
+							DWRITE_TEXT_RANGE range={0, (UINT32)count};
+							textLayout->SetTypography(typography.Obj(), range);
+							UINT32 clusterCount=0;
+							textLayout->GetClusterMetrics(NULL, 0, &clusterCount);
+							if(clusterCount>0)
+							{
+								collections::Array<DWRITE_CLUSTER_METRICS> clusters((vint)clusterCount);
+								hr=textLayout->GetClusterMetrics(&clusters[0], clusterCount, &clusterCount);
+								if(!FAILED(hr))
+								{
+									vint index=0;
+									for(vint i=0;i<(vint)clusterCount;i++)
+									{
+										const DWRITE_CLUSTER_METRICS& cluster=clusters[i];
+										bool surrogatePair=cluster.length==2 && IS_HIGH_SURROGATE(characters[index]) && IS_LOW_SURROGATE(characters[index+1]);
+										if(cluster.length==1 || surrogatePair)
+										{
+											widths[index]=(vint)ceil(cluster.width);
+											if(surrogatePair)
+											{
+												widths[index+1]=0;
+											}
+										}
+										index+=cluster.length;
+									}
+								}
+							}
+							textLayout->Release();
+						}
+
+						// characters that are not measured in the text layout are measured separately
+						for(vint i=0;i<count;i++)
+						{
+							if(widths[i]==-1)
+							{
+								if(i<count-1 && IS_HIGH_SURROGATE(characters[i]) && IS_LOW_SURROGATE(characters[i+1]))
+								{
+									widths[i]=MeasureInternal(characters+i, 2, renderTarget).x;
+									widths[i+1]=0;
+									i++;
+								}
+								else
+								{
+									widths[i]=MeasureInternal(characters[i], renderTarget).x;
+								}
+							}
+						}
+					}
+
 					vint GetRowHeightInternal(IGuiGraphicsRenderTarget* renderTarget)
 					{
 						return MeasureInternal(L' ', renderTarget).y;
@@ -263,6 +342,25 @@ CachedResourceAllocator
 						,size(_size)
 						,font(_font)
 					{
+						IDWriteTypography* newTypography=0;
+						HRESULT hr=GetWindowsDirect2DObjectProvider()->GetDirectWriteFactory()->CreateTypography(&newTypography);
+						if(!FAILED(hr))
+						{
+							DWRITE_FONT_FEATURE_TAG tags[]=
+							{
+								DWRITE_FONT_FEATURE_TAG_KERNING,
+								DWRITE_FONT_FEATURE_TAG_STANDARD_LIGATURES,
+								DWRITE_FONT_FEATURE_TAG_REQUIRED_LIGATURES,
+								DWRITE_FONT_FEATURE_TAG_CONTEXTUAL_LIGATURES,
+								DWRITE_FONT_FEATURE_TAG_CONTEXTUAL_ALTERNATES,
+							};
+							for(vint i=0;i<(vint)(sizeof(tags)/sizeof(*tags));i++)
+							{
+								DWRITE_FONT_FEATURE feature={tags[i], 0};
+								newTypography->AddFontFeature(feature);
+							}
+							typography=newTypography;
+						}
 					}
 				};
 			public:
@@ -572,6 +670,11 @@ WindowsDirect2DRenderTarget
 					return clipperCoverWholeTargetCounter>0;
 				}
 
+				bool IsContentPreserved()override
+				{
+					return false;
+				}
+
 				ID2D1SolidColorBrush* CreateDirect2DBrush(Color color)override
 				{
 					return solidBrushes.Create(color).Obj();
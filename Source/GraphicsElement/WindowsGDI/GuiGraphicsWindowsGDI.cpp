@@ -136,6 +136,11 @@ WindowsGDIRenderTarget
 				{
 					return clipperCoverWholeTargetCounter>0;
 				}
+
+				bool IsContentPreserved()override
+				{
+					return true;
+				}
 			};
 
 /***********************************************************************
@@ -189,14 +194,14 @@ CachedResourceAllocator
 					Ptr<WinFont>			font;
 					vint						size;
 
-					Size MeasureInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
+					Size MeasureInternal(const wchar_t* characters, vint length, IGuiGraphicsRenderTarget* renderTarget)
 					{
 						if(renderTarget)
 						{
 							WindowsGDIRenderTarget* gdiRenderTarget=dynamic_cast<WindowsGDIRenderTarget*>(renderTarget);
 							WinDC* dc=gdiRenderTarget->GetDC();
 							dc->SetFont(font);
-							SIZE size=dc->MeasureBuffer(&character, 1, -1);
+							SIZE size=dc->MeasureBuffer(characters, length, -1);
 							return Size(size.cx, size.cy);
 						}
 						else
@@ -205,11 +210,58 @@ CachedResourceAllocator
 						}
 					}
 
+					Size MeasureInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
+					{
+						return MeasureInternal(&character, 1, renderTarget);
+					}
+
 					vint MeasureWidthInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
 					{
 						return MeasureInternal(character, renderTarget).x;
 					}
 
+					vint MeasureCodePointWidthInternal(const wchar_t* characters, vint length, IGuiGraphicsRenderTarget* renderTarget)
+					{
+						return MeasureInternal(characters, length, renderTarget).x;
+					}
+
+					void MeasureWidthsInternal(const wchar_t* characters, vint count, vint* widths, IGuiGraphicsRenderTarget* renderTarget)
+					{
+						if(renderTarget)
+						{
+							WindowsGDIRenderTarget* gdiRenderTarget=dynamic_cast<WindowsGDIRenderTarget*>(renderTarget);
+							WinDC* dc=gdiRenderTarget->GetDC();
+							dc->SetFont(font);
+
+							// GetTextExtentExPoint returns the extent of each prefix, the difference of two neighbors is the width of a code unit
+							collections::Array<INT> extents(count);
+							SIZE size;
+							GetTextExtentExPoint(dc->GetHandle(), characters, (int)count, 0, NULL, &extents[0], &size);
+							vint previous=0;
+							for(vint i=0;i<count;i++)
+							{
+								widths[i]=extents[i]-previous;
+								previous=extents[i];
+							}
+							for(vint i=0;i<count-1;i++)
+							{
+								if(IS_HIGH_SURROGATE(characters[i]) && IS_LOW_SURROGATE(characters[i+1]))
+								{
+									widths[i]+=widths[i+1];
+									widths[i+1]=0;
+									i++;
+								}
+							}
+						}
+						else
+						{
+							for(vint i=0;i<count;i++)
+							{
+								widths[i]=0;
+							}
+						}
+					}
+
 					vint GetRowHeightInternal(IGuiGraphicsRenderTarget* renderTarget)
 					{
 						if(renderTarget)
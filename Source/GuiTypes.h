@@ -359,6 +359,34 @@ Rectangle
 			{
 				return x1<=p.x && p.x<x2 && y1<=p.y && p.y<y2;
 			}
+
+			bool IsEmpty()const
+			{
+				return x1>=x2 || y1>=y2;
+			}
+
+			Rect Intersect(Rect r)const
+			{
+				Rect result(
+					(x1>r.x1?x1:r.x1),
+					(y1>r.y1?y1:r.y1),
+					(x2<r.x2?x2:r.x2),
+					(y2<r.y2?y2:r.y2)
+					);
+				return result.IsEmpty()?Rect():result;
+			}
+
+			Rect Union(Rect r)const
+			{
+				if(IsEmpty()) return r;
+				if(r.IsEmpty()) return *this;
+				return Rect(
+					(x1<r.x1?x1:r.x1),
+					(y1<r.y1?y1:r.y1),
+					(x2>r.x2?x2:r.x2),
+					(y2>r.y2?y2:r.y2)
+					);
+			}
 		};
 
 /***********************************************************************
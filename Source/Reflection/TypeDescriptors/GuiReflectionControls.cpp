@@ -388,6 +388,9 @@ Type Declaration
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(Arranger)
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(Axis)
 				CLASS_MEMBER_PROPERTY_FAST(DisplayItemBackground)
+				CLASS_MEMBER_PROPERTY_FAST(ItemTemplateRecycleLimit)
+				CLASS_MEMBER_PROPERTY_READONLY_FAST(ItemTemplateRecycleHitCount)
+				CLASS_MEMBER_PROPERTY_READONLY_FAST(ItemTemplateRecycleMissCount)
 
 				CLASS_MEMBER_METHOD(EnsureItemVisible, {L"itemIndex"})
 				CLASS_MEMBER_METHOD(GetAdoptedSize, {L"expectedSize"})
@@ -475,6 +478,11 @@ Type Declaration
 				CLASS_MEMBER_CONSTRUCTOR(Ptr<FixedHeightItemArranger>(), NO_PARAMETER)
 			END_CLASS_MEMBER(FixedHeightItemArranger)
 
+			BEGIN_CLASS_MEMBER(VariableHeightItemArranger)
+				CLASS_MEMBER_BASE(RangedItemArrangerBase)
+				CLASS_MEMBER_CONSTRUCTOR(Ptr<VariableHeightItemArranger>(), NO_PARAMETER)
+			END_CLASS_MEMBER(VariableHeightItemArranger)
+
 			BEGIN_CLASS_MEMBER(FixedSizeMultiColumnItemArranger)
 				CLASS_MEMBER_BASE(RangedItemArrangerBase)
 				CLASS_MEMBER_CONSTRUCTOR(Ptr<FixedSizeMultiColumnItemArranger>(), NO_PARAMETER)
@@ -1231,6 +1239,23 @@ Type Declaration
 				CLASS_MEMBER_BASE(IDataSorter)
 			END_CLASS_MEMBER(DataSorterBase)
 
+			BEGIN_STRUCT_MEMBER(DataSortKey)
+				STRUCT_MEMBER(integer)
+				STRUCT_MEMBER(number)
+				STRUCT_MEMBER(text)
+			END_STRUCT_MEMBER(DataSortKey)
+
+			BEGIN_CLASS_MEMBER(DataKeySorterBase)
+				CLASS_MEMBER_BASE(DataSorterBase)
+			END_CLASS_MEMBER(DataKeySorterBase)
+
+			BEGIN_CLASS_MEMBER(DataKeySorter)
+				CLASS_MEMBER_BASE(DataKeySorterBase)
+				CLASS_MEMBER_CONSTRUCTOR(Ptr<DataKeySorter>(), NO_PARAMETER)
+
+				CLASS_MEMBER_PROPERTY_FAST(KeyProperty)
+			END_CLASS_MEMBER(DataKeySorter)
+
 			BEGIN_CLASS_MEMBER(DataMultipleSorter)
 				CLASS_MEMBER_BASE(DataSorterBase)
 				CLASS_MEMBER_CONSTRUCTOR(Ptr<DataMultipleSorter>(), NO_PARAMETER)
@@ -1281,6 +1306,7 @@ Type Declaration
 				CLASS_MEMBER_PROPERTY_READONLY_FAST(Columns)
 				CLASS_MEMBER_PROPERTY_FAST(ItemSource)
 				CLASS_MEMBER_PROPERTY_FAST(AdditionalFilter)
+				CLASS_MEMBER_PROPERTY_FAST(FilterInBackground)
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(LargeImageProperty)
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(SmallImageProperty)
 				CLASS_MEMBER_PROPERTY_EVENT_READONLY_FAST(SelectedRowValue, SelectedCellChanged)
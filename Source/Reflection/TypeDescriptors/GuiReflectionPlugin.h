@@ -281,6 +281,7 @@ Type List (Controls)
 			F(presentation::controls::list::ItemProviderBase)\
 			F(presentation::controls::list::RangedItemArrangerBase)\
 			F(presentation::controls::list::FixedHeightItemArranger)\
+			F(presentation::controls::list::VariableHeightItemArranger)\
 			F(presentation::controls::list::FixedSizeMultiColumnItemArranger)\
 			F(presentation::controls::list::FixedHeightMultiColumnItemArranger)\
 			F(presentation::controls::list::ITextItemView)\
@@ -364,6 +365,9 @@ Type List (Controls)
 			F(presentation::controls::list::DataOrFilter)\
 			F(presentation::controls::list::DataNotFilter)\
 			F(presentation::controls::list::DataSorterBase)\
+			F(presentation::controls::list::DataSortKey)\
+			F(presentation::controls::list::DataKeySorterBase)\
+			F(presentation::controls::list::DataKeySorter)\
 			F(presentation::controls::list::DataMultipleSorter)\
 			F(presentation::controls::list::DataReverseSorter)\
 			F(presentation::controls::list::DataColumn)\
@@ -12,6 +12,16 @@ namespace vl
 		using namespace parsing::json;
 		using namespace regex;
 
+/***********************************************************************
+GuiXmlPullParser
+***********************************************************************/
+
+		Ptr<XmlDocument> GuiXmlPullParser::ParseInternal(const WString& text, List<Ptr<parsing::ParsingError>>& errors)
+		{
+			XmlPullParser parser(text);
+			return XmlBuildDocument(parser, errors);
+		}
+
 /***********************************************************************
 IGuiParserManager
 ***********************************************************************/
@@ -29,6 +39,7 @@ IGuiParserManager
 			Dictionary<WString, Ptr<Table>>				tables;
 			Dictionary<WString, Func<Ptr<Table>()>>		loaders;
 			SpinLock									lock;
+			CriticalSection								loadingLock;
 
 			Dictionary<WString, Ptr<IGuiGeneralParser>>	parsers;
 		public:
@@ -42,7 +53,7 @@ IGuiParserManager
 				parserManager=this;
 				SetParsingTable(L"XML", &XmlLoadTable);
 				SetParsingTable(L"JSON", &JsonLoadTable);
-				SetTableParser(L"XML", L"XML", &XmlParseDocument);
+				SetParser(L"XML", new GuiXmlPullParser);
 				SetTableParser(L"JSON", L"JSON", &JsonParse);
 			}
 
@@ -60,14 +71,34 @@ IGuiParserManager
 					{
 						return tables.Values()[index];
 					}
+				}
 
-					index=loaders.Keys().IndexOf(name);
-					if(index!=-1)
+				// loading a table is slow, other threads wait without spinning while loaded tables stay available
+				CS_LOCK(loadingLock)
+				{
+					Func<Ptr<Table>()> loader;
+					SPIN_LOCK(lock)
+					{
+						vint index=tables.Keys().IndexOf(name);
+						if(index!=-1)
+						{
+							return tables.Values()[index];
+						}
+
+						index=loaders.Keys().IndexOf(name);
+						if(index==-1)
+						{
+							return 0;
+						}
+						loader=loaders.Values()[index];
+					}
+
+					Ptr<Table> table=loader();
+					SPIN_LOCK(lock)
 					{
-						Ptr<Table> table=loaders.Values()[index]();
 						tables.Add(name, table);
-						return table;
 					}
+					return table;
 				}
 				return 0;
 			}
@@ -70,7 +70,7 @@ Parser Manager
 			typedef parsing::tabling::ParsingTable			Table;
 
 		public:
-			/// <summary>Get a parsing table by name.</summary>
+			/// <summary>Get a parsing table by name. The table is loaded on the first call, and the same table is returned after that.</summary>
 			/// <returns>The parsing table.</returns>
 			/// <param name="name">The name.</param>
 			virtual Ptr<Table>						GetParsingTable(const WString& name)=0;
@@ -112,6 +112,7 @@ Strong Typed Table Parser
 			typedef Ptr<T>(ParserFunction)(const WString&, Ptr<Table>, collections::List<Ptr<parsing::ParsingError>>&, vint);
 		protected:
 			WString									name;
+			SpinLock								tableLock;
 			Ptr<Table>								table;
 			Func<ParserFunction>					function;
 
@@ -124,14 +125,19 @@ Strong Typed Table Parser
 
 			Ptr<T> ParseInternal(const WString& text, collections::List<Ptr<parsing::ParsingError>>& errors)override
 			{
-				if (!table)
+				Ptr<Table> currentTable;
+				SPIN_LOCK(tableLock)
 				{
-					table = GetParserManager()->GetParsingTable(name);
+					if (!table)
+					{
+						table = GetParserManager()->GetParsingTable(name);
+					}
+					currentTable = table;
 				}
-				if (table)
+				if (currentTable)
 				{
 					collections::List<Ptr<parsing::ParsingError>> parsingErrors;
-					auto result = function(text, table, parsingErrors, -1);
+					auto result = function(text, currentTable, parsingErrors, -1);
 					if (parsingErrors.Count() > 0)
 					{
 						errors.Add(parsingErrors[0]);
@@ -142,6 +148,17 @@ Strong Typed Table Parser
 			}
 		};
 
+/***********************************************************************
+XML Parser
+***********************************************************************/
+
+		/// <summary>XML parser that builds the document using <see cref="parsing::xml::XmlPullParser"/>, the parsing table is not loaded.</summary>
+		class GuiXmlPullParser : public Object, public IGuiParser<parsing::xml::XmlDocument>
+		{
+		public:
+			Ptr<parsing::xml::XmlDocument>			ParseInternal(const WString& text, collections::List<Ptr<parsing::ParsingError>>& errors)override;
+		};
+
 /***********************************************************************
 Parser Manager
 ***********************************************************************/
@@ -120,6 +120,7 @@ GlobalStringKey
 		class GlobalStringKeyManager
 		{
 		public:
+			ReaderWriterLock				lock;		// keys are created by items precompiled in parallel
 			Dictionary<WString, vint>		stoi;
 			List<WString>					itos;
 
@@ -141,15 +142,29 @@ GlobalStringKey
 			GlobalStringKey key;
 			if (string != L"")
 			{
-				vint index = globalStringKeyManager->stoi.Keys().IndexOf(string);
-				if (index == -1)
+				READER_LOCK(globalStringKeyManager->lock)
 				{
-					key.key = globalStringKeyManager->itos.Add(string);
-					globalStringKeyManager->stoi.Add(string, key.key);
+					vint index = globalStringKeyManager->stoi.Keys().IndexOf(string);
+					if (index != -1)
+					{
+						key.key = globalStringKeyManager->stoi.Values()[index];
+						return key;
+					}
 				}
-				else
+
+				WRITER_LOCK(globalStringKeyManager->lock)
 				{
-					key.key = globalStringKeyManager->stoi.Values()[index];
+					vint index = globalStringKeyManager->stoi.Keys().IndexOf(string);
+					if (index == -1)
+					{
+						auto interned = InternString(string);
+						key.key = globalStringKeyManager->itos.Add(interned);
+						globalStringKeyManager->stoi.Add(interned, key.key);
+					}
+					else
+					{
+						key.key = globalStringKeyManager->stoi.Values()[index];
+					}
 				}
 			}
 			return key;
@@ -162,9 +177,15 @@ GlobalStringKey
 
 		WString GlobalStringKey::ToString()const
 		{
-			return *this == GlobalStringKey::Empty
-				? L""
-				: globalStringKeyManager->itos[key];
+			if (*this == GlobalStringKey::Empty)
+			{
+				return L"";
+			}
+			READER_LOCK(globalStringKeyManager->lock)
+			{
+				return globalStringKeyManager->itos[key];
+			}
+			return L"";
 		}
 
 /***********************************************************************
@@ -905,27 +926,27 @@ GuiResourceFolder
 			}
 		}
 
-		void GuiResourceFolder::PrecompileResourceFolder(GuiResourcePrecompileContext& context, IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors)
+		void GuiResourceFolder::CollectPerResourceItems(vint passIndex, collections::List<Ptr<GuiResourceItem>>& precompiledItems)
 		{
 			FOREACH(Ptr<GuiResourceItem>, item, items.Values())
 			{
 				auto typeResolver = GetResourceResolverManager()->GetTypeResolver(item->GetTypeName());
 				if (auto precompile = typeResolver->Precompile())
 				{
-					if (precompile->GetPassSupport(context.passIndex) == IGuiResourceTypeResolver_Precompile::PerResource)
+					switch (precompile->GetPassSupport(passIndex))
 					{
-						if (callback)
-						{
-							callback->OnPerResource(context.passIndex, item);
-						}
-						precompile->PerResourcePrecompile(item, context, errors);
+					case IGuiResourceTypeResolver_Precompile::PerResource:
+					case IGuiResourceTypeResolver_Precompile::PerResourceParallel:
+						precompiledItems.Add(item);
+						break;
+					default:;
 					}
 				}
 			}
 
 			FOREACH(Ptr<GuiResourceFolder>, folder, folders.Values())
 			{
-				folder->PrecompileResourceFolder(context, callback, errors);
+				folder->CollectPerResourceItems(passIndex, precompiledItems);
 			}
 		}
 
@@ -1235,7 +1256,92 @@ GuiResource
 			SaveResourceFolderToBinary(writer, typeNames);
 		}
 
-		Ptr<GuiResourceFolder> GuiResource::Precompile(IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors)
+		void GuiResourcePrecompileContext::UpdateSharedStates(const SharedUpdate& update)
+		{
+			if (pendingUpdates)
+			{
+				pendingUpdates->Add(update);
+			}
+			else
+			{
+				update(*this);
+			}
+		}
+
+		struct GuiResourcePrecompileTask
+		{
+			Ptr<GuiResourceItem>								item;
+			GuiResourceError::List								errors;
+			GuiResourcePrecompileContext::SharedUpdateList		updates;
+		};
+
+		void PrecompileResourceItemsInParallel(GuiResourcePrecompileContext& context, List<Ptr<GuiResourceItem>>& precompiledItems, GuiResourceError::List& errors)
+		{
+			List<Ptr<GuiResourcePrecompileTask>> tasks;
+			FOREACH(Ptr<GuiResourceItem>, item, precompiledItems)
+			{
+				auto task = MakePtr<GuiResourcePrecompileTask>();
+				task->item = item;
+				tasks.Add(task);
+			}
+
+			SpinLock taskLock;
+			vint nextTask = 0;
+			auto worker = [&]()
+			{
+				parsing::ParsingArena arena;
+				parsing::ParsingArena::Scope arenaScope(arena);
+				while (true)
+				{
+					vint taskIndex = -1;
+					SPIN_LOCK(taskLock)
+					{
+						taskIndex = nextTask++;
+					}
+					if (taskIndex >= tasks.Count())
+					{
+						break;
+					}
+
+					auto task = tasks[taskIndex];
+					GuiResourcePrecompileContext taskContext;
+					taskContext.compilerCallback = context.compilerCallback;
+					taskContext.targetFolder = context.targetFolder;
+					taskContext.rootResource = context.rootResource;
+					taskContext.passIndex = context.passIndex;
+					taskContext.resolver = context.resolver;
+					taskContext.workerCount = context.workerCount;
+					taskContext.pendingUpdates = &task->updates;
+
+					auto typeResolver = GetResourceResolverManager()->GetTypeResolver(task->item->GetTypeName());
+					typeResolver->Precompile()->PerResourcePrecompile(task->item, taskContext, task->errors);
+				}
+			};
+
+			List<Thread*> threads;
+			vint threadCount = (context.workerCount < tasks.Count() ? context.workerCount : tasks.Count()) - 1;
+			for (vint i = 0; i < threadCount; i++)
+			{
+				threads.Add(Thread::CreateAndStart(worker, false));
+			}
+			worker();
+			FOREACH(Thread*, thread, threads)
+			{
+				thread->Wait();
+				delete thread;
+			}
+
+			FOREACH(Ptr<GuiResourcePrecompileTask>, task, tasks)
+			{
+				CopyFrom(errors, task->errors, true);
+				FOREACH(GuiResourcePrecompileContext::SharedUpdate, update, task->updates)
+				{
+					update(context);
+				}
+			}
+		}
+
+		Ptr<GuiResourceFolder> GuiResource::Precompile(IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors, vint workerCount)
 		{
 			if (GetFolder(L"Precompiled"))
 			{
@@ -1243,15 +1349,21 @@ GuiResource
 				return nullptr;
 			}
 
+			// when arenas are enabled, syntax trees created by resolvers are bump-allocated, and released together when no node in a block is alive
+			parsing::ParsingArena arena;
+			parsing::ParsingArena::Scope arenaScope(arena);
+
 			GuiResourcePrecompileContext context;
 			context.compilerCallback = callback ? callback->GetCompilerCallback() : nullptr;
 			context.rootResource = this;
 			context.resolver = new GuiResourcePathResolver(this, workingDirectory);
 			context.targetFolder = new GuiResourceFolder;
+			context.workerCount = workerCount;
 			
 			auto manager = GetResourceResolverManager();
 			vint maxPass = manager->GetMaxPrecompilePassIndex();
 			List<WString> resolvers;
+			List<Ptr<GuiResourceItem>> precompiledItems;
 			for (vint i = 0; i <= maxPass; i++)
 			{
 				context.passIndex = i;
@@ -1259,7 +1371,37 @@ GuiResource
 					manager->GetPerResourceResolverNames(i, resolvers);
 					if (resolvers.Count() > 0)
 					{
-						PrecompileResourceFolder(context, callback, errors);
+						precompiledItems.Clear();
+						CollectPerResourceItems(i, precompiledItems);
+
+						bool parallel = workerCount > 1 && precompiledItems.Count() > 1 && From(resolvers).All([=](const WString& name)
+						{
+							return manager->GetTypeResolver(name)->Precompile()->GetPassSupport(i) == IGuiResourceTypeResolver_Precompile::PerResourceParallel;
+						});
+
+						if (parallel)
+						{
+							if (callback)
+							{
+								FOREACH(Ptr<GuiResourceItem>, item, precompiledItems)
+								{
+									callback->OnPerResource(i, item);
+								}
+							}
+							PrecompileResourceItemsInParallel(context, precompiledItems, errors);
+						}
+						else
+						{
+							FOREACH(Ptr<GuiResourceItem>, item, precompiledItems)
+							{
+								if (callback)
+								{
+									callback->OnPerResource(i, item);
+								}
+								auto typeResolver = manager->GetTypeResolver(item->GetTypeName());
+								typeResolver->Precompile()->PerResourcePrecompile(item, context, errors);
+							}
+						}
 					}
 				}
 				{
@@ -1354,19 +1496,22 @@ GuiResourcePathResolver
 		Ptr<DescriptableObject> GuiResourcePathResolver::ResolveResource(const WString& protocol, const WString& path)
 		{
 			Ptr<IGuiResourcePathResolver> resolver;
-			vint index=resolvers.Keys().IndexOf(protocol);
-			if(index==-1)
+			SPIN_LOCK(resolversLock)
 			{
-				IGuiResourcePathResolverFactory* factory=GetResourceResolverManager()->GetPathResolverFactory(protocol);
-				if(factory)
+				vint index=resolvers.Keys().IndexOf(protocol);
+				if(index==-1)
 				{
-					resolver=factory->CreateResolver(resource, workingDirectory);
+					IGuiResourcePathResolverFactory* factory=GetResourceResolverManager()->GetPathResolverFactory(protocol);
+					if(factory)
+					{
+						resolver=factory->CreateResolver(resource, workingDirectory);
+					}
+					resolvers.Add(protocol, resolver);
+				}
+				else
+				{
+					resolver=resolvers.Values()[index];
 				}
-				resolvers.Add(protocol, resolver);
-			}
-			else
-			{
-				resolver=resolvers.Values()[index];
 			}
 
 			if(resolver)
@@ -1545,6 +1690,7 @@ IGuiResourceResolverManager
 						switch (precompile->GetPassSupport(i))
 						{
 						case IGuiResourceTypeResolver_Precompile::PerResource:
+						case IGuiResourceTypeResolver_Precompile::PerResourceParallel:
 							perResourceResolvers.Add(i, resolver->GetType());
 							break;
 						case IGuiResourceTypeResolver_Precompile::PerPass:
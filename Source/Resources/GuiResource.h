@@ -299,7 +299,7 @@ Resource Structure
 			void									CollectTypeNames(collections::List<WString>& typeNames);
 			void									LoadResourceFolderFromBinary(DelayLoadingList& delayLoadings, stream::internal::ContextFreeReader& reader, collections::List<WString>& typeNames, GuiResourceError::List& errors);
 			void									SaveResourceFolderToBinary(stream::internal::ContextFreeWriter& writer, collections::List<WString>& typeNames);
-			void									PrecompileResourceFolder(GuiResourcePrecompileContext& context, IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors);
+			void									CollectPerResourceItems(vint passIndex, collections::List<Ptr<GuiResourceItem>>& precompiledItems);
 			void									InitializeResourceFolder(GuiResourceInitializeContext& context);
 		public:
 			/// <summary>Create a resource folder.</summary>
@@ -422,7 +422,8 @@ Resource
 			/// <returns>The resource folder contains all precompiled result. The folder will be added to the resource if there is no error.</returns>
 			/// <param name="callback">A callback to receive progress.</param>
 			/// <param name="errors">All collected errors during precompiling a resource.</param>
-			Ptr<GuiResourceFolder>					Precompile(IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors);
+			/// <param name="workerCount">The maximum number of threads to precompile resources in passes that support parallel precompiling.</param>
+			Ptr<GuiResourceFolder>					Precompile(IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors, vint workerCount = 1);
 
 			/// <summary>Initialize a precompiled resource.</summary>
 			/// <param name="usage">In which role an application is initializing this resource.</param>
@@ -480,6 +481,7 @@ Resource Path Resolver
 		{
 			typedef collections::Dictionary<WString, Ptr<IGuiResourcePathResolver>>		ResolverMap;
 		protected:
+			SpinLock										resolversLock;		// resolvers are created on demand, by items precompiled in parallel
 			ResolverMap										resolvers;
 			Ptr<GuiResource>								resource;
 			WString											workingDirectory;
@@ -543,6 +545,8 @@ Resource Type Resolver
 		struct GuiResourcePrecompileContext
 		{
 			typedef collections::Dictionary<Ptr<DescriptableObject>, Ptr<DescriptableObject>>	PropertyMap;
+			typedef Func<void(GuiResourcePrecompileContext&)>									SharedUpdate;
+			typedef collections::List<SharedUpdate>												SharedUpdateList;
 
 			/// <summary>Progress callback.</summary>
 			workflow::IWfCompilerCallback*						compilerCallback = nullptr;
@@ -556,6 +560,19 @@ Resource Type Resolver
 			Ptr<GuiResourcePathResolver>						resolver;
 			/// <summary>Additional properties for resource item contents</summary>
 			PropertyMap											additionalProperties;
+			/// <summary>The maximum number of threads to run a per-resource pass when all precompilers of this pass return PerResourceParallel.</summary>
+			vint												workerCount = 1;
+			/// <summary>Updates to shared states that are delayed by <see cref="UpdateSharedStates"/>. It is not null only when the current resource is precompiled in parallel.</summary>
+			SharedUpdateList*									pendingUpdates = nullptr;
+
+			/// <summary>
+			/// Update shared states, like objects in targetFolder or additionalProperties.
+			/// When resources are precompiled in parallel, the context only has a private copy of fields except additionalProperties,
+			/// the update is delayed until all resources of this pass are precompiled, and then applied to the shared context in the order of resources.
+			/// Otherwise, the update is applied immediately.
+			/// </summary>
+			/// <param name="update">The callback to update shared states, which receives the context that owns shared states.</param>
+			void												UpdateSharedStates(const SharedUpdate& update);
 		};
 
 		/// <summary>
@@ -598,6 +615,8 @@ Resource Type Resolver
 				NotSupported,
 				PerResource,
 				PerPass,
+				/// <summary>The same as PerResource, but resources could be precompiled in parallel. Shared states should only be updated by [M:vl.presentation.GuiResourcePrecompileContext.UpdateSharedStates].</summary>
+				PerResourceParallel,
 			};
 
 			/// <summary>Get the maximum pass index that the precompiler needs.</summary>
@@ -0,0 +1,125 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/GraphicsElement/WindowsDirect2D/GuiGraphicsWindowsDirect2D.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::elements::text;
+using namespace vl::presentation::elements_windows_d2d;
+
+namespace
+{
+	// only measures one code unit at a time, the default MeasureWidthsInternal is used
+	class TestCodeUnitCharMeasurer : public CharMeasurer
+	{
+	protected:
+		vint MeasureWidthInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)override
+		{
+			calls++;
+			if (0xD800 <= character && character < 0xDC00) return 3;
+			if (0xDC00 <= character && character < 0xE000) return 5;
+			return character < 0x80 ? 7 : 12;
+		}
+
+		vint GetRowHeightInternal(IGuiGraphicsRenderTarget* renderTarget)override
+		{
+			return 10;
+		}
+
+	public:
+		vint							calls = 0;
+
+		TestCodeUnitCharMeasurer()
+			:CharMeasurer(10)
+		{
+		}
+	};
+
+	// measures a surrogate pair as one glyph
+	class TestCodePointCharMeasurer : public TestCodeUnitCharMeasurer
+	{
+	protected:
+		vint MeasureCodePointWidthInternal(const wchar_t* characters, vint length, IGuiGraphicsRenderTarget* renderTarget)override
+		{
+			if (length == 2)
+			{
+				TEST_ASSERT(characters[0] == 0xD83D);
+				TEST_ASSERT(0xDE00 <= characters[1] && characters[1] <= 0xDE01);
+				calls++;
+				return 20;
+			}
+			return TestCodeUnitCharMeasurer::MeasureCodePointWidthInternal(characters, length, renderTarget);
+		}
+	};
+
+	void AssertWidths(CharMeasurer& measurer, const wchar_t* text, const vint* expected)
+	{
+		vint count = wcslen(text);
+		vint widths[16];
+		TEST_ASSERT(count <= sizeof(widths) / sizeof(*widths));
+		measurer.MeasureWidths(text, count, widths);
+		for (vint i = 0; i < count; i++)
+		{
+			TEST_ASSERT(widths[i] == expected[i]);
+		}
+	}
+}
+
+TEST_CASE(TestCharMeasurer_SurrogatePairs)
+{
+	// two surrogate pairs, one of them appears twice, and a low surrogate without a high surrogate
+	const wchar_t* text = L"a\xD83D\xDE00" L"b\xD83D\xDE01\xD83D\xDE00\xDC00";
+	const vint expected[] = { 7, 8, 0, 7, 8, 0, 8, 0, 5 };
+
+	TestCodeUnitCharMeasurer measurer;
+	AssertWidths(measurer, text, expected);
+	TEST_ASSERT(measurer.calls == 7);
+
+	// cached widths of surrogate pairs are the width of both code units
+	AssertWidths(measurer, text, expected);
+	TEST_ASSERT(measurer.calls == 7);
+	const vint expectedPair[] = { 8, 0 };
+	AssertWidths(measurer, L"\xD83D\xDE00", expectedPair);
+	TEST_ASSERT(measurer.MeasureWidth(L'a') == 7);
+	TEST_ASSERT(measurer.calls == 7);
+}
+
+TEST_CASE(TestCharMeasurer_SurrogatePairsAsOneGlyph)
+{
+	const wchar_t* text = L"a\xD83D\xDE00" L"b\xD83D\xDE01\xD83D\xDE00\xDC00";
+	const vint expected[] = { 7, 20, 0, 7, 20, 0, 20, 0, 5 };
+
+	TestCodePointCharMeasurer measurer;
+	AssertWidths(measurer, text, expected);
+	TEST_ASSERT(measurer.calls == 5);
+	AssertWidths(measurer, text, expected);
+	TEST_ASSERT(measurer.calls == 5);
+}
+
+TEST_CASE(TestCharMeasurer_Direct2DKerningAndLigatures)
+{
+	// kerning pairs and ligatures, a character measured with its neighbors has the same width as measured alone
+	const wchar_t* text = L"AVATAR WAVE To Ty fi ffl";
+	vint count = wcslen(text);
+
+	// underline does not change widths, but it makes a different measurer with a different cache
+	FontProperties font = GetCurrentController()->ResourceService()->GetDefaultFont();
+	font.size = 32;
+	FontProperties underlineFont = font;
+	underlineFont.underline = true;
+	auto measurer = GetWindowsDirect2DResourceManager()->CreateDirect2DCharMeasurer(font);
+	auto underlineMeasurer = GetWindowsDirect2DResourceManager()->CreateDirect2DCharMeasurer(underlineFont);
+	TEST_ASSERT(measurer != underlineMeasurer);
+
+	Array<vint> widths(count);
+	measurer->MeasureWidths(text, count, &widths[0]);
+	for (vint i = 0; i < count; i++)
+	{
+		TEST_ASSERT(widths[i] > 0);
+		TEST_ASSERT(widths[i] == underlineMeasurer->MeasureWidth(text[i]));
+	}
+
+	GetWindowsDirect2DResourceManager()->DestroyDirect2DCharMeasurer(font);
+	GetWindowsDirect2DResourceManager()->DestroyDirect2DCharMeasurer(underlineFont);
+}
@@ -0,0 +1,182 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Compiler/GuiInstanceLoader.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::filesystem;
+using namespace vl::regex;
+using namespace vl::parsing;
+using namespace vl::parsing::tabling;
+using namespace vl::parsing::xml;
+using namespace vl::workflow;
+
+extern WString GetTestResourcePath();
+
+namespace
+{
+	struct ColorizedToken
+	{
+		vint							start;
+		vint							length;
+		vint							token;
+
+		bool operator==(const ColorizedToken& value)const { return start == value.start && length == value.length && token == value.token; }
+		bool operator!=(const ColorizedToken& value)const { return !(*this == value); }
+	};
+
+	void CollectTokenProc(void* argument, vint start, vint length, vint token)
+	{
+		ColorizedToken colorizedToken;
+		colorizedToken.start = start;
+		colorizedToken.length = length;
+		colorizedToken.token = token;
+		((List<ColorizedToken>*)argument)->Add(colorizedToken);
+	}
+
+	void CountTokenProc(void* argument, vint start, vint length, vint token)
+	{
+		(*(vint*)argument)++;
+	}
+
+	Ptr<RegexLexer> CreateLexer(Ptr<ParsingTable> table)
+	{
+		// the same tokens that GuiGrammarColorizer gives to GuiTextBoxRegexColorizer
+		List<WString> tokens;
+		vint tokenCount = table->GetTokenCount();
+		for (vint token = ParsingTable::UserTokenStart; token < tokenCount; token++)
+		{
+			tokens.Add(table->GetTokenInfo(token).regex);
+		}
+		return new RegexLexer(tokens);
+	}
+
+	void LoadTestLines(List<WString>& lines)
+	{
+		List<File> files;
+		TEST_ASSERT(Folder(GetTestResourcePath()).GetFiles(files));
+		FOREACH(File, file, files)
+		{
+			auto name = file.GetFilePath().GetName();
+			if (name.Length() > 4 && name.Right(4) == L".xml")
+			{
+				file.ReadAllLinesByBom(lines);
+			}
+		}
+		TEST_ASSERT(lines.Count() > 0);
+
+		// cut lines at random positions, so that tokens, strings and comments could stop at the end of a line
+		vuint seed = 0;
+		vint count = lines.Count();
+		for (vint i = 0; i < count; i++)
+		{
+			auto line = lines[i];
+			if (line.Length() > 1)
+			{
+				seed = seed * 1103515245 + 12345;
+				vint cut = (vint)((seed >> 8) % (vuint)line.Length());
+				lines.Add(line.Left(cut));
+				lines.Add(line.Right(line.Length() - cut));
+			}
+		}
+	}
+
+	void AssertSameColorizing(RegexLexer& lexer, List<WString>& lines)
+	{
+		RegexLexerColorizer colorizer = lexer.Colorize();
+		RegexLexerColorizer walkerColorizer = lexer.Colorize();
+		List<ColorizedToken> tokens, walkerTokens;
+
+		FOREACH(WString, line, lines)
+		{
+			tokens.Clear();
+			walkerTokens.Clear();
+			colorizer.Colorize(line.Buffer(), line.Length(), &CollectTokenProc, &tokens);
+			walkerColorizer.ColorizeByWalker(line.Buffer(), line.Length(), &CollectTokenProc, &walkerTokens);
+
+			// the state is carried to the next line
+			TEST_ASSERT(colorizer.GetCurrentState() == walkerColorizer.GetCurrentState());
+			TEST_ASSERT(CompareEnumerable(tokens, walkerTokens) == 0);
+		}
+
+		// every line colorized from the start state
+		FOREACH(WString, line, lines)
+		{
+			tokens.Clear();
+			walkerTokens.Clear();
+			colorizer.Reset(colorizer.GetStartState());
+			walkerColorizer.Reset(walkerColorizer.GetStartState());
+			colorizer.Colorize(line.Buffer(), line.Length(), &CollectTokenProc, &tokens);
+			walkerColorizer.ColorizeByWalker(line.Buffer(), line.Length(), &CollectTokenProc, &walkerTokens);
+
+			TEST_ASSERT(colorizer.GetCurrentState() == walkerColorizer.GetCurrentState());
+			TEST_ASSERT(CompareEnumerable(tokens, walkerTokens) == 0);
+		}
+	}
+
+	void BenchmarkColorizing(const WString& name, RegexLexer& lexer, List<WString>& lines)
+	{
+		const vint repeat = 20;
+		vint characters = 0;
+		FOREACH(WString, line, lines)
+		{
+			characters += line.Length();
+		}
+
+		vint tokens = 0;
+		RegexLexerColorizer colorizer = lexer.Colorize();
+		auto start = DateTime::LocalTime();
+		for (vint i = 0; i < repeat; i++)
+		{
+			colorizer.Reset(colorizer.GetStartState());
+			FOREACH(WString, line, lines)
+			{
+				colorizer.Colorize(line.Buffer(), line.Length(), &CountTokenProc, &tokens);
+			}
+		}
+		auto stop = DateTime::LocalTime();
+
+		vint walkerTokens = 0;
+		RegexLexerColorizer walkerColorizer = lexer.Colorize();
+		auto walkerStart = DateTime::LocalTime();
+		for (vint i = 0; i < repeat; i++)
+		{
+			walkerColorizer.Reset(walkerColorizer.GetStartState());
+			FOREACH(WString, line, lines)
+			{
+				walkerColorizer.ColorizeByWalker(line.Buffer(), line.Length(), &CountTokenProc, &walkerTokens);
+			}
+		}
+		auto walkerStop = DateTime::LocalTime();
+		TEST_ASSERT(tokens == walkerTokens);
+
+		unittest::UnitTest::PrintInfo(
+			L"Colorized " + itow(characters * repeat) + L" characters with the " + name + L" lexer" +
+			L", Colorize: " + u64tow(stop.totalMilliseconds - start.totalMilliseconds) + L"ms" +
+			L", ColorizeByWalker: " + u64tow(walkerStop.totalMilliseconds - walkerStart.totalMilliseconds) + L"ms"
+			);
+	}
+}
+
+TEST_CASE(TestColorizer_XmlLexer)
+{
+	List<WString> lines;
+	LoadTestLines(lines);
+	auto lexer = CreateLexer(XmlLoadTable());
+	AssertSameColorizing(*lexer.Obj(), lines);
+}
+
+TEST_CASE(TestColorizer_WorkflowLexer)
+{
+	List<WString> lines;
+	LoadTestLines(lines);
+	auto lexer = CreateLexer(WfLoadTable());
+	AssertSameColorizing(*lexer.Obj(), lines);
+}
+
+TEST_CASE(TestColorizer_Benchmark)
+{
+	List<WString> lines;
+	LoadTestLines(lines);
+	BenchmarkColorizing(L"Xml", *CreateLexer(XmlLoadTable()).Obj(), lines);
+	BenchmarkColorizing(L"Workflow", *CreateLexer(WfLoadTable()).Obj(), lines);
+}
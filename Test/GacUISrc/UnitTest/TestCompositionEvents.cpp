@@ -0,0 +1,327 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::compositions;
+
+namespace
+{
+	class TestGraphicsHost : public GuiGraphicsHost
+	{
+	public:
+		TestGraphicsHost(GuiGraphicsComposition* boundsComposition)
+			:GuiGraphicsHost(nullptr, boundsComposition)
+		{
+		}
+
+		using GuiGraphicsHost::RaiseMouseEvent;
+
+		// GuiGraphicsHost receives mouse messages from the native window as a private INativeWindowListener
+		void MouseMoving(vint x, vint y)
+		{
+			NativeWindowMouseInfo info = {};
+			info.x = x;
+			info.y = y;
+			((presentation::INativeWindowListener*)this)->MouseMoving(info);
+		}
+
+		void MouseLeaved()
+		{
+			((presentation::INativeWindowListener*)this)->MouseLeaved();
+		}
+	};
+
+	GuiBoundsComposition* CreateHoverComposition(GuiGraphicsComposition* parent, Rect bounds, const WString& name, List<WString>& events)
+	{
+		auto composition = new GuiBoundsComposition;
+		composition->SetBounds(bounds);
+		parent->AddChild(composition);
+
+		auto receiver = composition->GetEventReceiver();
+		receiver->mouseEnter.AttachLambda([&events, name](GuiGraphicsComposition*, GuiEventArgs&)
+		{
+			events.Add(L"enter " + name);
+		});
+		receiver->mouseLeave.AttachLambda([&events, name](GuiGraphicsComposition*, GuiEventArgs&)
+		{
+			events.Add(L"leave " + name);
+		});
+		receiver->mouseMove.AttachLambda([&events, name](GuiGraphicsComposition*, GuiMouseEventArgs&)
+		{
+			events.Add(L"move " + name);
+		});
+		return composition;
+	}
+
+	void AssertEvents(List<WString>& events, const WString& expected)
+	{
+		WString actual;
+		FOREACH_INDEXER(WString, event, index, events)
+		{
+			actual += (index == 0 ? L"" : L", ") + event;
+		}
+		events.Clear();
+		TEST_ASSERT(actual == expected);
+	}
+}
+
+TEST_CASE(TestCompositionEvents_AttachDetach)
+{
+	GuiNotifyEvent event;
+	List<vint> calls;
+	Ptr<IGuiGraphicsEventHandler> handlers[4];
+
+	handlers[0] = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		calls.Add(0);
+		TEST_ASSERT(event.Detach(handlers[0]));
+		TEST_ASSERT(event.Detach(handlers[2]));
+		TEST_ASSERT(!event.Detach(handlers[2]));
+	});
+	handlers[1] = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		calls.Add(1);
+	});
+	handlers[2] = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		calls.Add(2);
+	});
+	handlers[3] = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		calls.Add(3);
+	});
+
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(calls.Count() == 3);
+	TEST_ASSERT(calls[0] == 0);
+	TEST_ASSERT(calls[1] == 1);
+	TEST_ASSERT(calls[2] == 3);
+	TEST_ASSERT(!handlers[0]->IsAttached());
+	TEST_ASSERT(handlers[1]->IsAttached());
+	TEST_ASSERT(!handlers[2]->IsAttached());
+
+	calls.Clear();
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(calls.Count() == 2);
+	TEST_ASSERT(calls[0] == 1);
+	TEST_ASSERT(calls[1] == 3);
+
+	TEST_ASSERT(event.Detach(handlers[1]));
+	TEST_ASSERT(event.Detach(handlers[3]));
+	calls.Clear();
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(calls.Count() == 0);
+
+	// a handler detaches itself and releases the only other reference to it, its captures are still used after that
+	Ptr<IGuiGraphicsEventHandler> selfReleasing;
+	selfReleasing = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		TEST_ASSERT(event.Detach(selfReleasing));
+		selfReleasing = nullptr;
+		calls.Add(4);
+	});
+	handlers[1] = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		calls.Add(1);
+	});
+
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(!selfReleasing);
+	TEST_ASSERT(calls.Count() == 2);
+	TEST_ASSERT(calls[0] == 4);
+	TEST_ASSERT(calls[1] == 1);
+
+	calls.Clear();
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(calls.Count() == 1);
+	TEST_ASSERT(calls[0] == 1);
+}
+
+TEST_CASE(TestCompositionEvents_RaiseMouseEventOnDeepTemplate)
+{
+	const vint depth = 256;
+	const vint handlerStep = 4;
+	const vint eventCount = 10000;
+
+	auto root = new GuiBoundsComposition;
+	auto leaf = root;
+	for (vint i = 1; i < depth; i++)
+	{
+		auto child = new GuiBoundsComposition;
+		leaf->AddChild(child);
+		leaf = child;
+	}
+
+	vint calls = 0;
+	vint depthToHandle = -1;
+	{
+		GuiGraphicsComposition* composition = leaf;
+		for (vint i = 0; composition; i++)
+		{
+			if (i % handlerStep == 0)
+			{
+				composition->GetEventReceiver()->mouseMove.AttachLambda([&, i](GuiGraphicsComposition*, GuiMouseEventArgs& arguments)
+				{
+					calls++;
+					if (i == depthToHandle)
+					{
+						arguments.handled = true;
+					}
+				});
+			}
+			composition = composition->GetParent();
+		}
+	}
+
+	{
+		TestGraphicsHost host(root);
+
+		GuiMouseEventArgs arguments;
+		host.RaiseMouseEvent(arguments, leaf, &GuiGraphicsEventReceiver::mouseMove);
+		TEST_ASSERT(calls == depth / handlerStep);
+		TEST_ASSERT(arguments.compositionSource == leaf);
+		TEST_ASSERT(arguments.eventSource == leaf);
+
+		calls = 0;
+		depthToHandle = handlerStep * 3;
+		arguments = GuiMouseEventArgs();
+		host.RaiseMouseEvent(arguments, leaf, &GuiGraphicsEventReceiver::mouseMove);
+		TEST_ASSERT(calls == 4);
+		depthToHandle = -1;
+
+		calls = 0;
+		auto start = DateTime::LocalTime();
+		for (vint i = 0; i < eventCount; i++)
+		{
+			arguments = GuiMouseEventArgs();
+			host.RaiseMouseEvent(arguments, leaf, &GuiGraphicsEventReceiver::mouseMove);
+		}
+		auto stop = DateTime::LocalTime();
+		TEST_ASSERT(calls == eventCount * depth / handlerStep);
+
+		unittest::UnitTest::PrintInfo(
+			L"Routed " + itow(eventCount) + L" mouse events through " + itow(depth) + L" compositions in " +
+			u64tow(stop.totalMilliseconds - start.totalMilliseconds) + L"ms"
+			);
+	}
+	delete root;
+}
+
+TEST_CASE(TestCompositionEvents_MouseMovingReusesHoverRoute)
+{
+	List<WString> events;
+	auto root = new GuiBoundsComposition;
+	root->SetBounds(Rect(0, 0, 300, 300));
+	auto a = CreateHoverComposition(root, Rect(0, 0, 200, 200), L"a", events);
+	auto b = CreateHoverComposition(a, Rect(0, 0, 100, 100), L"b", events);
+	auto c = CreateHoverComposition(root, Rect(200, 0, 300, 100), L"c", events);
+	root->GetEventReceiver()->mouseEnter.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&) { events.Add(L"enter root"); });
+	root->GetEventReceiver()->mouseLeave.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&) { events.Add(L"leave root"); });
+	root->GetEventReceiver()->mouseMove.AttachLambda([&](GuiGraphicsComposition*, GuiMouseEventArgs&) { events.Add(L"move root"); });
+
+	auto window = GetCurrentController()->WindowService()->CreateNativeWindow();
+	window->SetClientSize(Size(300, 300));
+	{
+		TestGraphicsHost host(root);
+		host.SetNativeWindow(window);
+
+		host.MouseMoving(50, 50);
+		AssertEvents(events, L"enter root, enter a, enter b, move b, move a, move root");
+
+		// the hovered composition is not changed, the route is reused
+		host.MouseMoving(60, 60);
+		AssertEvents(events, L"move b, move a, move root");
+
+		host.MouseMoving(150, 150);
+		AssertEvents(events, L"leave b, move a, move root");
+		host.MouseMoving(160, 160);
+		AssertEvents(events, L"move a, move root");
+
+		host.MouseMoving(50, 50);
+		AssertEvents(events, L"enter b, move b, move a, move root");
+		host.MouseMoving(250, 50);
+		AssertEvents(events, L"leave b, leave a, enter c, move c, move root");
+		host.MouseMoving(50, 50);
+		AssertEvents(events, L"leave c, enter a, enter b, move b, move a, move root");
+
+		// a hovered ancestor is removed and deleted between moves, it is dropped from the route with its children
+		root->RemoveChild(a);
+		delete a;
+		host.MouseMoving(50, 50);
+		AssertEvents(events, L"move root");
+		host.MouseMoving(250, 50);
+		AssertEvents(events, L"enter c, move c, move root");
+
+		// the hovered composition itself is removed and deleted between moves
+		root->RemoveChild(c);
+		delete c;
+		host.MouseMoving(250, 50);
+		AssertEvents(events, L"move root");
+
+		auto d = CreateHoverComposition(root, Rect(0, 0, 100, 100), L"d", events);
+		host.MouseMoving(50, 50);
+		AssertEvents(events, L"enter d, move d, move root");
+
+		host.MouseLeaved();
+		AssertEvents(events, L"leave d, leave root");
+
+		host.SetNativeWindow(nullptr);
+	}
+	GetCurrentController()->WindowService()->DestroyNativeWindow(window);
+	delete root;
+}
+
+TEST_CASE(TestCompositionEvents_MouseMovingOnDeepTemplate)
+{
+	const vint depth = 256;
+	const vint eventCount = 10000;
+
+	auto root = new GuiBoundsComposition;
+	root->SetBounds(Rect(0, 0, 300, 300));
+	auto leaf = root;
+	for (vint i = 1; i < depth; i++)
+	{
+		auto child = new GuiBoundsComposition;
+		child->SetBounds(Rect(0, 0, 300, 300));
+		leaf->AddChild(child);
+		leaf = child;
+	}
+
+	vint enters = 0;
+	vint moves = 0;
+	leaf->GetEventReceiver()->mouseEnter.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		enters++;
+	});
+	root->GetEventReceiver()->mouseMove.AttachLambda([&](GuiGraphicsComposition*, GuiMouseEventArgs&)
+	{
+		moves++;
+	});
+
+	auto window = GetCurrentController()->WindowService()->CreateNativeWindow();
+	window->SetClientSize(Size(300, 300));
+	{
+		TestGraphicsHost host(root);
+		host.SetNativeWindow(window);
+
+		auto start = DateTime::LocalTime();
+		for (vint i = 0; i < eventCount; i++)
+		{
+			host.MouseMoving(i % 300, 150);
+		}
+		auto stop = DateTime::LocalTime();
+		TEST_ASSERT(enters == 1);
+		TEST_ASSERT(moves == eventCount);
+
+		unittest::UnitTest::PrintInfo(
+			L"Moved the mouse " + itow(eventCount) + L" times over " + itow(depth) + L" compositions in " +
+			u64tow(stop.totalMilliseconds - start.totalMilliseconds) + L"ms"
+			);
+
+		host.MouseLeaved();
+		host.SetNativeWindow(nullptr);
+	}
+	GetCurrentController()->WindowService()->DestroyNativeWindow(window);
+	delete root;
+}
@@ -0,0 +1,189 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::compositions;
+
+namespace
+{
+	// more children than HitTestGridThreshold, so that FindComposition uses the hit test grid
+	const vint ChildCount = GuiGraphicsComposition::HitTestGridThreshold + 8;
+
+	GuiBoundsComposition* CreateParent()
+	{
+		auto parent = new GuiBoundsComposition;
+		parent->SetBounds(Rect(0, 0, 400, 400));
+		return parent;
+	}
+
+	class CountingBoundsComposition : public GuiBoundsComposition
+	{
+	public:
+		vint							getBoundsCount = 0;
+
+		Rect GetBounds()override
+		{
+			getBoundsCount++;
+			return GuiBoundsComposition::GetBounds();
+		}
+	};
+
+	vint TakeGetBoundsCount(List<CountingBoundsComposition*>& children)
+	{
+		vint count = 0;
+		FOREACH(CountingBoundsComposition*, child, children)
+		{
+			count += child->getBoundsCount;
+			child->getBoundsCount = 0;
+		}
+		return count;
+	}
+
+	void AssertFound(GuiGraphicsComposition* root, Point location, GuiGraphicsComposition* expected)
+	{
+		TEST_ASSERT(root->FindComposition(location, false) == expected);
+	}
+}
+
+TEST_CASE(TestCompositionHitTest_ChildBoundsChanged)
+{
+	auto parent = CreateParent();
+	List<GuiBoundsComposition*> children;
+	for (vint i = 0; i < ChildCount; i++)
+	{
+		auto child = new GuiBoundsComposition;
+		child->SetBounds(Rect(Point(i * 10, 0), Size(10, 10)));
+		parent->AddChild(child);
+		children.Add(child);
+	}
+
+	for (vint i = 0; i < ChildCount; i++)
+	{
+		AssertFound(parent, Point(i * 10 + 5, 5), children[i]);
+	}
+	AssertFound(parent, Point(5, 105), parent);
+
+	// moving a child does not call GetBounds on it before the next hit test
+	children[3]->SetBounds(Rect(Point(0, 100), Size(10, 10)));
+	AssertFound(parent, Point(5, 105), children[3]);
+	AssertFound(parent, Point(35, 5), parent);
+	AssertFound(parent, Point(5, 5), children[0]);
+
+	// hiding and moving children in front of others
+	children[4]->SetBounds(Rect(Point(0, 0), Size(20, 10)));
+	AssertFound(parent, Point(5, 5), children[4]);
+	AssertFound(parent, Point(15, 5), children[4]);
+	children[4]->SetVisible(false);
+	AssertFound(parent, Point(5, 5), children[0]);
+	AssertFound(parent, Point(15, 5), children[1]);
+
+	SafeDeleteComposition(parent);
+}
+
+TEST_CASE(TestCompositionHitTest_ParentBoundsChanged)
+{
+	// children are stretched to the right border of the parent
+	auto parent = CreateParent();
+	List<GuiBoundsComposition*> children;
+	for (vint i = 0; i < ChildCount; i++)
+	{
+		auto child = new GuiBoundsComposition;
+		child->SetBounds(Rect(Point(0, 0), Size(10, 10)));
+		child->SetAlignmentToParent(Margin(i * 10, 0, 0, -1));
+		parent->AddChild(child);
+		children.Add(child);
+	}
+
+	for (vint i = 0; i < ChildCount; i++)
+	{
+		AssertFound(parent, Point(i * 10 + 5, 5), children[i]);
+	}
+	AssertFound(parent, Point(450, 5), nullptr);
+
+	// resizing the parent resizes all children without calling GetBounds on them
+	parent->SetBounds(Rect(0, 0, 600, 400));
+	for (vint i = 0; i < ChildCount; i++)
+	{
+		AssertFound(parent, Point(i * 10 + 5, 5), children[i]);
+	}
+	AssertFound(parent, Point(450, 5), children[ChildCount - 1]);
+	AssertFound(parent, Point(550, 5), children[ChildCount - 1]);
+	AssertFound(parent, Point(5, 15), parent);
+
+	// changing the client area of the parent also resizes all children
+	parent->SetInternalMargin(Margin(0, 0, 100, 0));
+	AssertFound(parent, Point(450, 5), children[ChildCount - 1]);
+	AssertFound(parent, Point(550, 5), parent);
+
+	SafeDeleteComposition(parent);
+}
+
+TEST_CASE(TestCompositionHitTest_StackLayoutChanged)
+{
+	auto stack = new GuiStackComposition;
+	stack->SetBounds(Rect(0, 0, 100, 1000));
+	stack->SetDirection(GuiStackComposition::Vertical);
+	List<GuiStackItemComposition*> items;
+	for (vint i = 0; i < ChildCount; i++)
+	{
+		auto item = new GuiStackItemComposition;
+		item->SetPreferredMinSize(Size(100, 10));
+		stack->AddChild(item);
+		items.Add(item);
+	}
+
+	for (vint i = 0; i < ChildCount; i++)
+	{
+		AssertFound(stack, Point(50, i * 10 + 5), items[i]);
+	}
+
+	// the stack moves all items in the next layout pass after the padding changes
+	stack->SetPadding(10);
+	stack->ForceCalculateSizeImmediately();
+	for (vint i = 0; i < ChildCount; i++)
+	{
+		AssertFound(stack, Point(50, i * 20 + 5), items[i]);
+		AssertFound(stack, Point(50, i * 20 + 15), stack);
+	}
+
+	// the stack moves following items when an item grows
+	items[0]->SetPreferredMinSize(Size(100, 30));
+	AssertFound(stack, Point(50, 25), items[0]);
+	for (vint i = 1; i < ChildCount; i++)
+	{
+		AssertFound(stack, Point(50, i * 20 + 25), items[i]);
+	}
+
+	SafeDeleteComposition(stack);
+}
+
+TEST_CASE(TestCompositionHitTest_ElementChanged)
+{
+	auto parent = CreateParent();
+	List<CountingBoundsComposition*> children;
+	for (vint i = 0; i < ChildCount; i++)
+	{
+		auto child = new CountingBoundsComposition;
+		child->SetBounds(Rect(Point(i * 10, 0), Size(10, 10)));
+		parent->AddChild(child);
+		children.Add(child);
+	}
+
+	AssertFound(parent, Point(55, 5), children[5]);
+	TEST_ASSERT(TakeGetBoundsCount(children) >= ChildCount);
+	AssertFound(parent, Point(55, 5), children[5]);
+	TEST_ASSERT(TakeGetBoundsCount(children) < ChildCount);
+
+	// elements call this function when their properties change, which does not rebuild the hit test grid of the parent
+	InvokeOnCompositionStateChanged(children[5]);
+	AssertFound(parent, Point(55, 5), children[5]);
+	TEST_ASSERT(TakeGetBoundsCount(children) < ChildCount);
+
+	// changing the visibility of a child rebuilds the hit test grid
+	children[5]->SetVisible(false);
+	AssertFound(parent, Point(55, 5), parent);
+	TEST_ASSERT(TakeGetBoundsCount(children) >= ChildCount);
+
+	SafeDeleteComposition(parent);
+}
@@ -0,0 +1,168 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::compositions;
+
+namespace
+{
+	class TestRenderTarget : public Object, public IGuiGraphicsRenderTarget
+	{
+	protected:
+		Rect							targetBounds;
+		List<Rect>						clippers;
+		vint							clipperCoverWholeTargetCounter = 0;
+
+	public:
+		TestRenderTarget(Size size)
+			:targetBounds(Point(0, 0), size)
+		{
+		}
+
+		void StartRendering()override
+		{
+		}
+
+		RenderTargetFailure StopRendering()override
+		{
+			return RenderTargetFailure::None;
+		}
+
+		void PushClipper(Rect clipper)override
+		{
+			if (clipperCoverWholeTargetCounter > 0)
+			{
+				clipperCoverWholeTargetCounter++;
+			}
+			else
+			{
+				Rect currentClipper = GetClipper().Intersect(clipper);
+				if (currentClipper.IsEmpty())
+				{
+					clipperCoverWholeTargetCounter++;
+				}
+				else
+				{
+					clippers.Add(currentClipper);
+				}
+			}
+		}
+
+		void PopClipper()override
+		{
+			if (clipperCoverWholeTargetCounter > 0)
+			{
+				clipperCoverWholeTargetCounter--;
+			}
+			else if (clippers.Count() > 0)
+			{
+				clippers.RemoveAt(clippers.Count() - 1);
+			}
+		}
+
+		Rect GetClipper()override
+		{
+			return clippers.Count() == 0 ? targetBounds : clippers[clippers.Count() - 1];
+		}
+
+		bool IsClipperCoverWholeTarget()override
+		{
+			return clipperCoverWholeTargetCounter > 0;
+		}
+
+		bool IsContentPreserved()override
+		{
+			return true;
+		}
+	};
+
+	class TestGraphicsHost : public GuiGraphicsHost
+	{
+	public:
+		TestGraphicsHost(GuiGraphicsComposition* boundsComposition)
+			:GuiGraphicsHost(nullptr, boundsComposition)
+		{
+		}
+	};
+
+	class TestRenderComposition : public GuiBoundsComposition
+	{
+	public:
+		GraphicsHostRecord					record;
+
+		void Attach(GuiGraphicsHost* host, IGuiGraphicsRenderTarget* renderTarget)
+		{
+			record.host = host;
+			record.renderTarget = renderTarget;
+			UpdateRelatedHostRecord(&record);
+		}
+
+		void Detach()
+		{
+			UpdateRelatedHostRecord(nullptr);
+		}
+
+		Rect GetRenderedBounds()
+		{
+			return renderedBounds;
+		}
+	};
+
+	void RenderFrame(TestRenderTarget& renderTarget, GuiGraphicsComposition* root, Rect invalidatedArea)
+	{
+		renderTarget.StartRendering();
+		renderTarget.PushClipper(invalidatedArea);
+		if (!renderTarget.IsClipperCoverWholeTarget())
+		{
+			root->Render(Size());
+		}
+		renderTarget.PopClipper();
+		renderTarget.StopRendering();
+	}
+}
+
+TEST_CASE(TestCompositionRendering_MoveAfterPartialFrame)
+{
+	TestRenderTarget renderTarget(Size(100, 100));
+	TestGraphicsHost host(new GuiBoundsComposition);
+
+	auto root = new TestRenderComposition;
+	auto child = new TestRenderComposition;
+	root->SetBounds(Rect(0, 0, 100, 100));
+	child->SetBounds(Rect(10, 10, 60, 60));
+	root->AddChild(child);
+	root->Attach(&host, &renderTarget);
+
+	RenderFrame(renderTarget, root, Rect(0, 0, 100, 100));
+	TEST_ASSERT(root->GetRenderedBounds() == Rect(0, 0, 100, 100));
+	TEST_ASSERT(child->GetRenderedBounds() == Rect(10, 10, 60, 60));
+
+	// a partial frame that only covers a part of the child
+	RenderFrame(renderTarget, root, Rect(0, 0, 30, 30));
+	TEST_ASSERT(child->GetRenderedBounds() == Rect(10, 10, 60, 60));
+
+	// a partial frame that does not cover the child at all
+	RenderFrame(renderTarget, root, Rect(80, 0, 100, 5));
+	TEST_ASSERT(child->GetRenderedBounds() == Rect(10, 10, 60, 60));
+
+	// the whole old area is still recorded when the child is moved, and the new area is recorded after rendering it
+	child->SetBounds(Rect(50, 50, 90, 90));
+	TEST_ASSERT(child->GetRenderedBounds() == Rect(10, 10, 60, 60));
+	RenderFrame(renderTarget, root, Rect(10, 10, 60, 60).Union(Rect(50, 50, 90, 90)));
+	TEST_ASSERT(child->GetRenderedBounds() == Rect(50, 50, 90, 90));
+
+	// only the part inside the parent is displayed
+	child->SetBounds(Rect(80, 80, 150, 150));
+	RenderFrame(renderTarget, root, Rect(50, 50, 100, 100));
+	TEST_ASSERT(child->GetRenderedBounds() == Rect(80, 80, 100, 100));
+
+	// a hidden composition covers nothing
+	child->SetVisible(false);
+	RenderFrame(renderTarget, root, Rect(80, 80, 100, 100));
+	TEST_ASSERT(child->GetRenderedBounds() == Rect());
+
+	root->Detach();
+	delete root;
+}
@@ -0,0 +1,353 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::presentation::controls;
+using namespace vl::presentation::controls::list;
+
+namespace
+{
+	typedef vint(RowKeyFunction)(vint);
+
+	vint RowKey1(vint x) { return x % 7; }
+	vint RowKey2(vint x) { return (x * 31) % 13; }
+	vint RowKey3(vint x) { return x; }
+
+	class TestCompareSorter : public DataSorterBase
+	{
+	protected:
+		RowKeyFunction*					function;
+
+	public:
+		TestCompareSorter(RowKeyFunction* _function)
+			:function(_function)
+		{
+		}
+
+		vint Compare(const Value& row1, const Value& row2)override
+		{
+			vint key1 = function(UnboxValue<vint>(row1));
+			vint key2 = function(UnboxValue<vint>(row2));
+			return key1 < key2 ? -1 : key1 > key2 ? 1 : 0;
+		}
+	};
+
+	Ptr<IDataSorter> CreateKeySorter(RowKeyFunction* function, bool textKey)
+	{
+		auto sorter = MakePtr<DataKeySorter>();
+		sorter->SetKeyProperty([=](const Value& row)
+		{
+			DataSortKey key;
+			vint value = function(UnboxValue<vint>(row));
+			if (textKey)
+			{
+				// fixed length text keys are ordered in the same way as their numbers
+				WString text = itow(value);
+				while (text.Length() < 8)
+				{
+					text = L"0" + text;
+				}
+				key.text = text;
+			}
+			else
+			{
+				key.integer = value;
+			}
+			return key;
+		});
+		return sorter;
+	}
+
+	Ptr<IDataSorter> CreateMultipleSorter(Ptr<IDataSorter> left, Ptr<IDataSorter> right)
+	{
+		auto sorter = MakePtr<DataMultipleSorter>();
+		sorter->SetLeftSorter(left);
+		sorter->SetRightSorter(right);
+		return sorter;
+	}
+
+	Ptr<IDataSorter> CreateReverseSorter(Ptr<IDataSorter> sub)
+	{
+		auto sorter = MakePtr<DataReverseSorter>();
+		sorter->SetSubSorter(sub);
+		return sorter;
+	}
+
+	// key1 ascending, key2 descending, and then the row itself, which is a total order
+	Ptr<IDataSorter> CreateSorter(bool key1ByKey, bool key2ByKey, bool key3ByKey)
+	{
+		auto sorter1 = key1ByKey ? CreateKeySorter(&RowKey1, false) : Ptr<IDataSorter>(new TestCompareSorter(&RowKey1));
+		auto sorter2 = key2ByKey ? CreateKeySorter(&RowKey2, true) : Ptr<IDataSorter>(new TestCompareSorter(&RowKey2));
+		auto sorter3 = key3ByKey ? CreateKeySorter(&RowKey3, false) : Ptr<IDataSorter>(new TestCompareSorter(&RowKey3));
+		return CreateMultipleSorter(CreateMultipleSorter(sorter1, CreateReverseSorter(sorter2)), sorter3);
+	}
+
+	void SortRows(vint rowCount, Ptr<IDataSorter> sorter, bool ascending, List<vint>& rows)
+	{
+		auto itemSource = IValueList::Create();
+		for (vint i = 0; i < rowCount; i++)
+		{
+			// rows are not in order in the item source
+			itemSource->Add(BoxValue<vint>((i * 7919) % rowCount));
+		}
+
+		DataProvider provider;
+		auto column = MakePtr<DataColumn>();
+		column->SetSorter(sorter);
+		provider.GetColumns().Add(column);
+		provider.SetItemSource(itemSource);
+		provider.SortByColumn(0, ascending);
+
+		rows.Clear();
+		TEST_ASSERT(provider.Count() == rowCount);
+		for (vint i = 0; i < rowCount; i++)
+		{
+			rows.Add(UnboxValue<vint>(provider.GetBindingValue(i)));
+		}
+	}
+
+	void AssertSameOrder(vint rowCount, bool key1ByKey, bool key2ByKey, bool key3ByKey)
+	{
+		for (vint i = 0; i < 2; i++)
+		{
+			bool ascending = i == 0;
+			List<vint> expected, actual;
+			SortRows(rowCount, CreateSorter(false, false, false), ascending, expected);
+			SortRows(rowCount, CreateSorter(key1ByKey, key2ByKey, key3ByKey), ascending, actual);
+			TEST_ASSERT(CompareEnumerable(expected, actual) == 0);
+		}
+	}
+
+	class TestCountingKeySorter : public DataKeySorterBase
+	{
+	public:
+		vint							count = 0;
+
+		void GetSortKey(const Value& row, DataSortKey& key)override
+		{
+			count++;
+			key.integer = RowKey1(UnboxValue<vint>(row));
+		}
+	};
+
+	class TestFilter : public DataFilterBase
+	{
+	protected:
+		vint							modulus;
+
+	public:
+		TestFilter(vint _modulus)
+			:modulus(_modulus)
+		{
+		}
+
+		bool Filter(const Value& row)override
+		{
+			return UnboxValue<vint>(row) % modulus != 0;
+		}
+	};
+
+	// background filtering is driven step by step, instead of waiting for the thread pool and the main thread
+	class TestBackgroundDataProvider : public DataProvider
+	{
+	public:
+		using DataProvider::FilterTask;
+		using DataProvider::CreateFilterTask;
+		using DataProvider::PublishFilterTask;
+		using DataProvider::ReorderRows;
+
+		void SetFilterWithoutReordering(Ptr<IDataFilter> value)
+		{
+			additionalFilter = value;
+			RebuildFilter();
+		}
+	};
+
+	void SetupProvider(DataProvider& provider, Ptr<IValueEnumerable> itemSource, Ptr<IDataSorter> sorter, bool filter)
+	{
+		auto column = MakePtr<DataColumn>();
+		column->SetSorter(sorter);
+		provider.GetColumns().Add(column);
+		if (filter)
+		{
+			provider.SetAdditionalFilter(new TestFilter(3));
+		}
+		provider.SetItemSource(itemSource);
+		if (sorter)
+		{
+			provider.SortByColumn(0, true);
+		}
+	}
+
+	void GetRows(DataProvider& provider, List<vint>& rows)
+	{
+		rows.Clear();
+		for (vint i = 0; i < provider.Count(); i++)
+		{
+			rows.Add(UnboxValue<vint>(provider.GetBindingValue(i)));
+		}
+	}
+
+	// rows are unique, but only (row % 7) is compared, so that many rows have equal keys
+	void AssertIncrementalOrder(const Func<Ptr<IDataSorter>()>& createSorter, bool filter)
+	{
+		auto itemSource = IValueObservableList::Create();
+		vint nextRow = 0;
+		for (vint i = 0; i < 1000; i++)
+		{
+			itemSource->Add(BoxValue<vint>(nextRow++));
+		}
+
+		DataProvider provider;
+		SetupProvider(provider, itemSource, createSorter(), filter);
+
+		vuint seed = 0;
+		auto random = [&](vint range)
+		{
+			seed = seed * 1103515245 + 12345;
+			return (vint)((seed >> 8) % range);
+		};
+
+		for (vint i = 0; i < 300; i++)
+		{
+			vint index = random(itemSource->GetCount());
+			switch (random(3))
+			{
+			case 0:
+				itemSource->Insert(index, BoxValue<vint>(nextRow++));
+				break;
+			case 1:
+				itemSource->RemoveAt(index);
+				break;
+			default:
+				// a new row in the same place changes the key
+				itemSource->Set(index, BoxValue<vint>(nextRow++));
+			}
+
+			// an item source that is not observable is always fully sorted
+			auto copiedSource = IValueList::Create();
+			for (vint j = 0; j < itemSource->GetCount(); j++)
+			{
+				copiedSource->Add(itemSource->Get(j));
+			}
+			DataProvider expectedProvider;
+			SetupProvider(expectedProvider, copiedSource, createSorter(), filter);
+
+			List<vint> expected, actual;
+			GetRows(expectedProvider, expected);
+			GetRows(provider, actual);
+			TEST_ASSERT(CompareEnumerable(expected, actual) == 0);
+		}
+	}
+}
+
+TEST_CASE(TestDataProvider_SortByKeys)
+{
+	// fewer rows than ParallelSortThreshold
+	AssertSameOrder(1000, true, true, true);
+}
+
+TEST_CASE(TestDataProvider_SortByKeysInParallel)
+{
+	// more rows than ParallelSortThreshold
+	AssertSameOrder(20000, true, true, true);
+}
+
+TEST_CASE(TestDataProvider_SortByKeysAndComparers)
+{
+	// a sorter that is not a key sorter keeps the sorting in the UI thread
+	AssertSameOrder(1000, true, false, true);
+	AssertSameOrder(20000, false, true, false);
+}
+
+TEST_CASE(TestDataProvider_SortKeysComputedOncePerRow)
+{
+	const vint rowCount = 5000;
+	auto keySorter = MakePtr<TestCountingKeySorter>();
+	List<vint> rows;
+	SortRows(rowCount, CreateMultipleSorter(keySorter, new TestCompareSorter(&RowKey3)), true, rows);
+	TEST_ASSERT(keySorter->count == rowCount);
+	for (vint i = 1; i < rowCount; i++)
+	{
+		vint key1 = RowKey1(rows[i - 1]);
+		vint key2 = RowKey1(rows[i]);
+		TEST_ASSERT(key1 < key2 || (key1 == key2 && rows[i - 1] < rows[i]));
+	}
+}
+
+TEST_CASE(TestDataProvider_ReorderRowsIncrementally)
+{
+	// inserted, removed and changed rows are merged into the view in the same order as a full sorting
+	AssertIncrementalOrder([]() { return Ptr<IDataSorter>(); }, true);
+	AssertIncrementalOrder([]() { return CreateKeySorter(&RowKey1, false); }, false);
+	AssertIncrementalOrder([]() { return CreateKeySorter(&RowKey1, false); }, true);
+	AssertIncrementalOrder([]() { return Ptr<IDataSorter>(new TestCompareSorter(&RowKey1)); }, true);
+	AssertIncrementalOrder([]() { return CreateReverseSorter(CreateKeySorter(&RowKey1, false)); }, true);
+	AssertIncrementalOrder([]() { return CreateMultipleSorter(CreateKeySorter(&RowKey1, false), new TestCompareSorter(&RowKey2)); }, true);
+}
+
+TEST_CASE(TestDataProvider_FilterInBackground)
+{
+	auto itemSource = IValueObservableList::Create();
+	for (vint i = 0; i < 1000; i++)
+	{
+		itemSource->Add(BoxValue<vint>(i));
+	}
+
+	TestBackgroundDataProvider provider;
+	SetupProvider(provider, itemSource, CreateKeySorter(&RowKey1, false), false);
+	List<vint> expected, actual;
+
+	// a newer filter cancels the previous task, and all tasks share the same copy of the item source
+	provider.SetFilterWithoutReordering(new TestFilter(2));
+	auto task1 = provider.CreateFilterTask();
+	provider.SetFilterWithoutReordering(new TestFilter(3));
+	auto task2 = provider.CreateFilterTask();
+	TEST_ASSERT(task1->cancelled);
+	TEST_ASSERT(!task2->cancelled);
+	TEST_ASSERT(task1->rows == task2->rows);
+	task1->Run();
+	TEST_ASSERT(task1->filteredRows.Count() == 0);
+
+	// a cancelled task does not change rows
+	GetRows(provider, expected);
+	TEST_ASSERT(expected.Count() == 1000);
+	provider.PublishFilterTask(task1);
+	GetRows(provider, actual);
+	TEST_ASSERT(CompareEnumerable(expected, actual) == 0);
+
+	// the published result is the same as filtering in the UI thread
+	task2->Run();
+	provider.PublishFilterTask(task2);
+	GetRows(provider, actual);
+	provider.ReorderRows(true);
+	GetRows(provider, expected);
+	TEST_ASSERT(expected.Count() < 1000);
+	TEST_ASSERT(CompareEnumerable(expected, actual) == 0);
+
+	// modifying the item source cancels the running task, and the next task copies the item source again
+	provider.SetFilterWithoutReordering(new TestFilter(5));
+	auto task3 = provider.CreateFilterTask();
+	TEST_ASSERT(task3->rows == task2->rows);
+	for (vint i = 0; i < 10; i++)
+	{
+		itemSource->RemoveAt(0);
+	}
+	TEST_ASSERT(task3->cancelled);
+	GetRows(provider, expected);
+	task3->Run();
+	provider.PublishFilterTask(task3);
+	GetRows(provider, actual);
+	TEST_ASSERT(CompareEnumerable(expected, actual) == 0);
+
+	auto task4 = provider.CreateFilterTask();
+	TEST_ASSERT(task4->rows != task2->rows);
+	TEST_ASSERT(task4->rows->Count() == 990);
+	task4->Run();
+	provider.PublishFilterTask(task4);
+	GetRows(provider, actual);
+	provider.ReorderRows(true);
+	GetRows(provider, expected);
+	TEST_ASSERT(CompareEnumerable(expected, actual) == 0);
+}
@@ -0,0 +1,357 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Reflection/GuiInstanceCompiledWorkflow.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::filesystem;
+using namespace vl::parsing;
+using namespace vl::presentation;
+using namespace vl::workflow;
+
+extern WString GetTestResourcePath();
+
+namespace
+{
+	// a key with a chosen hash code, so that keys could collide and wrap around the end of slots
+	struct CollidingKey
+	{
+		vint							value;
+		vuint64_t						hash;
+
+		CollidingKey(vint _value = 0, vuint64_t _hash = 0)
+			:value(_value)
+			, hash(_hash)
+		{
+		}
+
+		bool operator==(const CollidingKey& key)const { return value == key.value; }
+		bool operator!=(const CollidingKey& key)const { return value != key.value; }
+	};
+}
+
+namespace vl
+{
+	namespace collections
+	{
+		template<>
+		struct HashKeyType<CollidingKey>
+		{
+			static vuint64_t GetHashCode(const CollidingKey& key)
+			{
+				return key.hash;
+			}
+		};
+	}
+}
+
+namespace
+{
+	template<typename TKey, typename TValue>
+	void AssertSameDictionary(const HashDictionary<TKey, TValue>& actual, const Dictionary<TKey, TValue>& expected)
+	{
+		TEST_ASSERT(actual.Count() == expected.Count());
+		TEST_ASSERT(actual.Keys().Count() == expected.Count());
+		TEST_ASSERT(actual.Values().Count() == expected.Count());
+		for (vint i = 0; i < expected.Count(); i++)
+		{
+			vint index = actual.Keys().IndexOf(expected.Keys()[i]);
+			TEST_ASSERT(index != -1);
+			TEST_ASSERT(actual.Keys()[index] == expected.Keys()[i]);
+			TEST_ASSERT(actual.Values()[index] == expected.Values()[i]);
+			TEST_ASSERT(actual[expected.Keys()[i]] == expected.Values()[i]);
+		}
+
+		typedef Pair<TKey, TValue> TPair;
+		vint count = 0;
+		FOREACH(TPair, pair, actual)
+		{
+			TEST_ASSERT(expected[pair.key] == pair.value);
+			count++;
+		}
+		TEST_ASSERT(count == expected.Count());
+	}
+
+	// adds keys in the order they are added by the compiler and then finds each key
+	template<typename TDictionary, typename TKey>
+	vuint64_t AddAndFindKeys(const List<TKey>& keys, vint repeat)
+	{
+		auto start = DateTime::LocalTime();
+		for (vint i = 0; i < repeat; i++)
+		{
+			TDictionary dictionary;
+			for (vint j = 0; j < keys.Count(); j++)
+			{
+				dictionary.Add(keys[j], j);
+			}
+			for (vint j = 0; j < keys.Count(); j++)
+			{
+				TEST_ASSERT(dictionary.Keys().IndexOf(KeyType<TKey>::GetKeyValue(keys[j])) != -1);
+			}
+		}
+		auto stop = DateTime::LocalTime();
+		return stop.totalMilliseconds - start.totalMilliseconds;
+	}
+
+	template<typename TKey>
+	WString CompareDictionaries(const List<TKey>& keys, vint repeat)
+	{
+		auto sorted = AddAndFindKeys<Dictionary<TKey, vint>>(keys, repeat);
+		auto hashed = AddAndFindKeys<HashDictionary<TKey, vint>>(keys, repeat);
+		return itow(keys.Count()) + L" keys, " + itow(repeat) + L" times, Dictionary: " + u64tow(sorted) + L"ms, HashDictionary: " + u64tow(hashed) + L"ms";
+	}
+
+	void AssertCollidingKeys(const HashDictionary<CollidingKey, vint>& dictionary, const List<CollidingKey>& keys)
+	{
+		TEST_ASSERT(dictionary.Count() == keys.Count());
+		FOREACH(CollidingKey, key, keys)
+		{
+			TEST_ASSERT(dictionary.Keys().Contains(key));
+			TEST_ASSERT(dictionary[key] == key.value * 10);
+		}
+	}
+}
+
+TEST_CASE(TestHashDictionary_AddSetRemove)
+{
+	HashDictionary<vint, WString> dictionary;
+	TEST_ASSERT(dictionary.Count() == 0);
+	TEST_ASSERT(dictionary.Keys().IndexOf(0) == -1);
+	TEST_ASSERT(!dictionary.Remove(0));
+
+	TEST_ASSERT(dictionary.Add(1, L"one"));
+	TEST_ASSERT(dictionary.Add(Pair<vint, WString>(2, L"two")));
+	TEST_ASSERT(dictionary.Set(3, L"three"));
+	TEST_ASSERT(dictionary.Set(1, L"ONE"));
+	TEST_ASSERT(dictionary.Count() == 3);
+	TEST_ASSERT(dictionary[1] == L"ONE");
+	TEST_ASSERT(dictionary.Get(2) == L"two");
+	TEST_ASSERT(dictionary[3] == L"three");
+
+	// adding an existing key is an error
+	bool failed = false;
+	try
+	{
+		dictionary.Add(2, L"TWO");
+	}
+	catch (const Error&)
+	{
+		failed = true;
+	}
+	TEST_ASSERT(failed);
+	TEST_ASSERT(dictionary[2] == L"two");
+
+	// removing a key moves the last key to its position
+	TEST_ASSERT(dictionary.Remove(1));
+	TEST_ASSERT(!dictionary.Remove(1));
+	TEST_ASSERT(dictionary.Count() == 2);
+	TEST_ASSERT(dictionary.Keys()[0] == 3);
+	TEST_ASSERT(dictionary.Values()[0] == L"three");
+	TEST_ASSERT(dictionary.Keys().IndexOf(3) == 0);
+	TEST_ASSERT(dictionary.Keys().IndexOf(2) == 1);
+
+	TEST_ASSERT(dictionary.Clear());
+	TEST_ASSERT(dictionary.Count() == 0);
+	TEST_ASSERT(!dictionary.Keys().Contains(2));
+	TEST_ASSERT(dictionary.Add(2, L"two"));
+	TEST_ASSERT(dictionary[2] == L"two");
+}
+
+TEST_CASE(TestHashDictionary_RemoveWithWrapAround)
+{
+	// the first rehash creates 16 slots, keys are placed from the last two slots and wrap around to the beginning
+	HashDictionary<CollidingKey, vint> dictionary;
+	List<CollidingKey> keys;
+	keys.Add(CollidingKey(1, 14));
+	keys.Add(CollidingKey(2, 15));
+	keys.Add(CollidingKey(3, 14));
+	keys.Add(CollidingKey(4, 15));
+	keys.Add(CollidingKey(5, 0));
+	keys.Add(CollidingKey(6, 1));
+	keys.Add(CollidingKey(7, 14));
+	FOREACH(CollidingKey, key, keys)
+	{
+		dictionary.Add(key, key.value * 10);
+	}
+	AssertCollidingKeys(dictionary, keys);
+	TEST_ASSERT(!dictionary.Keys().Contains(CollidingKey(8, 14)));
+	TEST_ASSERT(!dictionary.Keys().Contains(CollidingKey(8, 2)));
+
+	// removing keys at the end of slots shifts keys that have wrapped around back to the end
+	vint order[] = { 1, 5, 2, 7, 3, 6, 4 };
+	for (auto value : order)
+	{
+		CollidingKey key(value, 0);
+		for (vint i = 0; i < keys.Count(); i++)
+		{
+			if (keys[i] == key)
+			{
+				key = keys[i];
+				keys.RemoveAt(i);
+				break;
+			}
+		}
+
+		TEST_ASSERT(dictionary.Remove(key));
+		TEST_ASSERT(!dictionary.Keys().Contains(key));
+		AssertCollidingKeys(dictionary, keys);
+
+		// a removed key could be added again without conflicting with keys that were shifted
+		dictionary.Add(key, key.value * 10);
+		keys.Add(key);
+		AssertCollidingKeys(dictionary, keys);
+		TEST_ASSERT(dictionary.Remove(key));
+		keys.RemoveAt(keys.Count() - 1);
+		AssertCollidingKeys(dictionary, keys);
+	}
+	TEST_ASSERT(dictionary.Count() == 0);
+}
+
+TEST_CASE(TestHashDictionary_Rehash)
+{
+	HashDictionary<vint, vint> dictionary;
+	Dictionary<vint, vint> expected;
+
+	// grows from 16 slots several times, every rehash keeps all keys
+	for (vint i = 0; i < 1000; i++)
+	{
+		dictionary.Add(i * 7, i);
+		expected.Add(i * 7, i);
+		if ((i & (i + 1)) == 0)
+		{
+			AssertSameDictionary(dictionary, expected);
+		}
+	}
+	AssertSameDictionary(dictionary, expected);
+
+	// random additions and removals compared with Dictionary
+	vuint seed = 0;
+	for (vint i = 0; i < 20000; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		vint key = (vint)((seed >> 8) % 2000);
+		if ((seed >> 4) % 3 == 0)
+		{
+			TEST_ASSERT(dictionary.Remove(key) == expected.Remove(key));
+		}
+		else
+		{
+			dictionary.Set(key, i);
+			expected.Set(key, i);
+		}
+		if (i % 1000 == 0)
+		{
+			AssertSameDictionary(dictionary, expected);
+		}
+	}
+	AssertSameDictionary(dictionary, expected);
+
+	// the same sequence with string keys
+	HashDictionary<WString, vint> stringDictionary;
+	Dictionary<WString, vint> stringExpected;
+	for (vint i = 0; i < 3000; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		WString key = L"key" + itow((vint)((seed >> 8) % 500));
+		if ((seed >> 4) % 3 == 0)
+		{
+			TEST_ASSERT(stringDictionary.Remove(key) == stringExpected.Remove(key));
+		}
+		else
+		{
+			stringDictionary.Set(key, i);
+			stringExpected.Set(key, i);
+		}
+	}
+	AssertSameDictionary(stringDictionary, stringExpected);
+}
+
+TEST_CASE(TestHashDictionary_HashGroup)
+{
+	HashGroup<WString, vint> group;
+	TEST_ASSERT(group.Count() == 0);
+	TEST_ASSERT(!group.Contains(L"a"));
+	TEST_ASSERT(!group.Remove(L"a"));
+	TEST_ASSERT(!group.Remove(L"a", 1));
+
+	group.Add(L"a", 1);
+	group.Add(L"a", 2);
+	group.Add(L"b", 3);
+	group.Add(Pair<WString, vint>(L"c", 4));
+	group.Add(L"a", 5);
+	TEST_ASSERT(group.Count() == 3);
+	TEST_ASSERT(group.Get(L"a").Count() == 3);
+	TEST_ASSERT(group[L"b"].Count() == 1);
+	TEST_ASSERT(group.Contains(L"a", 5));
+	TEST_ASSERT(!group.Contains(L"a", 3));
+
+	typedef Pair<WString, vint> TPair;
+	vint sum = 0, count = 0;
+	FOREACH(TPair, pair, group)
+	{
+		TEST_ASSERT(group.Contains(pair.key, pair.value));
+		sum += pair.value;
+		count++;
+	}
+	TEST_ASSERT(sum == 15);
+	TEST_ASSERT(count == 5);
+
+	// removing the last value of a key removes the key
+	TEST_ASSERT(group.Remove(L"a", 2));
+	TEST_ASSERT(group.Get(L"a").Count() == 2);
+	TEST_ASSERT(group.Remove(L"b", 3));
+	TEST_ASSERT(!group.Contains(L"b"));
+	TEST_ASSERT(group.Count() == 2);
+	TEST_ASSERT(group.Contains(L"c", 4));
+
+	// removing a key removes all values
+	TEST_ASSERT(group.Remove(L"a"));
+	TEST_ASSERT(!group.Contains(L"a"));
+	TEST_ASSERT(group.Count() == 1);
+	TEST_ASSERT(group.Keys()[0] == L"c");
+	TEST_ASSERT(group.GetByIndex(0)[0] == 4);
+
+	// many keys, removed in a different order than they are added
+	for (vint i = 0; i < 200; i++)
+	{
+		group.Add(itow(i % 50), i);
+	}
+	TEST_ASSERT(group.Count() == 51);
+	for (vint i = 49; i >= 0; i -= 2)
+	{
+		TEST_ASSERT(group.Remove(itow(i)));
+	}
+	TEST_ASSERT(group.Count() == 26);
+	for (vint i = 0; i < 50; i += 2)
+	{
+		TEST_ASSERT(group[itow(i)].Count() == 4);
+		TEST_ASSERT(group.Contains(itow(i), i + 150));
+	}
+
+	TEST_ASSERT(group.Clear());
+	TEST_ASSERT(group.Count() == 0);
+	TEST_ASSERT(!group.Contains(L"c"));
+}
+
+TEST_CASE(TestHashDictionary_DarkSkinCompileKeys)
+{
+	auto path = FilePath(GetTestResourcePath()) / L".." / L"GacUISrc" / L"Host" / L"Resources" / L"DarkSkin" / L"Resource.xml";
+	GuiResourceError::List errors;
+	auto resource = GuiResource::LoadFromXml(path.GetFullPath(), errors);
+	TEST_ASSERT(errors.Count() == 0);
+	resource->Precompile(nullptr, errors);
+	TEST_ASSERT(errors.Count() == 0);
+
+	// the compiler keeps metadata of the last assembly, keys in HashDictionary are listed in the order they are added
+	auto compiled = resource->GetValueByPath(L"Precompiled/Workflow/InstanceClass").Cast<GuiInstanceCompiledWorkflow>();
+	TEST_ASSERT(compiled && compiled->metadata);
+
+	List<ParsingTreeCustomBase*> nodeKeys;
+	CopyFrom(nodeKeys, compiled->metadata->nodeScopes.Keys());
+	List<Ptr<WfExpression>> expressionKeys;
+	CopyFrom(expressionKeys, compiled->metadata->expressionResolvings.Keys());
+	TEST_ASSERT(nodeKeys.Count() > 0);
+	TEST_ASSERT(expressionKeys.Count() > 0);
+
+	unittest::UnitTest::PrintInfo(L"NodeScopeMap in DarkSkin: " + CompareDictionaries(nodeKeys, 10));
+	unittest::UnitTest::PrintInfo(L"ExpressionResolvingMap in DarkSkin: " + CompareDictionaries(expressionKeys, 10));
+}
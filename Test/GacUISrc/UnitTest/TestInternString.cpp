@@ -0,0 +1,124 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::filesystem;
+using namespace vl::parsing;
+using namespace vl::parsing::xml;
+using namespace vl::presentation;
+
+extern WString GetTestResourcePath();
+
+namespace
+{
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+	volatile vint allocationCount = 0;
+
+	int CountAllocationHook(int allocType, void* userData, size_t size, int blockType, long requestNumber, const unsigned char* fileName, int lineNumber)
+	{
+		if (allocType == _HOOK_ALLOC && blockType != _CRT_BLOCK)
+		{
+			INCRC(&allocationCount);
+		}
+		return TRUE;
+	}
+#endif
+
+	WString ParseDarkSkin(const WString& input, vint repeat)
+	{
+		auto table = XmlLoadTable();
+		List<Ptr<ParsingError>> errors;
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+		allocationCount = 0;
+		auto oldHook = _CrtSetAllocHook(&CountAllocationHook);
+#endif
+		auto start = DateTime::LocalTime();
+		for (vint i = 0; i < repeat; i++)
+		{
+			TEST_ASSERT(XmlParseDocument(input, table, errors, 0));
+		}
+		auto stop = DateTime::LocalTime();
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+		_CrtSetAllocHook(oldHook);
+		WString allocations = itow(allocationCount / repeat) + L" allocations";
+#else
+		WString allocations = L"allocations are counted only when VCZH_CHECK_MEMORY_LEAKS is defined";
+#endif
+		TEST_ASSERT(errors.Count() == 0);
+		return allocations + L", " + u64tow((stop.totalMilliseconds - start.totalMilliseconds) / repeat) + L"ms";
+	}
+
+	WString PrecompileDarkSkin(const FilePath& path, bool intern)
+	{
+		SetInternStringEnabled(intern);
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+		allocationCount = 0;
+		stringCounterOperations = 0;
+		auto oldHook = _CrtSetAllocHook(&CountAllocationHook);
+#endif
+		auto start = DateTime::LocalTime();
+		{
+			GuiResourceError::List errors;
+			auto resource = GuiResource::LoadFromXml(path.GetFullPath(), errors);
+			TEST_ASSERT(errors.Count() == 0);
+			resource->Precompile(nullptr, errors);
+			TEST_ASSERT(errors.Count() == 0);
+		}
+		auto stop = DateTime::LocalTime();
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+		_CrtSetAllocHook(oldHook);
+		WString counters = itow(allocationCount) + L" allocations, " + itow(stringCounterOperations) + L" string reference counter operations";
+#else
+		WString counters = L"allocations and string reference counter operations are counted only when VCZH_CHECK_MEMORY_LEAKS is defined";
+#endif
+		SetInternStringEnabled(true);
+		return counters + L", " + u64tow(stop.totalMilliseconds - start.totalMilliseconds) + L"ms";
+	}
+}
+
+TEST_CASE(TestInternString_SharedBuffers)
+{
+	WString a = InternString(WString(L"Interned") + L"Name");
+	WString b = InternString(WString(L"Interned") + WString(L"Name"));
+	TEST_ASSERT(a == L"InternedName");
+	TEST_ASSERT(a.Buffer() == b.Buffer());
+	TEST_ASSERT(InternString(b).Buffer() == a.Buffer());
+
+	// copies of an interned string share the buffer
+	WString c = a;
+	List<WString> strings;
+	strings.Add(a);
+	TEST_ASSERT(c.Buffer() == a.Buffer());
+	TEST_ASSERT(strings[0].Buffer() == a.Buffer());
+
+	// strings that could not be zero-terminated literals are not interned
+	WString zero(L"a\0b", (vint)3);
+	TEST_ASSERT(InternString(zero) == zero);
+	TEST_ASSERT(InternString(WString::Empty) == L"");
+
+	AString d = InternString(AString("Interned") + "Name");
+	AString e = InternString(AString("Interned") + AString("Name"));
+	TEST_ASSERT(d == "InternedName");
+	TEST_ASSERT(d.Buffer() == e.Buffer());
+}
+
+TEST_CASE(TestInternString_DarkSkinAllocations)
+{
+	auto path = FilePath(GetTestResourcePath()) / L".." / L"GacUISrc" / L"Host" / L"Resources" / L"DarkSkin" / L"DarkSkin.xml";
+	WString input = File(path).ReadAllTextByBom();
+	TEST_ASSERT(input.Length() > 0);
+
+	// every token value in the parsed document is a string, which allocates its reference counter and characters in one block
+	unittest::UnitTest::PrintInfo(L"Parsing DarkSkin.xml: " + ParseDarkSkin(input, 10));
+}
+
+TEST_CASE(TestInternString_DarkSkinPrecompile)
+{
+	auto path = FilePath(GetTestResourcePath()) / L".." / L"GacUISrc" / L"Host" / L"Resources" / L"DarkSkin" / L"Resource.xml";
+
+	// reflection names are interned when type descriptors are loaded before this test case, they stay interned in both runs
+	// the first precompile initializes types and caches lazily, so it is not measured
+	PrecompileDarkSkin(path, true);
+	unittest::UnitTest::PrintInfo(L"Precompiling DarkSkin without interning: " + PrecompileDarkSkin(path, false));
+	unittest::UnitTest::PrintInfo(L"Precompiling DarkSkin with interning: " + PrecompileDarkSkin(path, true));
+}
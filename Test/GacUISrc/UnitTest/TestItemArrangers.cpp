@@ -0,0 +1,148 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+using namespace vl::presentation::controls::list;
+
+namespace
+{
+	class TestItemProvider : public ListProvider<vint>
+	{
+	public:
+		WString GetTextValue(vint itemIndex)override
+		{
+			return itow(Get(itemIndex));
+		}
+
+		description::Value GetBindingValue(vint itemIndex)override
+		{
+			return description::Value();
+		}
+
+		IDescriptable* RequestView(const WString& identifier)override
+		{
+			return nullptr;
+		}
+	};
+
+	class TestVariableHeightItemArranger : public VariableHeightItemArranger
+	{
+	public:
+		using VariableHeightItemArranger::UpdateItemHeight;
+		using VariableHeightItemArranger::UpdateEstimatedHeight;
+		using VariableHeightItemArranger::GetItemHeight;
+		using VariableHeightItemArranger::GetItemOffset;
+		using VariableHeightItemArranger::GetItemIndexFromOffset;
+	};
+
+	void AssertHeights(TestItemProvider& provider, TestVariableHeightItemArranger& arranger, List<vint>& heights)
+	{
+		TEST_ASSERT(provider.Count() == heights.Count());
+		vint offset = 0;
+		for (vint i = 0; i < heights.Count(); i++)
+		{
+			vint height = heights[i] == -1 ? arranger.GetItemHeight(i) : heights[i];
+			TEST_ASSERT(arranger.GetItemHeight(i) == height);
+			TEST_ASSERT(arranger.GetItemOffset(i) == offset);
+			if (height > 0)
+			{
+				TEST_ASSERT(arranger.GetItemIndexFromOffset(offset) == i);
+				TEST_ASSERT(arranger.GetItemIndexFromOffset(offset + height - 1) == i);
+			}
+			offset += height;
+		}
+		TEST_ASSERT(arranger.GetItemOffset(heights.Count()) == offset);
+	}
+}
+
+TEST_CASE(TestItemArrangers_VariableHeight_Offsets)
+{
+	TestItemProvider provider;
+	TestVariableHeightItemArranger arranger;
+	for (vint i = 0; i < 20; i++)
+	{
+		provider.Add(i);
+	}
+	provider.AttachCallback(&arranger);
+
+	List<vint> heights;
+	for (vint i = 0; i < 20; i++)
+	{
+		heights.Add(-1);
+	}
+	AssertHeights(provider, arranger, heights);
+	TEST_ASSERT(arranger.GetItemHeight(0) == 1);
+
+	for (vint i = 0; i < 20; i += 3)
+	{
+		arranger.UpdateItemHeight(i, i * 2);
+		heights[i] = i * 2;
+	}
+	AssertHeights(provider, arranger, heights);
+
+	TEST_ASSERT(arranger.UpdateEstimatedHeight());
+	TEST_ASSERT(arranger.GetItemHeight(1) == 18);
+	AssertHeights(provider, arranger, heights);
+
+	provider.Insert(5, 100);
+	provider.Insert(5, 101);
+	heights.Insert(5, -1);
+	heights.Insert(5, -1);
+	AssertHeights(provider, arranger, heights);
+
+	provider.RemoveRange(0, 4);
+	heights.RemoveRange(0, 4);
+	AssertHeights(provider, arranger, heights);
+
+	provider.Set(2, 102);
+	heights[2] = -1;
+	AssertHeights(provider, arranger, heights);
+
+	provider.Clear();
+	heights.Clear();
+	AssertHeights(provider, arranger, heights);
+	TEST_ASSERT(arranger.GetItemIndexFromOffset(100) == 0);
+
+	provider.DetachCallback(&arranger);
+}
+
+TEST_CASE(TestItemArrangers_VariableHeight_MillionItems)
+{
+	const vint count = 1000000;
+	TestItemProvider provider;
+	TestVariableHeightItemArranger arranger;
+	for (vint i = 0; i < count; i++)
+	{
+		provider.Add(i);
+	}
+	provider.AttachCallback(&arranger);
+
+	for (vint i = 0; i < count; i++)
+	{
+		arranger.UpdateItemHeight(i, 10 + i % 7);
+	}
+
+	vint offset = 0;
+	for (vint i = 0; i < count; i += 997)
+	{
+		TEST_ASSERT(arranger.GetItemOffset(i) == offset);
+		TEST_ASSERT(arranger.GetItemIndexFromOffset(offset) == i);
+		for (vint j = i; j < i + 997 && j < count; j++)
+		{
+			offset += 10 + j % 7;
+		}
+	}
+	TEST_ASSERT(arranger.GetItemIndexFromOffset(arranger.GetItemOffset(count)) == count - 1);
+
+	offset = arranger.GetItemOffset(count / 2 + 1);
+	provider.Insert(count / 2, -1);
+	TEST_ASSERT(arranger.GetItemHeight(count / 2) == 1);
+	TEST_ASSERT(arranger.GetItemHeight(count / 2 + 1) == 10 + (count / 2) % 7);
+	TEST_ASSERT(arranger.GetItemOffset(count / 2 + 2) == offset + 1);
+	provider.RemoveRange(count / 2, 1);
+	TEST_ASSERT(arranger.GetItemHeight(count / 2) == 10 + (count / 2) % 7);
+
+	provider.DetachCallback(&arranger);
+}
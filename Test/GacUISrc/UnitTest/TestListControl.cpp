@@ -0,0 +1,210 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Reflection/TypeDescriptors/GuiReflectionPlugin.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+using namespace vl::presentation::controls::list;
+using namespace vl::presentation::templates;
+
+namespace
+{
+	class TestItemProvider : public ListProvider<vint>
+	{
+	public:
+		WString GetTextValue(vint itemIndex)override
+		{
+			return L"Item " + itow(Get(itemIndex));
+		}
+
+		Value GetBindingValue(vint itemIndex)override
+		{
+			return BoxValue(Get(itemIndex));
+		}
+
+		IDescriptable* RequestView(const WString& identifier)override
+		{
+			return nullptr;
+		}
+	};
+
+	class TestOnRefreshItemTemplate : public GuiListItemTemplate
+	{
+	protected:
+		void OnInitialize()override
+		{
+			SetPreferredMinSize(Size(100, 20));
+			OnRefresh();
+		}
+
+		void OnRefresh()override
+		{
+			content = listControl->GetItemProvider()->GetTextValue(GetIndex());
+		}
+
+	public:
+		WString							content;
+	};
+
+	// an item template that only uses property changed events, like item templates in XML or Workflow
+	class TestEventItemTemplate : public GuiListItemTemplate
+	{
+	public:
+		WString							content;
+
+		TestEventItemTemplate()
+		{
+			SetPreferredMinSize(Size(100, 20));
+			content = GetText();
+			TextChanged.AttachLambda([=](compositions::GuiGraphicsComposition*, compositions::GuiEventArgs&)
+			{
+				content = GetText();
+			});
+		}
+	};
+
+	GuiScroll* CreateTestScroll(theme::ThemeName themeName)
+	{
+		auto scroll = new GuiScroll(themeName);
+		scroll->SetControlTemplate([](const Value&)
+		{
+			return new GuiScrollTemplate;
+		});
+		return scroll;
+	}
+
+	GuiListControl* CreateTestListControl(vint itemCount)
+	{
+		auto provider = new TestItemProvider;
+		for (vint i = 0; i < itemCount; i++)
+		{
+			provider->Add(i);
+		}
+
+		auto listControl = new GuiListControl(theme::ThemeName::CustomControl, provider, false);
+		listControl->SetControlTemplate([](const Value&)
+		{
+			auto ct = new GuiListControlTemplate;
+			auto hScroll = CreateTestScroll(theme::ThemeName::HScroll);
+			auto vScroll = CreateTestScroll(theme::ThemeName::VScroll);
+			ct->AddChild(hScroll->GetBoundsComposition());
+			ct->AddChild(vScroll->GetBoundsComposition());
+			ct->SetHorizontalScroll(hScroll);
+			ct->SetVerticalScroll(vScroll);
+			return ct;
+		});
+		listControl->SetDisplayItemBackground(false);
+		listControl->GetBoundsComposition()->SetBounds(Rect(0, 0, 200, 200));
+		return listControl;
+	}
+
+	template<typename TItemTemplate>
+	vint AssertVisibleItems(GuiListControl* listControl)
+	{
+		vint visibleCount = 0;
+		auto arranger = listControl->GetArranger();
+		for (vint i = 0; i < listControl->GetItemProvider()->Count(); i++)
+		{
+			if (auto style = arranger->GetVisibleStyle(i))
+			{
+				auto itemTemplate = dynamic_cast<TItemTemplate*>(style);
+				TEST_ASSERT(itemTemplate);
+				TEST_ASSERT(itemTemplate->GetIndex() == i);
+				TEST_ASSERT(itemTemplate->GetText() == L"Item " + itow(i));
+				TEST_ASSERT(itemTemplate->content == L"Item " + itow(i));
+				visibleCount++;
+			}
+		}
+		return visibleCount;
+	}
+
+	template<typename TItemTemplate>
+	void ScrollList(bool recyclable, vint recycleLimit)
+	{
+		auto listControl = CreateTestListControl(1000);
+		listControl->SetItemTemplateRecycleLimit(recycleLimit);
+		listControl->SetItemTemplate([=](const Value&)
+		{
+			auto itemTemplate = new TItemTemplate;
+			itemTemplate->SetRecyclable(recyclable);
+			return itemTemplate;
+		});
+		listControl->SetArranger(new FixedHeightItemArranger);
+		listControl->CalculateView();
+
+		vint visibleCount = AssertVisibleItems<TItemTemplate>(listControl);
+		TEST_ASSERT(visibleCount > 0);
+		TEST_ASSERT(listControl->GetItemTemplateRecycleHitCount() == 0);
+		vint missCount = listControl->GetItemTemplateRecycleMissCount();
+
+		// scroll by half of a page, and then by more than a page
+		auto vScroll = listControl->GetVerticalScroll();
+		for (vint i = 1; i <= 10; i++)
+		{
+			vScroll->SetPosition(i * 100);
+			TEST_ASSERT(AssertVisibleItems<TItemTemplate>(listControl) > 0);
+		}
+		for (vint i = 1; i <= 10; i++)
+		{
+			vScroll->SetPosition(1000 + i * 500);
+			TEST_ASSERT(AssertVisibleItems<TItemTemplate>(listControl) > 0);
+		}
+
+		vint hitCount = listControl->GetItemTemplateRecycleHitCount();
+		vint newMissCount = listControl->GetItemTemplateRecycleMissCount();
+		if (recyclable && recycleLimit > 0)
+		{
+			TEST_ASSERT(hitCount > 0);
+			// only a few templates are created when the view is larger than before
+			TEST_ASSERT(newMissCount - missCount < hitCount);
+		}
+		else
+		{
+			TEST_ASSERT(hitCount == 0);
+			TEST_ASSERT(newMissCount > missCount);
+		}
+
+		SafeDeleteControl(listControl);
+	}
+}
+
+TEST_CASE(TestListControl_RecycleItemTemplates_OnRefresh)
+{
+	ScrollList<TestOnRefreshItemTemplate>(true, 32);
+}
+
+TEST_CASE(TestListControl_RecycleItemTemplates_PropertyChanged)
+{
+	ScrollList<TestEventItemTemplate>(true, 32);
+}
+
+TEST_CASE(TestListControl_RecycleItemTemplates_Disabled)
+{
+	ScrollList<TestOnRefreshItemTemplate>(false, 32);
+	ScrollList<TestOnRefreshItemTemplate>(true, 0);
+}
+
+TEST_CASE(TestListControl_RecycleItemTemplates_Reflection)
+{
+	auto itemTemplateType = GetTypeDescriptor<GuiListItemTemplate>();
+	auto recyclable = itemTemplateType->GetPropertyByName(L"Recyclable", true);
+	TEST_ASSERT(recyclable && recyclable->IsReadable() && recyclable->IsWritable());
+	TEST_ASSERT(recyclable->GetValueChangedEvent());
+
+	auto listControlType = GetTypeDescriptor<GuiListControl>();
+	auto recycleLimit = listControlType->GetPropertyByName(L"ItemTemplateRecycleLimit", true);
+	TEST_ASSERT(recycleLimit && recycleLimit->IsReadable() && recycleLimit->IsWritable());
+	auto hitCount = listControlType->GetPropertyByName(L"ItemTemplateRecycleHitCount", true);
+	TEST_ASSERT(hitCount && hitCount->IsReadable() && !hitCount->IsWritable());
+	auto missCount = listControlType->GetPropertyByName(L"ItemTemplateRecycleMissCount", true);
+	TEST_ASSERT(missCount && missCount->IsReadable() && !missCount->IsWritable());
+
+	auto itemTemplate = new TestOnRefreshItemTemplate;
+	Value value = BoxValue<GuiListItemTemplate*>(itemTemplate);
+	TEST_ASSERT(UnboxValue<bool>(value.GetProperty(L"Recyclable")) == false);
+	value.SetProperty(L"Recyclable", BoxValue(true));
+	TEST_ASSERT(itemTemplate->GetRecyclable());
+	delete itemTemplate;
+}
@@ -0,0 +1,209 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::filesystem;
+using namespace vl::parsing;
+using namespace vl::presentation;
+
+extern WString GetTestResourcePath();
+
+namespace
+{
+	const vint TokenCount = 10000;
+
+	// arenas are disabled by default, they are only enabled in test cases that need them
+	class ParsingArenaEnabled : public Object
+	{
+	public:
+		ParsingArenaEnabled(bool enabled = true)
+		{
+			ParsingArena::SetEnabled(enabled);
+		}
+
+		~ParsingArenaEnabled()
+		{
+			ParsingArena::SetEnabled(false);
+		}
+	};
+
+	void CreateTokens(List<Ptr<ParsingTreeToken>>& tokens)
+	{
+		for (vint i = 0; i < TokenCount; i++)
+		{
+			tokens.Add(new ParsingTreeToken(L"token" + itow(i), i));
+		}
+	}
+
+	void AssertTokens(List<Ptr<ParsingTreeToken>>& tokens)
+	{
+		TEST_ASSERT(tokens.Count() == TokenCount);
+		for (vint i = 0; i < TokenCount; i++)
+		{
+			TEST_ASSERT(tokens[i]->GetValue() == L"token" + itow(i));
+			TEST_ASSERT(tokens[i]->GetTokenIndex() == i);
+		}
+	}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+	volatile vint allocationCount = 0;
+
+	int CountAllocationHook(int allocType, void* userData, size_t size, int blockType, long requestNumber, const unsigned char* fileName, int lineNumber)
+	{
+		if (allocType == _HOOK_ALLOC && blockType != _CRT_BLOCK)
+		{
+			INCRC(&allocationCount);
+		}
+		return TRUE;
+	}
+#endif
+
+	WString PrecompileDarkSkin(const FilePath& path, bool arena)
+	{
+		ParsingArenaEnabled enabled(arena);
+		vint liveBlocks = ParsingArena::GetLiveBlockCount();
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+		allocationCount = 0;
+		auto oldHook = _CrtSetAllocHook(&CountAllocationHook);
+#endif
+		auto start = DateTime::LocalTime();
+		Ptr<GuiResource> resource;
+		Ptr<GuiResourceFolder> precompiled;
+		{
+			GuiResourceError::List errors;
+			resource = GuiResource::LoadFromXml(path.GetFullPath(), errors);
+			TEST_ASSERT(errors.Count() == 0);
+			precompiled = resource->Precompile(nullptr, errors);
+			TEST_ASSERT(errors.Count() == 0);
+		}
+		auto stop = DateTime::LocalTime();
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+		_CrtSetAllocHook(oldHook);
+		WString allocations = itow(allocationCount) + L" allocations";
+#else
+		WString allocations = L"allocations are counted only when VCZH_CHECK_MEMORY_LEAKS is defined";
+#endif
+
+		// syntax trees kept by the resource, the precompiled result and the shared Workflow compiler keep their blocks
+		vint keptBlocks = ParsingArena::GetLiveBlockCount() - liveBlocks;
+		return allocations + L", " + itow(keptBlocks) + L" blocks kept after precompiling, " + u64tow(stop.totalMilliseconds - start.totalMilliseconds) + L"ms";
+	}
+}
+
+TEST_CASE(TestParsingArena_Disabled)
+{
+	vint liveBlocks = ParsingArena::GetLiveBlockCount();
+	TEST_ASSERT(!ParsingArena::IsEnabled());
+
+	ParsingArena arena;
+	List<Ptr<ParsingTreeToken>> tokens;
+	{
+		ParsingArena::Scope scope(arena);
+		CreateTokens(tokens);
+	}
+	TEST_ASSERT(arena.GetAllocatedBlockCount() == 0);
+	TEST_ASSERT(ParsingArena::GetLiveBlockCount() == liveBlocks);
+	AssertTokens(tokens);
+}
+
+TEST_CASE(TestParsingArena_NodesOutliveArena)
+{
+	ParsingArenaEnabled enabled;
+	vint liveBlocks = ParsingArena::GetLiveBlockCount();
+
+	List<Ptr<ParsingTreeToken>> tokens;
+	vint allocatedBlocks = 0;
+	{
+		ParsingArena arena;
+		ParsingArena::Scope scope(arena);
+		CreateTokens(tokens);
+		allocatedBlocks = arena.GetAllocatedBlockCount();
+		TEST_ASSERT(allocatedBlocks > 1);
+	}
+
+	// blocks are kept by nodes after the arena is destroyed
+	TEST_ASSERT(ParsingArena::GetLiveBlockCount() == liveBlocks + allocatedBlocks);
+	AssertTokens(tokens);
+
+	// one node keeps the whole block that it belongs to
+	auto first = tokens[0];
+	tokens.Clear();
+	TEST_ASSERT(ParsingArena::GetLiveBlockCount() == liveBlocks + 1);
+	TEST_ASSERT(first->GetValue() == L"token0");
+	first = nullptr;
+	TEST_ASSERT(ParsingArena::GetLiveBlockCount() == liveBlocks);
+}
+
+TEST_CASE(TestParsingArena_FreeInAnotherThread)
+{
+	ParsingArenaEnabled enabled;
+	vint liveBlocks = ParsingArena::GetLiveBlockCount();
+
+	// nodes are created in a thread with its own arena
+	List<Ptr<ParsingTreeToken>> tokens;
+	auto creator = Thread::CreateAndStart([&]()
+	{
+		ParsingArena arena;
+		ParsingArena::Scope scope(arena);
+		CreateTokens(tokens);
+		TEST_ASSERT(arena.GetAllocatedBlockCount() > 1);
+	}, false);
+	creator->Wait();
+	delete creator;
+	AssertTokens(tokens);
+
+	// nodes in the same blocks are released in two threads at the same time
+	auto releaser = Thread::CreateAndStart([&]()
+	{
+		for (vint i = 0; i < TokenCount; i += 2)
+		{
+			tokens.Set(i, nullptr);
+		}
+	}, false);
+	for (vint i = 1; i < TokenCount; i += 2)
+	{
+		tokens.Set(i, nullptr);
+	}
+	releaser->Wait();
+	delete releaser;
+	TEST_ASSERT(ParsingArena::GetLiveBlockCount() == liveBlocks);
+}
+
+TEST_CASE(TestParsingArena_OversizeFallback)
+{
+	ParsingArenaEnabled enabled;
+	vint liveBlocks = ParsingArena::GetLiveBlockCount();
+	{
+		ParsingArena arena(1024);
+		ParsingArena::Scope scope(arena);
+
+		void* small = ParsingArena::AllocateNode(64);
+		TEST_ASSERT(arena.GetAllocatedBlockCount() == 1);
+
+		// nodes larger than a quarter of a block are allocated from the heap
+		void* large = ParsingArena::AllocateNode(1024);
+		memset(large, 0, 1024);
+		TEST_ASSERT(arena.GetAllocatedBlockCount() == 1);
+		ParsingArena::FreeNode(large);
+
+		// the block is still kept by the arena after the last node in it is released
+		ParsingArena::FreeNode(small);
+		TEST_ASSERT(ParsingArena::GetLiveBlockCount() == liveBlocks + 1);
+	}
+	TEST_ASSERT(ParsingArena::GetLiveBlockCount() == liveBlocks);
+
+	// nodes are allocated from the heap when there is no arena in the current thread
+	void* node = ParsingArena::AllocateNode(64);
+	TEST_ASSERT(ParsingArena::GetLiveBlockCount() == liveBlocks);
+	ParsingArena::FreeNode(node);
+}
+
+TEST_CASE(TestParsingArena_DarkSkinPrecompile)
+{
+	auto path = FilePath(GetTestResourcePath()) / L".." / L"GacUISrc" / L"Host" / L"Resources" / L"DarkSkin" / L"Resource.xml";
+
+	// the first precompile initializes types and caches lazily, so it is not measured
+	PrecompileDarkSkin(path, false);
+	unittest::UnitTest::PrintInfo(L"Precompiling DarkSkin without arenas: " + PrecompileDarkSkin(path, false));
+	unittest::UnitTest::PrintInfo(L"Precompiling DarkSkin with arenas: " + PrecompileDarkSkin(path, true));
+}
@@ -0,0 +1,46 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Compiler/GuiInstanceLoader.h"
+#include "../../../Source/Resources/GuiParserManager.h"
+
+using namespace vl;
+using namespace vl::parsing;
+using namespace vl::parsing::tabling;
+using namespace vl::presentation;
+
+namespace
+{
+	WString LoadTable(Ptr<ParsingTable>(*loadTable)(), vint repeat)
+	{
+		auto start = DateTime::LocalTime();
+		for (vint i = 0; i < repeat; i++)
+		{
+			TEST_ASSERT(loadTable());
+		}
+		auto stop = DateTime::LocalTime();
+		return u64tow((stop.totalMilliseconds - start.totalMilliseconds) / repeat) + L"ms";
+	}
+}
+
+TEST_CASE(TestParsingTables_Load)
+{
+	// every call decompresses, deserializes and initializes a new table
+	unittest::UnitTest::PrintInfo(L"Loading the Xml table: " + LoadTable(&xml::XmlLoadTable, 10));
+	unittest::UnitTest::PrintInfo(L"Loading the Json table: " + LoadTable(&json::JsonLoadTable, 10));
+	unittest::UnitTest::PrintInfo(L"Loading the Workflow table: " + LoadTable(&workflow::WfLoadTable, 10));
+}
+
+TEST_CASE(TestParsingTables_SharedByParserManager)
+{
+	// tables are loaded on the first call to GetParsingTable, applications that only load precompiled resources never load them
+	auto manager = GetParserManager();
+	auto table = manager->GetParsingTable(L"WORKFLOW");
+	TEST_ASSERT(table);
+
+	auto start = DateTime::LocalTime();
+	for (vint i = 0; i < 10000; i++)
+	{
+		TEST_ASSERT(manager->GetParsingTable(L"WORKFLOW") == table);
+	}
+	auto stop = DateTime::LocalTime();
+	unittest::UnitTest::PrintInfo(L"Getting the loaded Workflow table 10000 times: " + u64tow(stop.totalMilliseconds - start.totalMilliseconds) + L"ms");
+}
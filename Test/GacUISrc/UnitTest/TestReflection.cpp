@@ -0,0 +1,177 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Compiler/GuiInstanceLoader.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::presentation;
+
+namespace
+{
+	IGuiInstanceLoader* GetLoader(const WString& typeName)
+	{
+		auto loader = GetInstanceLoaderManager()->GetLoader(GlobalStringKey::Get(typeName));
+		TEST_ASSERT(loader);
+		return loader;
+	}
+
+	bool IsTypeLoaded(ITypeDescriptor* td)
+	{
+		auto tdImpl = dynamic_cast<TypeDescriptorImpl*>(td);
+		return !tdImpl || tdImpl->IsLoaded();
+	}
+
+	vint CountUnloadedTypes()
+	{
+		auto manager = GetGlobalTypeManager();
+		vint count = 0;
+		for (vint i = 0; i < manager->GetTypeDescriptorCount(); i++)
+		{
+			if (!IsTypeLoaded(manager->GetTypeDescriptor(i)))
+			{
+				count++;
+			}
+		}
+		return count;
+	}
+
+	// controls that are not used in any other test case or test resource
+	const wchar_t* LazyControlTypeNames[] =
+	{
+		L"presentation::controls::GuiDatePicker",
+		L"presentation::controls::GuiDateComboBox",
+		L"presentation::controls::GuiScrollContainer",
+		L"presentation::controls::GuiDocumentLabel",
+	};
+}
+
+TEST_CASE(TestReflection_InstanceLoader_ParentLoaders)
+{
+	auto manager = GetInstanceLoaderManager();
+	auto control = GetLoader(L"presentation::controls::GuiControl");
+	auto button = GetLoader(L"presentation::controls::GuiButton");
+	auto toolstripButton = GetLoader(L"presentation::controls::GuiToolstripButton");
+
+	TEST_ASSERT(manager->GetParentLoader(button) == control);
+	TEST_ASSERT(manager->GetParentLoader(GetLoader(L"presentation::controls::GuiCheckBox")) == button);
+	TEST_ASSERT(manager->GetParentLoader(GetLoader(L"presentation::controls::GuiMenuBarButton")) == toolstripButton);
+	TEST_ASSERT(manager->GetParentLoader(GetLoader(L"presentation::controls::GuiGroupBox")) == control);
+	TEST_ASSERT(GetLoader(L"presentation::controls::GuiSelectableButton") == button);
+}
+
+TEST_CASE(TestReflection_InstanceLoader_LazyParentLoaders)
+{
+	auto typeManager = GetGlobalTypeManager();
+	auto manager = GetInstanceLoaderManager();
+
+	// after loading plugins, registering loaders does not load members of control types
+	for (auto typeName : LazyControlTypeNames)
+	{
+		auto td = typeManager->GetTypeDescriptor(typeName);
+		TEST_ASSERT(td);
+		TEST_ASSERT(!IsTypeLoaded(td));
+	}
+
+	// find loaders for all types, a type that has its own loader is not loaded
+	SortedList<IGuiInstanceLoader*> loaders;
+	for (vint i = 0; i < typeManager->GetTypeDescriptorCount(); i++)
+	{
+		auto typeName = typeManager->GetTypeDescriptor(i)->GetTypeName();
+		auto loader = manager->GetLoader(GlobalStringKey::Get(typeName));
+		if (loader && loader->GetTypeName().ToString() == typeName && !loaders.Contains(loader))
+		{
+			loaders.Add(loader);
+		}
+	}
+	{
+		List<GlobalStringKey> virtualTypes;
+		manager->GetVirtualTypes(virtualTypes);
+		FOREACH(GlobalStringKey, typeName, virtualTypes)
+		{
+			auto loader = manager->GetLoader(typeName);
+			if (!loaders.Contains(loader))
+			{
+				loaders.Add(loader);
+			}
+		}
+	}
+	for (auto typeName : LazyControlTypeNames)
+	{
+		TEST_ASSERT(loaders.Contains(GetLoader(typeName)));
+		TEST_ASSERT(!IsTypeLoaded(typeManager->GetTypeDescriptor(typeName)));
+	}
+
+	// walking parent loaders for all loaders is what loading plugins paid when parent loaders were filled eagerly
+	vint unloadedBeforeWalk = CountUnloadedTypes();
+	auto eagerStart = DateTime::LocalTime();
+	FOREACH(IGuiInstanceLoader*, loader, loaders)
+	{
+		TEST_ASSERT(manager->GetParentLoader(loader));
+	}
+	auto eagerStop = DateTime::LocalTime();
+	vint unloadedAfterWalk = CountUnloadedTypes();
+
+	// parent loaders are cached after the first query
+	auto cachedStart = DateTime::LocalTime();
+	FOREACH(IGuiInstanceLoader*, loader, loaders)
+	{
+		TEST_ASSERT(manager->GetParentLoader(loader));
+	}
+	auto cachedStop = DateTime::LocalTime();
+	TEST_ASSERT(CountUnloadedTypes() == unloadedAfterWalk);
+
+	for (auto typeName : LazyControlTypeNames)
+	{
+		TEST_ASSERT(IsTypeLoaded(typeManager->GetTypeDescriptor(typeName)));
+	}
+	TEST_ASSERT(unloadedAfterWalk < unloadedBeforeWalk);
+
+	unittest::UnitTest::PrintInfo(
+		L"Instance loaders: " + itow(loaders.Count()) +
+		L", type descriptors: " + itow(typeManager->GetTypeDescriptorCount()) +
+		L", unloaded before walking parent loaders: " + itow(unloadedBeforeWalk) +
+		L", unloaded after: " + itow(unloadedAfterWalk) +
+		L", eager walk: " + u64tow(eagerStop.totalMilliseconds - eagerStart.totalMilliseconds) + L"ms" +
+		L", cached walk: " + u64tow(cachedStop.totalMilliseconds - cachedStart.totalMilliseconds) + L"ms"
+		);
+}
+
+TEST_CASE(TestReflection_TypeDescriptors_LoadMembers)
+{
+	auto manager = GetGlobalTypeManager();
+	vint count = manager->GetTypeDescriptorCount();
+	TEST_ASSERT(count > 0);
+
+	// lazy: only type names are resolved, which is what application startup pays for every registered type
+	auto lazyStart = DateTime::LocalTime();
+	for (vint i = 0; i < count; i++)
+	{
+		auto td = manager->GetTypeDescriptor(i);
+		TEST_ASSERT(manager->GetTypeDescriptor(td->GetTypeName()) == td);
+	}
+	auto lazyStop = DateTime::LocalTime();
+
+	// eager: members of all types are materialized, types that have been queried before are not counted again
+	vint members = 0;
+	auto eagerStart = DateTime::LocalTime();
+	for (vint i = 0; i < count; i++)
+	{
+		auto td = manager->GetTypeDescriptor(i);
+		members += td->GetBaseTypeDescriptorCount();
+		members += td->GetPropertyCount();
+		members += td->GetEventCount();
+		members += td->GetMethodGroupCount();
+		if (auto ctors = td->GetConstructorGroup())
+		{
+			members += ctors->GetMethodCount();
+		}
+	}
+	auto eagerStop = DateTime::LocalTime();
+	TEST_ASSERT(members > 0);
+
+	unittest::UnitTest::PrintInfo(
+		L"Type descriptors: " + itow(count) +
+		L", lazy: " + u64tow(lazyStop.totalMilliseconds - lazyStart.totalMilliseconds) + L"ms" +
+		L", eager: " + u64tow(eagerStop.totalMilliseconds - eagerStart.totalMilliseconds) + L"ms for " + itow(members) + L" members"
+		);
+}
@@ -157,4 +157,141 @@ TEST_CASE(Resource_FailedScript_Strings)
 TEST_CASE(Resource_FailedScript_Strings2)
 {
 	LoadResource(L"Resource.FailedScript.Strings2.xml", true);
-}
\ No newline at end of file
+}
+
+TEST_CASE(TestResource_ParallelPrecompile)
+{
+	// precompiling with multiple workers produces the same errors in the same order and the same binary as one worker
+	auto precompile = [](const FilePath& inputPath, vint workerCount, GuiResourceError::List& errors, MemoryStream& stream)
+	{
+		auto resource = GuiResource::LoadFromXml(inputPath.GetFullPath(), errors);
+		if (errors.Count() > 0) return;
+		resource->Precompile(nullptr, errors, workerCount);
+		if (errors.Count() > 0) return;
+		resource->SavePrecompiledBinary(stream);
+	};
+
+	List<File> files;
+	TEST_ASSERT(Folder(GetTestResourcePath()).GetFiles(files));
+	FOREACH(File, file, files)
+	{
+		auto inputPath = file.GetFilePath();
+		if (!INVLOC.EndsWith(inputPath.GetName(), L".xml", Locale::Normalization::IgnoreCase)) continue;
+
+		GuiResourceError::List serialErrors;
+		MemoryStream serialStream;
+		precompile(inputPath, 1, serialErrors, serialStream);
+
+		GuiResourceError::List parallelErrors;
+		MemoryStream parallelStream;
+		precompile(inputPath, 4, parallelErrors, parallelStream);
+
+		unittest::UnitTest::PrintInfo(inputPath.GetName() + L": " + itow(serialErrors.Count()) + L" errors");
+		TEST_ASSERT(serialErrors.Count() == parallelErrors.Count());
+		for (vint i = 0; i < serialErrors.Count(); i++)
+		{
+			TEST_ASSERT(serialErrors[i] == parallelErrors[i]);
+		}
+		TEST_ASSERT(serialStream.Size() == parallelStream.Size());
+		if (serialStream.Size() > 0)
+		{
+			TEST_ASSERT(memcmp(serialStream.GetInternalBuffer(), parallelStream.GetInternalBuffer(), (size_t)serialStream.Size()) == 0);
+		}
+	}
+}
+
+TEST_CASE(TestResource_ParallelPrecompileDarkSkin)
+{
+	// instance passes generate modules from each item in parallel, the compiling passes always run in one thread
+	auto inputPath = FilePath(GetTestResourcePath()) / L".." / L"GacUISrc" / L"Host" / L"Resources" / L"DarkSkin" / L"Resource.xml";
+	auto precompile = [&](vint workerCount)
+	{
+		GuiResourceError::List errors;
+		auto resource = GuiResource::LoadFromXml(inputPath.GetFullPath(), errors);
+		TEST_ASSERT(errors.Count() == 0);
+
+		auto start = DateTime::LocalTime();
+		resource->Precompile(nullptr, errors, workerCount);
+		auto stop = DateTime::LocalTime();
+		TEST_ASSERT(errors.Count() == 0);
+		return u64tow(stop.totalMilliseconds - start.totalMilliseconds) + L"ms";
+	};
+
+	// the first precompile initializes types and caches lazily, so it is not measured
+	precompile(1);
+	unittest::UnitTest::PrintInfo(L"Precompiling DarkSkin with 1 worker: " + precompile(1));
+	unittest::UnitTest::PrintInfo(L"Precompiling DarkSkin with 4 workers: " + precompile(4));
+}
+
+namespace
+{
+	class PassTimingCallback : public Object, public IGuiResourcePrecompileCallback
+	{
+	public:
+		vint									passIndex = -1;
+		bool									perResource = false;
+		vuint64_t								lastTime = 0;
+		Array<vuint64_t>						perResourceTimes;
+		Array<vuint64_t>						perPassTimes;
+
+		PassTimingCallback()
+			:perResourceTimes(IGuiResourceTypeResolver_Precompile::Instance_Max + 1)
+			, perPassTimes(IGuiResourceTypeResolver_Precompile::Instance_Max + 1)
+		{
+			for (vint i = 0; i < perResourceTimes.Count(); i++)
+			{
+				perResourceTimes[i] = 0;
+				perPassTimes[i] = 0;
+			}
+			lastTime = DateTime::LocalTime().totalMilliseconds;
+		}
+
+		void Record()
+		{
+			auto time = DateTime::LocalTime().totalMilliseconds;
+			if (passIndex != -1)
+			{
+				(perResource ? perResourceTimes : perPassTimes)[passIndex] += time - lastTime;
+			}
+			lastTime = time;
+		}
+
+		workflow::IWfCompilerCallback* GetCompilerCallback()override
+		{
+			return nullptr;
+		}
+
+		void OnPerPass(vint _passIndex)override
+		{
+			Record();
+			passIndex = _passIndex;
+			perResource = false;
+		}
+
+		void OnPerResource(vint _passIndex, Ptr<GuiResourceItem> resource)override
+		{
+			Record();
+			passIndex = _passIndex;
+			perResource = true;
+		}
+	};
+}
+
+TEST_CASE(TestResource_PrecompilePasses)
+{
+	// per-resource passes generate modules from each item, per-pass passes compile all modules of a pass into one assembly
+	auto inputPath = FilePath(GetTestResourcePath()) / L".." / L"GacUISrc" / L"Host" / L"Resources" / L"DarkSkin" / L"Resource.xml";
+	GuiResourceError::List errors;
+	auto resource = GuiResource::LoadFromXml(inputPath.GetFullPath(), errors);
+	TEST_ASSERT(errors.Count() == 0);
+
+	PassTimingCallback callback;
+	resource->Precompile(&callback, errors);
+	callback.Record();
+	TEST_ASSERT(errors.Count() == 0);
+
+	for (vint i = 0; i < callback.perPassTimes.Count(); i++)
+	{
+		unittest::UnitTest::PrintInfo(L"Pass " + itow(i) + L": per resource " + u64tow(callback.perResourceTimes[i]) + L"ms, per pass " + u64tow(callback.perPassTimes[i]) + L"ms");
+	}
+}
@@ -0,0 +1,286 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::elements::text;
+using namespace vl::presentation::controls;
+
+namespace
+{
+	const vint LineCount = 200;
+
+	// characters between "{" and "}" are colored 1, a block could cross lines
+	void ColorizeBraces(const wchar_t* text, vuint32_t* colors, vint length, vint& state)
+	{
+		for (vint i = 0; i < length; i++)
+		{
+			if (text[i] == L'{') state = 1;
+			colors[i] = (vuint32_t)state;
+			if (text[i] == L'}') state = 0;
+		}
+	}
+
+	class BraceColorizer : public GuiTextBoxColorizerBase
+	{
+	protected:
+		ColorArray						colors;
+
+	public:
+		SpinLock						callsLock;
+		List<vint>						calls;
+		volatile vint					blockedLine = -1;
+		EventObject						blockedLineReached;
+		EventObject						blockedLineReleased;
+
+		BraceColorizer()
+		{
+			colors.Resize(2);
+			blockedLineReached.CreateAutoUnsignal(false);
+			blockedLineReleased.CreateAutoUnsignal(false);
+		}
+
+		~BraceColorizer()
+		{
+			StopColorizerForever();
+		}
+
+		vint GetLexerStartState()override
+		{
+			return 0;
+		}
+
+		vint GetContextStartState()override
+		{
+			return 0;
+		}
+
+		void ColorizeLineWithCRLF(vint lineIndex, const wchar_t* text, vuint32_t* colors, vint length, vint& lexerState, vint& contextState)override
+		{
+			SPIN_LOCK(callsLock)
+			{
+				calls.Add(lineIndex);
+			}
+			if (lineIndex == blockedLine)
+			{
+				// stop the colorizer thread here, so that the test could edit lines before this line is written back
+				blockedLine = -1;
+				blockedLineReached.Signal();
+				blockedLineReleased.Wait();
+			}
+			ColorizeBraces(text, colors, length, lexerState);
+		}
+
+		const ColorArray& GetColors()override
+		{
+			return colors;
+		}
+
+		void WaitForColorizer()
+		{
+			colorizerRunningEvent.Enter();
+			colorizerRunningEvent.Leave();
+		}
+
+		void AssertCalls(vint first, vint last)
+		{
+			List<vint> expected;
+			for (vint i = first; i <= last; i++)
+			{
+				expected.Add(i);
+			}
+			AssertCalls(expected);
+		}
+
+		void AssertCalls(const List<vint>& expected)
+		{
+			WaitForColorizer();
+			SPIN_LOCK(callsLock)
+			{
+				TEST_ASSERT(CompareEnumerable(calls, expected) == 0);
+				calls.Clear();
+			}
+		}
+	};
+
+	// three lines in every ten lines are in a block
+	Ptr<GuiColorizedTextElement> CreateElement()
+	{
+		Ptr<GuiColorizedTextElement> element = GuiColorizedTextElement::Create();
+		WString text;
+		for (vint i = 0; i < LineCount; i++)
+		{
+			if (i > 0) text += L"\r\n";
+			switch (i % 10)
+			{
+			case 3: text += L"{"; break;
+			case 6: text += L"}"; break;
+			default: text += L"line " + itow(i);
+			}
+		}
+		element->GetLines().SetText(text);
+		return element;
+	}
+
+	vint FindLine(GuiColorizedTextElement* element, const WString& text, vint start)
+	{
+		auto& lines = element->GetLines();
+		for (vint i = start; i < lines.GetCount(); i++)
+		{
+			if (lines.GetText(TextPos(i, 0), TextPos(i, lines.GetLine(i).dataLength)) == text)
+			{
+				return i;
+			}
+		}
+		TEST_ASSERT(false);
+		return -1;
+	}
+
+	void Edit(GuiTextBoxColorizerBase& colorizer, GuiColorizedTextElement* element, SpinLock& lock, TextPos start, TextPos end, const WString& input)
+	{
+		ICommonTextEditCallback::TextEditNotifyStruct arguments;
+		SPIN_LOCK(lock)
+		{
+			arguments.originalStart = start;
+			arguments.originalEnd = end;
+			arguments.inputStart = start;
+			arguments.inputEnd = element->GetLines().Modify(start, end, input);
+		}
+		colorizer.TextEditNotify(arguments);
+	}
+
+	// compares colors and final states of all lines with colorizing the whole text again
+	void AssertColors(GuiColorizedTextElement* element)
+	{
+		auto& lines = element->GetLines();
+		vint state = 0;
+		for (vint i = 0; i < lines.GetCount(); i++)
+		{
+			auto& line = lines.GetLine(i);
+			Array<vuint32_t> colors(line.dataLength);
+			if (line.dataLength > 0)
+			{
+				ColorizeBraces(line.text, &colors[0], line.dataLength, state);
+			}
+			TEST_ASSERT(line.lexerFinalState == state);
+			for (vint j = 0; j < line.dataLength; j++)
+			{
+				TEST_ASSERT(line.att[j].colorIndex == colors[j]);
+			}
+		}
+	}
+}
+
+TEST_CASE(TestTextBoxColorizer_EditAfterColorizing)
+{
+	SpinLock lock;
+	auto element = CreateElement();
+	BraceColorizer colorizer;
+	colorizer.Attach(element.Obj(), lock, nullptr, 0);
+	colorizer.AssertCalls(0, LineCount - 1);
+	AssertColors(element.Obj());
+
+	// editing a line without changing its final state stops after the next line
+	Edit(colorizer, element.Obj(), lock, TextPos(100, 0), TextPos(100, 4), L"LINE");
+	colorizer.AssertCalls(100, 101);
+	AssertColors(element.Obj());
+
+	// inserting lines shifts the reusable range
+	Edit(colorizer, element.Obj(), lock, TextPos(50, 0), TextPos(50, 0), L"a\r\nb\r\n");
+	TEST_ASSERT(element->GetLines().GetCount() == LineCount + 2);
+	colorizer.AssertCalls(50, 53);
+	AssertColors(element.Obj());
+
+	// removing lines shifts the reusable range
+	Edit(colorizer, element.Obj(), lock, TextPos(60, 0), TextPos(63, 0), L"");
+	TEST_ASSERT(element->GetLines().GetCount() == LineCount - 1);
+	colorizer.AssertCalls(60, 61);
+	AssertColors(element.Obj());
+
+	// removing "{" changes final states of following lines until "}"
+	vint open = FindLine(element.Obj(), L"{", 120);
+	TEST_ASSERT(FindLine(element.Obj(), L"}", open) == open + 3);
+	Edit(colorizer, element.Obj(), lock, TextPos(open, 0), TextPos(open, 1), L"x");
+	colorizer.AssertCalls(open, open + 3);
+	AssertColors(element.Obj());
+
+	// removing the last "}" changes final states of all following lines
+	vint close = FindLine(element.Obj(), L"}", element->GetLines().GetCount() - 10);
+	Edit(colorizer, element.Obj(), lock, TextPos(close, 0), TextPos(close, 1), L"x");
+	colorizer.AssertCalls(close, element->GetLines().GetCount() - 1);
+	AssertColors(element.Obj());
+
+	// two edits before the colorizer catches up are merged into one modified range, the first edited line moves to 31
+	colorizer.blockedLine = 30;
+	Edit(colorizer, element.Obj(), lock, TextPos(30, 0), TextPos(30, 4), L"LINE");
+	colorizer.blockedLineReached.Wait();
+	Edit(colorizer, element.Obj(), lock, TextPos(10, 0), TextPos(10, 0), L"c\r\n");
+	colorizer.blockedLineReleased.Signal();
+
+	List<vint> expected;
+	expected.Add(30);
+	for (vint i = 10; i <= 32; i++) expected.Add(i);
+	colorizer.AssertCalls(expected);
+	AssertColors(element.Obj());
+
+	colorizer.Detach();
+}
+
+TEST_CASE(TestTextBoxColorizer_EditWhileColorizing)
+{
+	// editing a line after the colorized range
+	{
+		SpinLock lock;
+		auto element = CreateElement();
+		BraceColorizer colorizer;
+		colorizer.blockedLine = 100;
+		colorizer.Attach(element.Obj(), lock, nullptr, 0);
+		colorizer.blockedLineReached.Wait();
+		Edit(colorizer, element.Obj(), lock, TextPos(150, 0), TextPos(150, 4), L"LINE");
+		colorizer.blockedLineReleased.Signal();
+		colorizer.AssertCalls(0, LineCount - 1);
+		AssertColors(element.Obj());
+		colorizer.Detach();
+	}
+
+	// editing a line before the colorized range, the line being colorized is discarded and colorized again
+	{
+		SpinLock lock;
+		auto element = CreateElement();
+		BraceColorizer colorizer;
+		colorizer.blockedLine = 100;
+		colorizer.Attach(element.Obj(), lock, nullptr, 0);
+		colorizer.blockedLineReached.Wait();
+		Edit(colorizer, element.Obj(), lock, TextPos(20, 0), TextPos(20, 4), L"LINE");
+		colorizer.blockedLineReleased.Signal();
+
+		List<vint> expected;
+		for (vint i = 0; i <= 100; i++) expected.Add(i);
+		expected.Add(20);
+		expected.Add(21);
+		for (vint i = 100; i < LineCount; i++) expected.Add(i);
+		colorizer.AssertCalls(expected);
+		AssertColors(element.Obj());
+		colorizer.Detach();
+	}
+
+	// editing the line being colorized
+	{
+		SpinLock lock;
+		auto element = CreateElement();
+		BraceColorizer colorizer;
+		colorizer.blockedLine = 100;
+		colorizer.Attach(element.Obj(), lock, nullptr, 0);
+		colorizer.blockedLineReached.Wait();
+		Edit(colorizer, element.Obj(), lock, TextPos(100, 0), TextPos(100, 0), L"{");
+		colorizer.blockedLineReleased.Signal();
+
+		List<vint> expected;
+		for (vint i = 0; i <= 100; i++) expected.Add(i);
+		for (vint i = 100; i < LineCount; i++) expected.Add(i);
+		colorizer.AssertCalls(expected);
+		AssertColors(element.Obj());
+		colorizer.Detach();
+	}
+}
@@ -0,0 +1,243 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::stream;
+using namespace vl::filesystem;
+using namespace vl::presentation;
+using namespace vl::presentation::elements::text;
+using namespace vl::presentation::controls;
+using namespace vl::presentation::templates;
+
+extern WString GetTestOutputPath();
+
+namespace
+{
+	void CreateTestLines(vint count, List<WString>& lines)
+	{
+		for (vint i = 0; i < count; i++)
+		{
+			if (i % 17 == 0)
+			{
+				lines.Add(L"");
+			}
+			else if (i % 101 == 0)
+			{
+				// longer than the block to read a line
+				WString line;
+				for (vint j = 0; j < 1000; j++)
+				{
+					line += L"[" + itow(i) + L":" + itow(j) + L"]";
+				}
+				lines.Add(line);
+			}
+			else
+			{
+				lines.Add(L"Line " + itow(i) + L" \x4E2D\x6587 text");
+			}
+		}
+	}
+
+	WString WriteTestFile(const WString& name, List<WString>& lines, const WString& lineBreak, bool bom, BomEncoder::Encoding encoding)
+	{
+		WString text;
+		{
+			MemoryStream stream;
+			{
+				StreamWriter writer(stream);
+				FOREACH_INDEXER(WString, line, index, lines)
+				{
+					if (index > 0)
+					{
+						writer.WriteString(lineBreak);
+					}
+					writer.WriteString(line);
+				}
+			}
+			stream.SeekFromBegin(0);
+			StreamReader reader(stream);
+			text = reader.ReadToEnd();
+		}
+
+		auto path = (FilePath(GetTestOutputPath()) / name).GetFullPath();
+		TEST_ASSERT(File(path).WriteAllText(text, bom, encoding));
+		return path;
+	}
+
+	void WaitForLineCount(Ptr<FileTextLineProvider> provider)
+	{
+		while (!provider->IsLineCountFinal())
+		{
+			Thread::Sleep(1);
+		}
+	}
+
+	void AssertLines(Ptr<FileTextLineProvider> provider, List<WString>& lines)
+	{
+		WaitForLineCount(provider);
+		TEST_ASSERT(provider->GetLineCount() == lines.Count());
+
+		// in order, which reads from the end of the previous line
+		for (vint i = 0; i < lines.Count(); i++)
+		{
+			TEST_ASSERT(provider->GetLineText(i) == lines[i]);
+		}
+
+		// in reverse order, which reads from indexed lines
+		for (vint i = lines.Count() - 1; i >= 0; i--)
+		{
+			TEST_ASSERT(provider->GetLineText(i) == lines[i]);
+		}
+
+		// skipping lines
+		for (vint i = 0; i < lines.Count(); i += 7)
+		{
+			TEST_ASSERT(provider->GetLineText(i) == lines[i]);
+			TEST_ASSERT(provider->GetLineText(lines.Count() - 1 - i) == lines[lines.Count() - 1 - i]);
+		}
+
+		TEST_ASSERT(provider->GetLineText(-1) == L"");
+		TEST_ASSERT(provider->GetLineText(lines.Count()) == L"");
+	}
+
+	GuiScroll* CreateTestScroll(theme::ThemeName themeName)
+	{
+		auto scroll = new GuiScroll(themeName);
+		scroll->SetControlTemplate([](const description::Value&)
+		{
+			return new GuiScrollTemplate;
+		});
+		return scroll;
+	}
+
+	GuiMultilineTextBox* CreateTestTextBox()
+	{
+		auto textBox = new GuiMultilineTextBox(theme::ThemeName::MultilineTextBox);
+		textBox->SetControlTemplate([](const description::Value&)
+		{
+			auto ct = new GuiMultilineTextBoxTemplate;
+			auto hScroll = CreateTestScroll(theme::ThemeName::HScroll);
+			auto vScroll = CreateTestScroll(theme::ThemeName::VScroll);
+			ct->AddChild(hScroll->GetBoundsComposition());
+			ct->AddChild(vScroll->GetBoundsComposition());
+			ct->SetHorizontalScroll(hScroll);
+			ct->SetVerticalScroll(vScroll);
+			return ct;
+		});
+		return textBox;
+	}
+}
+
+TEST_CASE(TestTextLineProvider_ReadLines)
+{
+	List<WString> lines;
+	CreateTestLines(1000, lines);
+
+	AssertLines(new FileTextLineProvider(WriteTestFile(L"TextLineProvider.Utf8.txt", lines, L"\r\n", true, BomEncoder::Utf8)), lines);
+	AssertLines(new FileTextLineProvider(WriteTestFile(L"TextLineProvider.Utf8NoBom.txt", lines, L"\n", false, BomEncoder::Utf8)), lines);
+	AssertLines(new FileTextLineProvider(WriteTestFile(L"TextLineProvider.Utf16.txt", lines, L"\r\n", true, BomEncoder::Utf16)), lines);
+}
+
+TEST_CASE(TestTextLineProvider_MissingFile)
+{
+	auto provider = MakePtr<FileTextLineProvider>((FilePath(GetTestOutputPath()) / L"TextLineProvider.NotExists.txt").GetFullPath());
+	TEST_ASSERT(!provider->IsAvailable());
+	TEST_ASSERT(provider->IsLineCountFinal());
+	TEST_ASSERT(provider->GetLineCount() == 1);
+	TEST_ASSERT(provider->GetLineText(0) == L"");
+}
+
+TEST_CASE(TestTextLineProvider_ReadLinesWhileCounting)
+{
+	List<WString> lines;
+	CreateTestLines(200000, lines);
+	auto path = WriteTestFile(L"TextLineProvider.Large.txt", lines, L"\r\n", true, BomEncoder::Utf8);
+
+	auto provider = MakePtr<FileTextLineProvider>(path);
+	TextLines textLines(nullptr);
+	textLines.SetLineProvider(provider);
+
+	// lines are counted in the background, every counted line could be read
+	vint lastCount = 0;
+	while (true)
+	{
+		bool finished = provider->IsLineCountFinal();
+		vint count = provider->GetLineCount();
+		TEST_ASSERT(lastCount <= count && count <= lines.Count());
+		TEST_ASSERT(textLines.GetCount() == (count > 0 ? count : 1));
+		if (count > 0)
+		{
+			TEST_ASSERT(provider->GetLineText(count - 1) == lines[count - 1]);
+			TEST_ASSERT(WString(textLines.GetLine(count - 1).text, textLines.GetLine(count - 1).dataLength) == lines[count - 1]);
+		}
+		else
+		{
+			// a line that is not counted yet is not kept
+			TEST_ASSERT(textLines.GetLine(0).dataLength == 0);
+		}
+		lastCount = count;
+		if (finished) break;
+	}
+
+	TEST_ASSERT(provider->GetLineCount() == lines.Count());
+	TEST_ASSERT(textLines.GetCount() == lines.Count());
+	TEST_ASSERT(WString(textLines.GetLine(0).text, textLines.GetLine(0).dataLength) == lines[0]);
+	textLines.SetLineProvider(nullptr);
+}
+
+TEST_CASE(TestTextLineProvider_DestroyWhileCounting)
+{
+	List<WString> lines;
+	CreateTestLines(200000, lines);
+	auto path = WriteTestFile(L"TextLineProvider.Large.txt", lines, L"\n", false, BomEncoder::Utf8);
+	for (vint i = 0; i < 10; i++)
+	{
+		// the destructor stops counting lines
+		auto provider = MakePtr<FileTextLineProvider>(path);
+		TEST_ASSERT(provider->GetLineCount() <= lines.Count());
+	}
+}
+
+TEST_CASE(TestTextLineProvider_ReadonlyRestored)
+{
+	List<WString> lines;
+	CreateTestLines(100, lines);
+	auto path = WriteTestFile(L"TextLineProvider.Small.txt", lines, L"\r\n", true, BomEncoder::Utf8);
+
+	auto textBox = CreateTestTextBox();
+	TEST_ASSERT(!textBox->GetReadonly());
+
+	auto provider = MakePtr<FileTextLineProvider>(path);
+	textBox->SetLineProvider(provider);
+	TEST_ASSERT(textBox->GetReadonly());
+	textBox->SetLineProvider(nullptr);
+	TEST_ASSERT(!textBox->GetReadonly());
+	TEST_ASSERT(textBox->GetText() == L"");
+
+	// setting the text also removes the line provider
+	textBox->SetLineProvider(provider);
+	TEST_ASSERT(textBox->GetReadonly());
+	textBox->SetText(L"text");
+	TEST_ASSERT(!textBox->GetLineProvider());
+	TEST_ASSERT(!textBox->GetReadonly());
+	TEST_ASSERT(textBox->GetText() == L"text");
+
+	// a read-only text box stays read-only
+	textBox->SetReadonly(true);
+	textBox->SetLineProvider(provider);
+	textBox->SetLineProvider(provider);
+	textBox->SetLineProvider(nullptr);
+	TEST_ASSERT(textBox->GetReadonly());
+
+	textBox->SetReadonly(false);
+	textBox->SetLineProvider(provider);
+	WaitForLineCount(provider);
+	TEST_ASSERT(textBox->GetLineProvider() == provider);
+	WString text;
+	FOREACH_INDEXER(WString, line, index, lines)
+	{
+		text += (index == 0 ? L"" : L"\r\n") + line;
+	}
+	TEST_ASSERT(textBox->GetText() == text);
+	SafeDeleteControl(textBox);
+}
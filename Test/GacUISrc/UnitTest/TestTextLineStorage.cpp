@@ -0,0 +1,279 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation::elements::text;
+
+namespace
+{
+	// exposes blocks of TextLineStorage and checks them against a flat list of line ids
+	class TestTextLineStorage : public TextLineStorage
+	{
+	public:
+		using TextLineStorage::BlockSize;
+		using TextLineStorage::RebuildIndex;
+		using TextLineStorage::FindBlock;
+		using TextLineStorage::SplitBlock;
+		using TextLineStorage::MergeBlock;
+
+		vint BlockCount()
+		{
+			return blocks.Count();
+		}
+
+		vint BlockLineCount(vint block)
+		{
+			return blocks[block]->Count();
+		}
+
+		vint PrefixSum(vint blockCount)
+		{
+			// sums the binary indexed tree the same way as a query, instead of summing block sizes
+			vint sum = 0;
+			for (vint i = blockCount; i > 0; i -= i & -i)
+			{
+				sum += blockIndex[i];
+			}
+			return sum;
+		}
+
+		void AssertBlocks(const List<vint>& expected)
+		{
+			TEST_ASSERT(Count() == expected.Count());
+			if (blocks.Count() == 0)
+			{
+				TEST_ASSERT(Count() == 0);
+				return;
+			}
+			TEST_ASSERT(blockIndex.Count() == blocks.Count() + 1);
+
+			vint start = 0;
+			for (vint i = 0; i < blocks.Count(); i++)
+			{
+				vint size = blocks[i]->Count();
+				TEST_ASSERT(0 < size && size <= BlockSize * 2);
+				TEST_ASSERT(PrefixSum(i) == start);
+
+				// the first and the last line of every block, and the first line of the next block
+				vint blockStart = -1;
+				TEST_ASSERT(FindBlock(start, blockStart) == i);
+				TEST_ASSERT(blockStart == start);
+				TEST_ASSERT(FindBlock(start + size - 1, blockStart) == i);
+				TEST_ASSERT(blockStart == start);
+				if (i + 1 < blocks.Count())
+				{
+					TEST_ASSERT(FindBlock(start + size, blockStart) == i + 1);
+					TEST_ASSERT(blockStart == start + size);
+				}
+				start += size;
+			}
+			TEST_ASSERT(PrefixSum(blocks.Count()) == expected.Count());
+
+			for (vint i = 0; i < expected.Count(); i++)
+			{
+				TEST_ASSERT((*this)[i].lexerFinalState == expected[i]);
+			}
+			for (vint i = expected.Count() - 1; i >= 0; i--)
+			{
+				TEST_ASSERT((*this)[i].lexerFinalState == expected[i]);
+			}
+		}
+	};
+
+	TextLine CreateLine(vint id)
+	{
+		TextLine line;
+		line.lexerFinalState = id;
+		return line;
+	}
+
+	void Insert(TestTextLineStorage& storage, List<vint>& expected, vint index, vint id)
+	{
+		storage.Insert(index, CreateLine(id));
+		expected.Insert(index, id);
+	}
+
+	void RemoveRange(TestTextLineStorage& storage, List<vint>& expected, vint index, vint count)
+	{
+		storage.RemoveRange(index, count);
+		expected.RemoveRange(index, count);
+	}
+}
+
+TEST_CASE(TestTextLineStorage_AddAndSplit)
+{
+	TestTextLineStorage storage;
+	List<vint> expected;
+	storage.AssertBlocks(expected);
+
+	// a block is split when it grows over BlockSize * 2 lines
+	vint nextId = 0;
+	for (vint i = 0; i < TestTextLineStorage::BlockSize * 2; i++)
+	{
+		storage.Add(CreateLine(nextId));
+		expected.Add(nextId++);
+	}
+	TEST_ASSERT(storage.BlockCount() == 1);
+	storage.AssertBlocks(expected);
+
+	storage.Add(CreateLine(nextId));
+	expected.Add(nextId++);
+	TEST_ASSERT(storage.BlockCount() == 2);
+	storage.AssertBlocks(expected);
+
+	for (vint i = 0; i < TestTextLineStorage::BlockSize * 10; i++)
+	{
+		storage.Add(CreateLine(nextId));
+		expected.Add(nextId++);
+	}
+	TEST_ASSERT(storage.BlockCount() > 5);
+	storage.AssertBlocks(expected);
+}
+
+TEST_CASE(TestTextLineStorage_SplitAndMergeBlock)
+{
+	TestTextLineStorage storage;
+	List<vint> expected;
+	for (vint i = 0; i < 1000; i++)
+	{
+		Insert(storage, expected, i, i);
+	}
+	TEST_ASSERT(storage.BlockCount() == 1);
+
+	// splitting and merging blocks keep lines in order
+	storage.SplitBlock(0);
+	storage.RebuildIndex();
+	TEST_ASSERT(storage.BlockCount() == 2);
+	TEST_ASSERT(storage.BlockLineCount(0) == 500);
+	TEST_ASSERT(storage.BlockLineCount(1) == 500);
+	storage.AssertBlocks(expected);
+
+	storage.SplitBlock(1);
+	storage.RebuildIndex();
+	TEST_ASSERT(storage.BlockCount() == 3);
+	TEST_ASSERT(storage.BlockLineCount(1) == 250);
+	TEST_ASSERT(storage.BlockLineCount(2) == 250);
+	storage.AssertBlocks(expected);
+
+	storage.MergeBlock(0);
+	storage.RebuildIndex();
+	TEST_ASSERT(storage.BlockCount() == 2);
+	TEST_ASSERT(storage.BlockLineCount(0) == 750);
+	storage.AssertBlocks(expected);
+
+	storage.MergeBlock(0);
+	storage.RebuildIndex();
+	TEST_ASSERT(storage.BlockCount() == 1);
+	storage.AssertBlocks(expected);
+}
+
+TEST_CASE(TestTextLineStorage_EditAtBlockBoundaries)
+{
+	TestTextLineStorage storage;
+	List<vint> expected;
+	vint nextId = 0;
+	for (vint i = 0; i < TestTextLineStorage::BlockSize * 8; i++)
+	{
+		Insert(storage, expected, i, nextId++);
+	}
+	storage.AssertBlocks(expected);
+
+	auto blockStart = [&](vint block)
+	{
+		vint start = 0;
+		for (vint i = 0; i < block; i++)
+		{
+			start += storage.BlockLineCount(i);
+		}
+		return start;
+	};
+
+	// inserting before the first line, at the end, and before and after the first line of a block
+	Insert(storage, expected, 0, nextId++);
+	Insert(storage, expected, expected.Count(), nextId++);
+	storage.AssertBlocks(expected);
+	Insert(storage, expected, blockStart(1), nextId++);
+	storage.AssertBlocks(expected);
+	Insert(storage, expected, blockStart(2) + 1, nextId++);
+	storage.AssertBlocks(expected);
+
+	// removing the last line of a block, the first line of the next block, and lines across two blocks
+	RemoveRange(storage, expected, blockStart(1) - 1, 1);
+	storage.AssertBlocks(expected);
+	RemoveRange(storage, expected, blockStart(1), 1);
+	storage.AssertBlocks(expected);
+	RemoveRange(storage, expected, blockStart(2) - 3, 6);
+	storage.AssertBlocks(expected);
+
+	// removing a whole block, and lines across three blocks
+	RemoveRange(storage, expected, blockStart(1), storage.BlockLineCount(1));
+	storage.AssertBlocks(expected);
+	RemoveRange(storage, expected, blockStart(1) - 10, storage.BlockLineCount(1) + 20);
+	storage.AssertBlocks(expected);
+
+	// shrinking blocks merges them
+	vint blockCount = storage.BlockCount();
+	while (storage.BlockLineCount(0) >= TestTextLineStorage::BlockSize / 2)
+	{
+		RemoveRange(storage, expected, 0, 100);
+	}
+	TEST_ASSERT(storage.BlockCount() < blockCount);
+	storage.AssertBlocks(expected);
+
+	RemoveRange(storage, expected, 0, expected.Count());
+	TEST_ASSERT(storage.BlockCount() == 0);
+	storage.AssertBlocks(expected);
+	Insert(storage, expected, 0, nextId++);
+	storage.AssertBlocks(expected);
+}
+
+TEST_CASE(TestTextLineStorage_RandomEdits)
+{
+	TestTextLineStorage storage;
+	List<vint> expected;
+	vint nextId = 0;
+	vuint seed = 0;
+	auto random = [&](vint range)
+	{
+		seed = seed * 1103515245 + 12345;
+		return (vint)((seed >> 8) % range);
+	};
+
+	for (vint i = 0; i < 2000; i++)
+	{
+		vint operation = random(10);
+		if (operation < 6 || expected.Count() == 0)
+		{
+			// inserts are grouped, like pasting text
+			vint index = random(expected.Count() + 1);
+			vint count = 1 + random(operation == 0 ? 1000 : 3);
+			for (vint j = 0; j < count; j++)
+			{
+				Insert(storage, expected, index + j, nextId++);
+			}
+		}
+		else
+		{
+			vint index = random(expected.Count());
+			vint count = 1 + random(operation == 9 ? 600 : 3);
+			if (count > expected.Count() - index)
+			{
+				count = expected.Count() - index;
+			}
+			RemoveRange(storage, expected, index, count);
+		}
+
+		// random access through the binary indexed tree instead of the cached block
+		if (expected.Count() > 0)
+		{
+			vint index = random(expected.Count());
+			TEST_ASSERT(storage[index].lexerFinalState == expected[index]);
+		}
+		if (i % 100 == 0)
+		{
+			storage.AssertBlocks(expected);
+		}
+	}
+	storage.AssertBlocks(expected);
+	TEST_ASSERT(storage.BlockCount() > 10);
+}
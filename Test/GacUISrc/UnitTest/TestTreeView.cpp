@@ -0,0 +1,133 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+using namespace vl::presentation::controls::tree;
+
+namespace
+{
+	Ptr<MemoryNodeProvider> CreateNode(const WString& text)
+	{
+		return new MemoryNodeProvider(new TreeViewItem(nullptr, text));
+	}
+
+	void CollectVisibleNodes(MemoryNodeProvider* node, List<INodeProvider*>& nodes)
+	{
+		if (node->GetExpanding())
+		{
+			for (vint i = 0; i < node->Children().Count(); i++)
+			{
+				auto child = node->Children()[i].Obj();
+				nodes.Add(child);
+				CollectVisibleNodes(child, nodes);
+			}
+		}
+	}
+
+	void AssertVisibleNodes(Ptr<TreeViewItemRootProvider> root, Ptr<NodeItemProvider> provider)
+	{
+		List<INodeProvider*> nodes;
+		CollectVisibleNodes(root.Obj(), nodes);
+		TEST_ASSERT(provider->Count() == nodes.Count());
+
+		auto view = dynamic_cast<INodeItemView*>(provider->RequestView(INodeItemView::Identifier));
+		for (vint i = 0; i < nodes.Count(); i++)
+		{
+			auto node = view->RequestNode(i);
+			TEST_ASSERT(node == nodes[i]);
+			view->ReleaseNode(node);
+			TEST_ASSERT(view->CalculateNodeVisibilityIndex(nodes[i]) == i);
+		}
+		TEST_ASSERT(view->RequestNode(nodes.Count()) == nullptr);
+	}
+}
+
+TEST_CASE(TestTreeView_NodeItemProvider_VisibleIndex)
+{
+	auto root = MakePtr<TreeViewItemRootProvider>();
+	auto provider = MakePtr<NodeItemProvider>(root);
+	AssertVisibleNodes(root, provider);
+
+	for (vint i = 0; i < 5; i++)
+	{
+		auto a = CreateNode(itow(i));
+		root->Children().Add(a);
+		for (vint j = 0; j < 4; j++)
+		{
+			auto b = CreateNode(itow(i) + L"." + itow(j));
+			a->Children().Add(b);
+			for (vint k = 0; k < 3; k++)
+			{
+				b->Children().Add(CreateNode(itow(i) + L"." + itow(j) + L"." + itow(k)));
+			}
+		}
+	}
+	AssertVisibleNodes(root, provider);
+
+	auto node1 = root->Children()[1];
+	auto node12 = node1->Children()[2];
+	auto node3 = root->Children()[3];
+	auto node31 = node3->Children()[1];
+
+	node12->SetExpanding(true);
+	AssertVisibleNodes(root, provider);
+	node1->SetExpanding(true);
+	AssertVisibleNodes(root, provider);
+	node3->SetExpanding(true);
+	node31->SetExpanding(true);
+	AssertVisibleNodes(root, provider);
+
+	node1->SetExpanding(false);
+	AssertVisibleNodes(root, provider);
+	node12->SetExpanding(false);
+	node1->SetExpanding(true);
+	AssertVisibleNodes(root, provider);
+
+	node31->Children().Insert(0, CreateNode(L"new"));
+	node12->Children().Add(CreateNode(L"hidden"));
+	AssertVisibleNodes(root, provider);
+
+	node3->Children().RemoveAt(0);
+	AssertVisibleNodes(root, provider);
+
+	root->Children().RemoveAt(1);
+	AssertVisibleNodes(root, provider);
+
+	root->Children().Clear();
+	AssertVisibleNodes(root, provider);
+}
+
+TEST_CASE(TestTreeView_NodeItemProvider_LargeTree)
+{
+	auto root = MakePtr<TreeViewItemRootProvider>();
+	auto provider = MakePtr<NodeItemProvider>(root);
+	auto view = dynamic_cast<INodeItemView*>(provider->RequestView(INodeItemView::Identifier));
+
+	const vint count = 1000;
+	for (vint i = 0; i < count; i++)
+	{
+		auto a = CreateNode(itow(i));
+		a->SetExpanding(true);
+		for (vint j = 0; j < count / 2; j++)
+		{
+			a->Children().Add(CreateNode(L""));
+		}
+		root->Children().Add(a);
+	}
+	TEST_ASSERT(provider->Count() == count * (count / 2 + 1));
+
+	for (vint i = 0; i < provider->Count(); i += 7)
+	{
+		auto node = view->RequestNode(i);
+		TEST_ASSERT(view->CalculateNodeVisibilityIndex(node) == i);
+		view->ReleaseNode(node);
+	}
+
+	root->Children()[count / 2]->SetExpanding(false);
+	TEST_ASSERT(provider->Count() == count * (count / 2 + 1) - count / 2);
+	auto node = view->RequestNode(count / 2 * (count / 2 + 1) + 1);
+	TEST_ASSERT(node == root->Children()[count / 2 + 1].Obj());
+	view->ReleaseNode(node);
+}
@@ -0,0 +1,169 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Compiler/GuiInstanceLoader.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::stream;
+using namespace vl::parsing;
+using namespace vl::workflow;
+using namespace vl::workflow::emitter;
+using namespace vl::workflow::runtime;
+
+namespace
+{
+	const wchar_t* TestWorkflowAssemblyCode = LR"Workflow(
+module test;
+
+class Counter
+{
+	var value : int = 0;
+
+	func Add(x : int) : void
+	{
+		value = value + x;
+	}
+
+	func Get() : int
+	{
+		return value;
+	}
+
+	new()
+	{
+	}
+}
+
+func Fib(n : int) : int
+{
+	if (n < 2)
+	{
+		return n;
+	}
+	return Fib(n - 1) + Fib(n - 2);
+}
+
+func Sum(n : int) : int
+{
+	var counter = new Counter^();
+	for (i in range [1, n])
+	{
+		counter.Add(i);
+	}
+	return counter.Get();
+}
+
+func Join(n : int) : string
+{
+	var s = "";
+	for (i in range [1, n])
+	{
+		s = s & (cast string i);
+	}
+	return s;
+}
+)Workflow";
+
+	Ptr<WfAssembly> CompileTestAssembly()
+	{
+		List<WString> codes;
+		codes.Add(TestWorkflowAssemblyCode);
+		List<Ptr<ParsingError>> errors;
+		auto assembly = Compile(WfLoadTable(), codes, errors);
+		TEST_ASSERT(errors.Count() == 0);
+		TEST_ASSERT(assembly);
+		return assembly;
+	}
+
+	Ptr<WfAssembly> RoundTrip(Ptr<WfAssembly> assembly, bool loadOnDemand)
+	{
+		MemoryStream stream;
+		assembly->Serialize(stream, loadOnDemand);
+		stream.SeekFromBegin(0);
+		return new WfAssembly(stream);
+	}
+
+	void ExecuteTestAssembly(Ptr<WfAssembly> assembly)
+	{
+		auto globalContext = MakePtr<WfRuntimeGlobalContext>(assembly);
+		LoadFunction<void()>(globalContext, L"<initialize>")();
+
+		TEST_ASSERT(LoadFunction<vint(vint)>(globalContext, L"Fib")(10) == 55);
+		TEST_ASSERT(LoadFunction<vint(vint)>(globalContext, L"Sum")(100) == 5050);
+		TEST_ASSERT(LoadFunction<WString(vint)>(globalContext, L"Join")(5) == L"12345");
+
+		// functions are loaded on their first calls, which could happen in different threads at the same time
+		const vint threadCount = 4;
+		auto sum = LoadFunction<vint(vint)>(globalContext, L"Sum");
+		auto join = LoadFunction<WString(vint)>(globalContext, L"Join");
+		vint results[threadCount] = { 0 };
+		WString joins[threadCount];
+		List<Thread*> threads;
+		for (vint i = 0; i < threadCount; i++)
+		{
+			threads.Add(Thread::CreateAndStart([&, i]()
+			{
+				results[i] = sum(1000);
+				joins[i] = join(3);
+			}, false));
+		}
+		FOREACH(Thread*, thread, threads)
+		{
+			thread->Wait();
+			delete thread;
+		}
+		for (vint i = 0; i < threadCount; i++)
+		{
+			TEST_ASSERT(results[i] == 500500);
+			TEST_ASSERT(joins[i] == L"123");
+		}
+	}
+}
+
+TEST_CASE(TestWorkflowAssembly_RoundTripLoadOnDemand)
+{
+	auto assembly = RoundTrip(CompileTestAssembly(), true);
+	ExecuteTestAssembly(assembly);
+
+	// an assembly that is loaded on demand could be serialized again
+	ExecuteTestAssembly(RoundTrip(assembly, true));
+	ExecuteTestAssembly(RoundTrip(assembly, false));
+}
+
+TEST_CASE(TestWorkflowAssembly_RoundTripPreviousFormat)
+{
+	auto assembly = RoundTrip(CompileTestAssembly(), false);
+	ExecuteTestAssembly(assembly);
+	ExecuteTestAssembly(RoundTrip(assembly, true));
+}
+
+TEST_CASE(TestWorkflowAssembly_ConcurrentFirstCalls)
+{
+	// every thread calls a function that is not loaded yet
+	for (vint i = 0; i < 20; i++)
+	{
+		auto assembly = RoundTrip(CompileTestAssembly(), true);
+		auto globalContext = MakePtr<WfRuntimeGlobalContext>(assembly);
+		LoadFunction<void()>(globalContext, L"<initialize>")();
+
+		auto fib = LoadFunction<vint(vint)>(globalContext, L"Fib");
+		const vint threadCount = 4;
+		vint results[threadCount] = { 0 };
+		List<Thread*> threads;
+		for (vint j = 0; j < threadCount; j++)
+		{
+			threads.Add(Thread::CreateAndStart([&, j]()
+			{
+				results[j] = fib(15);
+			}, false));
+		}
+		FOREACH(Thread*, thread, threads)
+		{
+			thread->Wait();
+			delete thread;
+		}
+		for (vint j = 0; j < threadCount; j++)
+		{
+			TEST_ASSERT(results[j] == 610);
+		}
+	}
+}
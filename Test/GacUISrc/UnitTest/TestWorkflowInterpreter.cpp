@@ -0,0 +1,697 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Compiler/GuiInstanceLoader.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::parsing;
+using namespace vl::workflow;
+using namespace vl::workflow::emitter;
+using namespace vl::workflow::runtime;
+
+namespace
+{
+	const wchar_t* TestWorkflowInterpreterCode = LR"Workflow(
+module test;
+using system::*;
+
+var globalCounter = 0;
+
+interface IAccumulator
+{
+	func Add(x : int) : void;
+	func Get() : int;
+}
+
+struct Point
+{
+	x : int;
+	y : int;
+}
+
+class Counter
+{
+	var value : int = 0;
+
+	event ValueChanged();
+
+	func GetValue() : int
+	{
+		return value;
+	}
+
+	func SetValue(x : int) : void
+	{
+		if (value != x)
+		{
+			value = x;
+			ValueChanged();
+		}
+	}
+
+	prop Value : int {GetValue, SetValue : ValueChanged}
+
+	new()
+	{
+	}
+}
+
+class DerivedCounter : Counter
+{
+	new() : Counter()
+	{
+	}
+}
+
+func Integers(n : int) : int
+{
+	var s = 0;
+	for (i in range [1, n])
+	{
+		s = (s + i * 3 - i / 2) % 1000003;
+		s = ((s shl 2) shr 1) xor ((i and 255) or (i % 5));
+		s = -(-s) + (+((not i) and 15));
+		if (i < s) { s = s + 1; }
+		if (i <= s) { s = s + 2; }
+		if (i > s) { s = s + 3; }
+		if (i >= s) { s = s + 4; }
+		if (i == s) { s = s + 5; }
+		if (i != s) { s = s + 6; }
+	}
+	return s;
+}
+
+func UnsignedIntegers(n : int) : uint
+{
+	var s : uint = 0;
+	var seven : uint = 7;
+	var three : uint = 3;
+	var modulus : uint = 1000003;
+	for (i in range [1, n])
+	{
+		var u = cast uint i;
+		s = (s * seven + u) % modulus;
+		s = s xor (u shl three);
+	}
+	return s;
+}
+
+func Doubles(n : int) : double
+{
+	var s = 0.0;
+	for (i in range [1, n])
+	{
+		var d = cast double i;
+		s = s + d / 3.0 * 1.5 - 0.25 + (d ^ 0.5);
+		if (s > 1000000.0) { s = s - 1000000.0; }
+	}
+	return s;
+}
+
+func Booleans(n : int) : int
+{
+	var c = 0;
+	var b = false;
+	for (i in range [1, n])
+	{
+		b = (b xor (i % 3 == 0)) and (not (i % 5 == 0)) or (i % 7 == 0);
+		if (b) { c = c + 1; }
+	}
+	return c;
+}
+
+func Strings(n : int) : int
+{
+	var c = 0;
+	var s = "";
+	for (i in range [1, n])
+	{
+		s = s & (cast string (i % 10));
+		if (i % 16 == 0)
+		{
+			if (s < "5") { c = c + 1; }
+			if (s == "7890123456789012") { c = c + 100; }
+			s = "";
+		}
+	}
+	return c;
+}
+
+func Fib(n : int) : int
+{
+	if (n < 2)
+	{
+		return n;
+	}
+	return Fib(n - 1) + Fib(n - 2);
+}
+
+func Calls(n : int) : int
+{
+	var c = 0;
+	for (i in range [1, n / 100])
+	{
+		c = c + Fib(10);
+	}
+	return c;
+}
+
+func Closures(n : int) : int
+{
+	var sum = 0;
+	var modulus = 1000003;
+	var add = func(x : int, y : int) : int
+	{
+		return (x + y) % modulus;
+	};
+	var twice : func(int) : int = [$1 * 2];
+	for (i in range [1, n])
+	{
+		sum = add(sum, twice(i));
+	}
+	return sum;
+}
+
+func Classes(n : int) : int
+{
+	var counter : Counter^ = new DerivedCounter^();
+	var changes = 0;
+	var events : int[] = {};
+	var handler = attach(counter.ValueChanged, func() : void
+	{
+		events.Add(0);
+	});
+	for (i in range [1, n])
+	{
+		counter.Value = (counter.Value + i) % 1000;
+		if (counter is DerivedCounter^) { changes = changes + 1; }
+		if ((counter as DerivedCounter^) is null) { changes = changes - 1; }
+	}
+	detach(counter.ValueChanged, handler);
+	return counter.Value + changes + events.Count;
+}
+
+func Interfaces(n : int) : int
+{
+	var accumulator = new IAccumulator^
+	{
+		var sum = 0;
+
+		override func Add(x : int) : void
+		{
+			sum = (sum + x) % 1000003;
+		}
+
+		override func Get() : int
+		{
+			return sum;
+		}
+	};
+	for (i in range [1, n])
+	{
+		accumulator.Add(i);
+	}
+	return accumulator.Get();
+}
+
+func Collections(n : int) : int
+{
+	var c = 0;
+	var set = {1 3 5 7};
+	for (i in range [1, n / 10])
+	{
+		var xs : int[] = {i; i + 1; i + 2;};
+		var map : int[int] = {1 : i; 2 : i + 1;};
+		var observable : observe int[] = {i};
+		observable.Add(i);
+		for (x in xs)
+		{
+			c = c + x;
+		}
+		c = (c + map[2] + observable.Count) % 1000003;
+		if ((i % 10) in set) { c = c + 1; }
+	}
+	return c;
+}
+
+func Exceptions(n : int) : int
+{
+	var c = 0;
+	for (i in range [1, n / 10])
+	{
+		try
+		{
+			if (i % 2 == 0)
+			{
+				raise "Exception";
+			}
+			c = c + 1;
+		}
+		catch (ex)
+		{
+			if (ex.Message == "Exception")
+			{
+				c = c + 2;
+			}
+		}
+	}
+	return c;
+}
+
+func Structs(n : int) : int
+{
+	var c = 0;
+	for (i in range [1, n])
+	{
+		var p : Point = {x : i; y : i * 2;};
+		c = (c + p.x + p.y) % 1000003;
+	}
+	return c;
+}
+
+func Globals(n : int) : int
+{
+	globalCounter = 0;
+	for (i in range [1, n])
+	{
+		globalCounter = (globalCounter + i) % 1000003;
+	}
+	return globalCounter;
+}
+
+func Objects(n : int) : int
+{
+	var c = 0;
+	for (i in range [1, n])
+	{
+		var o : object = i;
+		if (o is int) { c = c + 1; }
+		if ((o as Counter^) is not null) { c = c + 1; }
+		if (type(o) == typeof(int)) { c = c + 1; }
+		c = c + cast int o;
+		c = c % 1000003;
+	}
+	return c;
+}
+
+func NativeMembers(xs : int[], n : int) : int
+{
+	for (i in range [1, n])
+	{
+		xs.Add(i);
+	}
+	return xs.Count;
+}
+)Workflow";
+
+	vint RefIntegers(vint n)
+	{
+		vint s = 0;
+		for (vint i = 1; i <= n; i++)
+		{
+			s = (s + i * 3 - i / 2) % 1000003;
+			s = ((s << 2) >> 1) ^ ((i & 255) | (i % 5));
+			s = -(-s) + (+((~i) & 15));
+			if (i < s) { s = s + 1; }
+			if (i <= s) { s = s + 2; }
+			if (i > s) { s = s + 3; }
+			if (i >= s) { s = s + 4; }
+			if (i == s) { s = s + 5; }
+			if (i != s) { s = s + 6; }
+		}
+		return s;
+	}
+
+	vuint RefUnsignedIntegers(vint n)
+	{
+		vuint s = 0;
+		for (vint i = 1; i <= n; i++)
+		{
+			vuint u = (vuint)i;
+			s = (s * 7 + u) % 1000003;
+			s = s ^ (u << 3);
+		}
+		return s;
+	}
+
+	double RefDoubles(vint n)
+	{
+		double s = 0;
+		for (vint i = 1; i <= n; i++)
+		{
+			double d = (double)i;
+			s = s + d / 3.0 * 1.5 - 0.25 + exp(0.5 * log(d));
+			if (s > 1000000.0) { s = s - 1000000.0; }
+		}
+		return s;
+	}
+
+	vint RefBooleans(vint n)
+	{
+		vint c = 0;
+		bool b = false;
+		for (vint i = 1; i <= n; i++)
+		{
+			b = ((b != (i % 3 == 0)) && !(i % 5 == 0)) || (i % 7 == 0);
+			if (b) { c = c + 1; }
+		}
+		return c;
+	}
+
+	vint RefStrings(vint n)
+	{
+		vint c = 0;
+		WString s;
+		for (vint i = 1; i <= n; i++)
+		{
+			s = s + itow(i % 10);
+			if (i % 16 == 0)
+			{
+				if (s < L"5") { c = c + 1; }
+				if (s == L"7890123456789012") { c = c + 100; }
+				s = L"";
+			}
+		}
+		return c;
+	}
+
+	vint RefCalls(vint n)
+	{
+		return (n / 100) * 55;
+	}
+
+	vint RefClosures(vint n)
+	{
+		vint sum = 0;
+		for (vint i = 1; i <= n; i++)
+		{
+			sum = (sum + i * 2) % 1000003;
+		}
+		return sum;
+	}
+
+	vint RefClasses(vint n)
+	{
+		vint value = 0;
+		vint changes = 0;
+		for (vint i = 1; i <= n; i++)
+		{
+			vint newValue = (value + i) % 1000;
+			if (value != newValue)
+			{
+				value = newValue;
+				changes++;
+			}
+			changes++;
+		}
+		return value + changes;
+	}
+
+	vint RefSum(vint n)
+	{
+		vint sum = 0;
+		for (vint i = 1; i <= n; i++)
+		{
+			sum = (sum + i) % 1000003;
+		}
+		return sum;
+	}
+
+	vint RefCollections(vint n)
+	{
+		vint c = 0;
+		for (vint i = 1; i <= n / 10; i++)
+		{
+			c = c + i + (i + 1) + (i + 2);
+			c = (c + (i + 1) + 2) % 1000003;
+			switch (i % 10)
+			{
+			case 1: case 3: case 5: case 7:
+				c = c + 1;
+			}
+		}
+		return c;
+	}
+
+	vint RefExceptions(vint n)
+	{
+		vint c = 0;
+		for (vint i = 1; i <= n / 10; i++)
+		{
+			c = c + (i % 2 == 0 ? 2 : 1);
+		}
+		return c;
+	}
+
+	vint RefStructs(vint n)
+	{
+		vint c = 0;
+		for (vint i = 1; i <= n; i++)
+		{
+			c = (c + i * 3) % 1000003;
+		}
+		return c;
+	}
+
+	vint RefObjects(vint n)
+	{
+		vint c = 0;
+		for (vint i = 1; i <= n; i++)
+		{
+			c = (c + 2 + i) % 1000003;
+		}
+		return c;
+	}
+
+	Ptr<WfRuntimeGlobalContext> CreateTestContext()
+	{
+		List<WString> codes;
+		codes.Add(TestWorkflowInterpreterCode);
+		List<Ptr<ParsingError>> errors;
+		auto assembly = Compile(WfLoadTable(), codes, errors);
+		FOREACH(Ptr<ParsingError>, error, errors)
+		{
+			unittest::UnitTest::PrintInfo(error->errorMessage);
+		}
+		TEST_ASSERT(errors.Count() == 0);
+		TEST_ASSERT(assembly);
+
+		auto globalContext = MakePtr<WfRuntimeGlobalContext>(assembly);
+		LoadFunction<void()>(globalContext, L"<initialize>")();
+		return globalContext;
+	}
+
+	// the only instruction in a function that accesses the member
+	vint FindInstruction(Ptr<WfAssembly> assembly, const WString& functionName, WfInsCode code, const WString& memberName)
+	{
+		auto function = assembly->functions[assembly->functionByName[functionName][0]];
+		vint found = -1;
+		for (vint i = function->firstInstruction; i <= function->lastInstruction; i++)
+		{
+			auto& ins = assembly->instructions[i];
+			if (ins.code != code) continue;
+			auto name = code == WfInsCode::InvokeMethod ? ins.methodParameter->GetName() : ins.propertyParameter->GetName();
+			if (name == memberName)
+			{
+				TEST_ASSERT(found == -1);
+				found = i;
+			}
+		}
+		TEST_ASSERT(found != -1);
+		return found;
+	}
+
+	// the compiler calls a getter directly, getter calls are replaced by GetProperty before the function is prepared
+	vint ReplaceGetterWithGetProperty(Ptr<WfAssembly> assembly, const WString& functionName, const WString& getterName, const WString& propertyName)
+	{
+		auto function = assembly->functions[assembly->functionByName[functionName][0]];
+		vint first = -1;
+		for (vint i = function->firstInstruction; i <= function->lastInstruction; i++)
+		{
+			auto& ins = assembly->instructions[i];
+			if (ins.code == WfInsCode::InvokeMethod && ins.methodParameter->GetName() == getterName)
+			{
+				auto propertyInfo = ins.methodParameter->GetOwnerTypeDescriptor()->GetPropertyByName(propertyName, true);
+				TEST_ASSERT(propertyInfo && propertyInfo->GetGetter() == ins.methodParameter);
+				ins = WfInstruction::GetProperty(propertyInfo);
+				if (first == -1) first = i;
+			}
+		}
+		TEST_ASSERT(first != -1);
+		return first;
+	}
+
+	template<typename T>
+	void Benchmark(Ptr<WfRuntimeGlobalContext> globalContext, const WString& name, vint n, T(*reference)(vint))
+	{
+		auto function = LoadFunction<T(vint)>(globalContext, name);
+		T expected = reference(n);
+
+		// the first call loads the function
+		TEST_ASSERT(function(n) == expected);
+
+		const vint repeat = 10;
+		auto start = DateTime::LocalTime();
+		for (vint i = 0; i < repeat; i++)
+		{
+			TEST_ASSERT(function(n) == expected);
+		}
+		auto stop = DateTime::LocalTime();
+		unittest::UnitTest::PrintInfo(L"    " + name + L": " + u64tow(stop.totalMilliseconds - start.totalMilliseconds) + L"ms");
+	}
+}
+
+TEST_CASE(TestWorkflowInterpreter_InstructionCoverage)
+{
+	const wchar_t* instructionNames[] =
+	{
+#define INSTRUCTION_NAME(NAME) L ## #NAME,
+		INSTRUCTION_CASES(
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME,
+			INSTRUCTION_NAME)
+#undef INSTRUCTION_NAME
+	};
+	const vint instructionCount = sizeof(instructionNames) / sizeof(*instructionNames);
+
+	// instructions and their type parameters emitted for the benchmarks
+	auto globalContext = CreateTestContext();
+	SortedList<vint> codes;
+	SortedList<WString> handlers;
+	FOREACH(WfInstruction, ins, globalContext->assembly->instructions)
+	{
+		vint code = (vint)ins.code;
+		TEST_ASSERT(0 <= code && code < instructionCount);
+		if (!codes.Contains(code))
+		{
+			codes.Add(code);
+		}
+
+		WString handler = instructionNames[code];
+		switch (ins.code)
+		{
+		case WfInsCode::CreateRange:
+		case WfInsCode::CompareLiteral:
+		case WfInsCode::OpNot:
+		case WfInsCode::OpPositive:
+		case WfInsCode::OpNegative:
+		case WfInsCode::OpExp:
+		case WfInsCode::OpAdd:
+		case WfInsCode::OpSub:
+		case WfInsCode::OpMul:
+		case WfInsCode::OpDiv:
+		case WfInsCode::OpMod:
+		case WfInsCode::OpShl:
+		case WfInsCode::OpShr:
+		case WfInsCode::OpXor:
+		case WfInsCode::OpAnd:
+		case WfInsCode::OpOr:
+			handler += L"<" + itow((vint)ins.typeParameter) + L">";
+			break;
+		default:;
+		}
+		if (!handlers.Contains(handler))
+		{
+			handlers.Add(handler);
+		}
+	}
+
+	WString missing;
+	for (vint i = 0; i < instructionCount; i++)
+	{
+		if (!codes.Contains(i))
+		{
+			missing += L" " + WString(instructionNames[i]);
+		}
+	}
+	unittest::UnitTest::PrintInfo(L"Instructions: " + itow(codes.Count()) + L"/" + itow(instructionCount) + L", handlers with type parameters: " + itow(handlers.Count()));
+	unittest::UnitTest::PrintInfo(L"Instructions not covered:" + missing);
+
+	// only instructions that are not generated by the compiler, or are for features not in the benchmarks, are allowed to be missing
+	TEST_ASSERT(codes.Count() * 4 >= instructionCount * 3);
+}
+
+TEST_CASE(TestWorkflowInterpreter_Benchmark)
+{
+	const vint n = 10000;
+	auto globalContext = CreateTestContext();
+	unittest::UnitTest::PrintInfo(L"Calling each benchmark 10 times with n = " + itow(n) + L":");
+	Benchmark(globalContext, L"Integers", n, &RefIntegers);
+	Benchmark(globalContext, L"UnsignedIntegers", n, &RefUnsignedIntegers);
+	Benchmark(globalContext, L"Doubles", n, &RefDoubles);
+	Benchmark(globalContext, L"Booleans", n, &RefBooleans);
+	Benchmark(globalContext, L"Strings", n, &RefStrings);
+	Benchmark(globalContext, L"Calls", n, &RefCalls);
+	Benchmark(globalContext, L"Closures", n, &RefClosures);
+	Benchmark(globalContext, L"Classes", n, &RefClasses);
+	Benchmark(globalContext, L"Interfaces", n, &RefSum);
+	Benchmark(globalContext, L"Collections", n, &RefCollections);
+	Benchmark(globalContext, L"Exceptions", n, &RefExceptions);
+	Benchmark(globalContext, L"Structs", n, &RefStructs);
+	Benchmark(globalContext, L"Globals", n, &RefSum);
+	Benchmark(globalContext, L"Objects", n, &RefObjects);
+}
+
+TEST_CASE(TestWorkflowInterpreter_InstructionCaches)
+{
+	auto globalContext = CreateTestContext();
+	auto assembly = globalContext->assembly;
+	vint addIndex = FindInstruction(assembly, L"NativeMembers", WfInsCode::InvokeMethod, L"Add");
+	vint countIndex = ReplaceGetterWithGetProperty(assembly, L"NativeMembers", L"GetCount", L"Count");
+	vint valueIndex = ReplaceGetterWithGetProperty(assembly, L"Classes", L"GetValue", L"Value");
+	auto nativeMembers = LoadFunction<vint(Ptr<IValueList>, vint)>(globalContext, L"NativeMembers");
+
+	// native methods and native getters remember the receiver type when they are called for the first time
+	auto list = IValueList::Create();
+	TEST_ASSERT(nativeMembers(list, 10) == 10);
+	auto listType = Value::From(list).GetTypeDescriptor();
+	auto& addCache = globalContext->instructionCaches[addIndex];
+	auto& countCache = globalContext->instructionCaches[countIndex];
+	TEST_ASSERT(addCache.kind == WfInstructionCacheKind::NativeMethod);
+	TEST_ASSERT(countCache.kind == WfInstructionCacheKind::NativeMethod);
+	TEST_ASSERT(addCache.receiverType == listType);
+	TEST_ASSERT(countCache.receiverType == listType);
+	TEST_ASSERT(nativeMembers(list, 5) == 15);
+
+	// another receiver type is checked for every call, the remembered type is not replaced
+	auto observableList = IValueObservableList::Create();
+	TEST_ASSERT(Value::From(observableList).GetTypeDescriptor() != listType);
+	TEST_ASSERT(nativeMembers(observableList, 3) == 3);
+	TEST_ASSERT(addCache.receiverType == listType);
+	TEST_ASSERT(countCache.receiverType == listType);
+
+	// a receiver of a wrong type falls back to the checked Invoke, which raises an error
+	{
+		auto arguments = IValueList::Create();
+		arguments->Add(Value::From(IValueDictionary::Create()));
+		arguments->Add(BoxValue<vint>(1));
+		bool raised = false;
+		try
+		{
+			LoadFunction(globalContext, L"NativeMembers")->Invoke(arguments);
+		}
+		catch (const TypeDescriptorException&)
+		{
+			raised = true;
+		}
+		TEST_ASSERT(raised);
+		TEST_ASSERT(addCache.receiverType == listType);
+	}
+
+	// a getter of a script class enters the getter function directly
+	TEST_ASSERT(LoadFunction<vint(vint)>(globalContext, L"Classes")(100) == RefClasses(100));
+	auto& valueCache = globalContext->instructionCaches[valueIndex];
+	TEST_ASSERT(valueCache.kind == WfInstructionCacheKind::ScriptMethod);
+	TEST_ASSERT(INVLOC.FindFirst(assembly->functions[valueCache.functionIndex]->name, L"GetValue", Locale::None).key != -1);
+}
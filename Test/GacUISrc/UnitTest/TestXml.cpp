@@ -0,0 +1,181 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::filesystem;
+using namespace vl::parsing;
+using namespace vl::parsing::xml;
+
+extern WString GetTestResourcePath();
+
+namespace
+{
+	void AssertRange(const ParsingTextRange& a, const ParsingTextRange& b)
+	{
+		TEST_ASSERT(a.start.index == b.start.index);
+		TEST_ASSERT(a.start.row == b.start.row);
+		TEST_ASSERT(a.start.column == b.start.column);
+		TEST_ASSERT(a.end.index == b.end.index);
+		TEST_ASSERT(a.end.row == b.end.row);
+		TEST_ASSERT(a.end.column == b.end.column);
+		TEST_ASSERT(a.codeIndex == b.codeIndex);
+	}
+
+	void AssertToken(const ParsingToken& a, const ParsingToken& b)
+	{
+		TEST_ASSERT(a.value == b.value);
+		TEST_ASSERT(a.tokenIndex == b.tokenIndex);
+		AssertRange(a.codeRange, b.codeRange);
+	}
+
+	void AssertNode(Ptr<XmlNode> a, Ptr<XmlNode> b);
+
+	template<typename T>
+	void AssertNodes(const List<Ptr<T>>& a, const List<Ptr<T>>& b)
+	{
+		TEST_ASSERT(a.Count() == b.Count());
+		for (vint i = 0; i < a.Count(); i++)
+		{
+			AssertNode(a[i], b[i]);
+		}
+	}
+
+	void AssertNode(Ptr<XmlNode> a, Ptr<XmlNode> b)
+	{
+		TEST_ASSERT(a && b);
+		AssertRange(a->codeRange, b->codeRange);
+		TEST_ASSERT(CompareEnumerable(a->creatorRules, b->creatorRules) == 0);
+
+		if (auto x = a.Cast<XmlText>())
+		{
+			auto y = b.Cast<XmlText>();
+			TEST_ASSERT(y);
+			AssertToken(x->content, y->content);
+		}
+		else if (auto x = a.Cast<XmlCData>())
+		{
+			auto y = b.Cast<XmlCData>();
+			TEST_ASSERT(y);
+			AssertToken(x->content, y->content);
+		}
+		else if (auto x = a.Cast<XmlComment>())
+		{
+			auto y = b.Cast<XmlComment>();
+			TEST_ASSERT(y);
+			AssertToken(x->content, y->content);
+		}
+		else if (auto x = a.Cast<XmlAttribute>())
+		{
+			auto y = b.Cast<XmlAttribute>();
+			TEST_ASSERT(y);
+			AssertToken(x->name, y->name);
+			AssertToken(x->value, y->value);
+		}
+		else if (auto x = a.Cast<XmlElement>())
+		{
+			auto y = b.Cast<XmlElement>();
+			TEST_ASSERT(y);
+			AssertToken(x->name, y->name);
+			AssertToken(x->closingName, y->closingName);
+			AssertNodes(x->attributes, y->attributes);
+			AssertNodes(x->subNodes, y->subNodes);
+		}
+		else if (auto x = a.Cast<XmlInstruction>())
+		{
+			auto y = b.Cast<XmlInstruction>();
+			TEST_ASSERT(y);
+			AssertToken(x->name, y->name);
+			AssertNodes(x->attributes, y->attributes);
+		}
+		else if (auto x = a.Cast<XmlDocument>())
+		{
+			auto y = b.Cast<XmlDocument>();
+			TEST_ASSERT(y);
+			AssertNodes(x->prologs, y->prologs);
+			AssertNode(x->rootElement, y->rootElement);
+		}
+		else
+		{
+			TEST_ASSERT(false);
+		}
+	}
+
+	void AssertSameAsTableParser(Ptr<tabling::ParsingTable> table, const WString& input)
+	{
+		List<Ptr<ParsingError>> expectedErrors, actualErrors;
+		auto expected = XmlParseDocument(input, table, expectedErrors, 0);
+
+		XmlPullParser parser(input, 0);
+		auto actual = XmlBuildDocument(parser, actualErrors);
+
+		if (expected)
+		{
+			TEST_ASSERT(actualErrors.Count() == 0);
+			AssertNode(expected, actual);
+			TEST_ASSERT(XmlToString(expected) == XmlToString(actual));
+		}
+		else
+		{
+			TEST_ASSERT(!actual);
+			TEST_ASSERT(actualErrors.Count() == 1);
+			TEST_ASSERT(expectedErrors[0]->errorMessage == actualErrors[0]->errorMessage);
+			AssertRange(expectedErrors[0]->codeRange, actualErrors[0]->codeRange);
+		}
+	}
+}
+
+TEST_CASE(TestXml_PullParser_Snippets)
+{
+	auto table = XmlLoadTable();
+	const wchar_t* inputs[] =
+	{
+		L"<a/>",
+		L"  <a  />  ",
+		L"<?xml version=\"1.0\" encoding=\"utf-8\"?>\r\n<!--comment-->\r\n<a x='1' y=\"&lt;&amp;&gt;\"/>",
+		L"<a>text</a>",
+		L"<a>\r\n  text with = and \"quotes\" and 'apostrophes' &lt;escaped&gt;\r\n</a>",
+		L"<a> x <b/> y <![CDATA[<c/>]]> z <!--<d/>--> </a>",
+		L"<a><![CDATA[]]]]]>]]></a>",
+		L"<a><!-- - -- --></a>",
+		L"<a>?/ / ? !</a>",
+		L"<a>x</b>",
+		L"<a></a><b/>",
+		L"",
+		L"<>",
+		L"<a",
+		L"<a x>",
+		L"<a x=>",
+		L"<a x=1/>",
+		L"<a>text",
+		L"<a><!-- --->-->",
+		L"<a><![CDATA[x]]]>",
+		L"<?xml ?><?xml x",
+		L"text<a/>",
+		L"<a>\"unclosed</a>",
+		L"<a>x</a>\r\n<!--after-->",
+	};
+	for (auto input : inputs)
+	{
+		AssertSameAsTableParser(table, input);
+	}
+}
+
+TEST_CASE(TestXml_PullParser_Resources)
+{
+	auto table = XmlLoadTable();
+	List<File> files;
+	TEST_ASSERT(Folder(GetTestResourcePath()).GetFiles(files));
+	for (vint i = 0; i < files.Count(); i++)
+	{
+		auto path = files[i].GetFilePath();
+		if (INVLOC.EndsWith(path.GetFullPath(), L".xml", Locale::Normalization::IgnoreCase))
+		{
+			auto input = files[i].ReadAllTextByBom();
+			AssertSameAsTableParser(table, input);
+			for (vint j = 0; j < input.Length(); j += 7)
+			{
+				AssertSameAsTableParser(table, input.Left(j));
+			}
+		}
+	}
+}
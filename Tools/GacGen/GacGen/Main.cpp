@@ -131,26 +131,44 @@ void GuiMain()
 	Console::SetTitle(L"Vczh GacUI Resource Code Generator for C++");
 
 	bool partialMode = false;
+	vint workerCount = 1;
 	FilePath inputPath;
-	switch(arguments->Count())
 	{
-	case 1:
-		inputPath = arguments->Get(0);
-		break;
-	case 2:
-		if (arguments->Get(0) == L"/P")
+		bool succeeded = arguments->Count() > 0;
+		vint index = 0;
+		while (succeeded && index < arguments->Count() - 1)
 		{
-			partialMode = true;
-			inputPath = arguments->Get(1);
-			break;
+			if (arguments->Get(index) == L"/P")
+			{
+				partialMode = true;
+				index++;
+			}
+			else if (arguments->Get(index) == L"/J" && index + 1 < arguments->Count() - 1)
+			{
+				workerCount = wtoi_test(arguments->Get(index + 1), succeeded);
+				if (succeeded && workerCount == 0)
+				{
+					workerCount = Thread::GetCPUCount();
+				}
+				succeeded = succeeded && workerCount > 0;
+				index += 2;
+			}
+			else
+			{
+				succeeded = false;
+			}
 		}
-	default:
-		PrintErrorMessage(L"Usage: GacGen32.exe [/P] <input-resource-xml-file>");
-		PrintErrorMessage(L"Usage: GacGen64.exe [/P] <input-resource-xml-file>");
-		return;
+
+		if (!succeeded)
+		{
+			PrintErrorMessage(L"Usage: GacGen32.exe [/P] [/J <thread-count>] <input-resource-xml-file>");
+			PrintErrorMessage(L"Usage: GacGen64.exe [/P] [/J <thread-count>] <input-resource-xml-file>");
+			PrintErrorMessage(L"    /J 0 uses all logical processors.");
+			return;
+		}
+		inputPath = arguments->Get(arguments->Count() - 1);
 	}
 
-	PrintSuccessMessage(L"gacgen> Clearning logs ... : " + inputPath.GetFullPath());
 	FilePath logFolderPath = inputPath.GetFullPath() + L".log";
 	if (partialMode)
 	{
@@ -163,7 +181,16 @@ void GuiMain()
 	}
 	FilePath scriptFilePath = logFolderPath / L"Workflow.txt";
 	FilePath errorFilePath = logFolderPath / L"Errors.txt";
+	FilePath manifestFilePath = logFolderPath / L"BuildManifest.txt";
 	FilePath workingDir = inputPath.GetFolder();
+	WString buildConfiguration = L"GacGen " + atow(__DATE__) + L" " + atow(__TIME__) + (partialMode ? L" /P" : L"");
+	if (IsResourceBuildUpToDate(manifestFilePath, buildConfiguration))
+	{
+		PrintSuccessMessage(L"gacgen> Skipped, no input or output file is changed since the last build : " + inputPath.GetFullPath());
+		return;
+	}
+
+	PrintSuccessMessage(L"gacgen> Clearning logs ... : " + inputPath.GetFullPath());
 	{
 		Folder logFolder(logFolderPath);
 		if (logFolder.Exists())
@@ -210,12 +237,13 @@ void GuiMain()
 	PrintSuccessMessage(L"gacgen> Compiling...");
 	List<GuiResourceError> errors;
 	Callback callback;
-	if (auto precompiledFolder = PrecompileAndWriteErrors(resource, &callback, errors, errorFilePath))
+	if (auto precompiledFolder = PrecompileAndWriteErrors(resource, &callback, errors, errorFilePath, workerCount))
 	{
 		if (errors.Count() == 0)
 		{
 			if (auto compiled = WriteWorkflowScript(precompiledFolder, scriptFilePath))
 			{
+				List<FilePath> outputPaths;
 				if (config->cppOutput)
 				{
 					PrintSuccessMessage(L"gacgen> Generating C++ source code ...");
@@ -241,24 +269,32 @@ void GuiMain()
 					}
 
 					auto output = WriteCppCodesToFile(compiled, input, cppFolder);
+					FOREACH(WString, fileName, output->cppFiles.Keys())
+					{
+						outputPaths.Add(cppFolder / fileName);
+					}
 					if (config->cppOutput->cppResource != L"")
 					{
 						WriteEmbeddedResource(resource, input, output, false, cppFolder / config->cppOutput->cppResource);
+						outputPaths.Add(cppFolder / config->cppOutput->cppResource);
 					}
 					if (config->cppOutput->cppCompressed != L"")
 					{
 						WriteEmbeddedResource(resource, input, output, true, cppFolder / config->cppOutput->cppCompressed);
+						outputPaths.Add(cppFolder / config->cppOutput->cppCompressed);
 					}
 
 					if (config->cppOutput->resource != L"")
 					{
 						PrintSuccessMessage(L"Generating binary resource file (no script): " + config->cppOutput->resource);
-						WriteBinaryResource(resource, false, false, (partialMode ? logFolderPath / L"Resource.bin" : workingDir / config->cppOutput->resource));
+						outputPaths.Add(partialMode ? logFolderPath / L"Resource.bin" : workingDir / config->cppOutput->resource);
+						WriteBinaryResource(resource, false, false, outputPaths[outputPaths.Count() - 1]);
 					}
 					if (config->cppOutput->compressed != L"")
 					{
 						PrintSuccessMessage(L"Generating compressed resource file (no script): " + config->cppOutput->compressed);
-						WriteBinaryResource(resource, true, false, (partialMode ? logFolderPath / L"Compressed.bin" : workingDir / config->cppOutput->compressed));
+						outputPaths.Add(partialMode ? logFolderPath / L"Compressed.bin" : workingDir / config->cppOutput->compressed);
+						WriteBinaryResource(resource, true, false, outputPaths[outputPaths.Count() - 1]);
 					}
 				}
 
@@ -267,12 +303,14 @@ void GuiMain()
 					if (config->resOutput->resource != L"")
 					{
 						PrintSuccessMessage(L"Generating binary resource files : " + config->resOutput->resource);
-						WriteBinaryResource(resource, false, true, (partialMode ? logFolderPath / L"ScriptedResource.bin" : workingDir / config->resOutput->resource));
+						outputPaths.Add(partialMode ? logFolderPath / L"ScriptedResource.bin" : workingDir / config->resOutput->resource);
+						WriteBinaryResource(resource, false, true, outputPaths[outputPaths.Count() - 1]);
 					}
 					if (config->resOutput->compressed != L"")
 					{
 						PrintSuccessMessage(L"Generating compressed resource files : " + config->resOutput->compressed);
-						WriteBinaryResource(resource, true, true, (partialMode ? logFolderPath / L"ScriptedCompressed.bin" : workingDir / config->resOutput->compressed));
+						outputPaths.Add(partialMode ? logFolderPath / L"ScriptedCompressed.bin" : workingDir / config->resOutput->compressed);
+						WriteBinaryResource(resource, true, true, outputPaths[outputPaths.Count() - 1]);
 					}
 				}
 
@@ -309,6 +347,11 @@ void GuiMain()
 						File(logFolderPath / L"Deploy.bat").WriteAllLines(lines, false, BomEncoder::Mbcs);
 					}
 				}
+
+				if (!WriteResourceBuildManifest(resource, outputPaths, manifestFilePath, buildConfiguration))
+				{
+					PrintErrorMessage(L"gacgen> Unable to write : " + manifestFilePath.GetFullPath());
+				}
 			}
 		}
 	}